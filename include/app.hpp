@@ -0,0 +1,352 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "attitude.hpp"
+#include "encoder.hpp"
+#include "hal.hpp"
+#include "imu_filter.hpp"
+#include "led_assets.hpp"
+#include "led_matrix.hpp"
+#include "logger.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
+
+namespace app {
+
+enum class WorkState {
+    IDLE,
+    PIXEL_TEST,
+    SHOW_IMU,
+    SHOW_KNOB,
+};
+
+// 任务周期 (us)，按周期从短到长分配优先级
+// imu 任务只是取走传感器 FIFO 中的新样本，采样率见 imu_rate
+constexpr uint32_t imu_period_us       = 5000;
+constexpr uint32_t wheel_period_us     = 5000;
+constexpr uint32_t anim_period_us      = 10000;
+constexpr uint32_t input_period_us     = 20000;
+constexpr uint32_t display_period_us   = 100000;
+constexpr uint32_t pixel_period_us     = 200000;
+constexpr uint32_t telemetry_period_us = 200000;
+constexpr uint32_t console_period_us   = 100000;
+
+// 缩放因子（根据LED矩阵大小调整）
+constexpr float position_scale = 5.0f; // 增加灵敏度
+
+// JGA25-370：电机每转 11 个脉冲，减速比 1:34，车轮直径 65 mm
+// 每次更新至少 4 个计数时改用 M 法，200 ms 没有脉冲视为静止
+inline constexpr enc::config wheel_config{ enc::travel_per_count(11 * 34, literals::leng_t(0.065)), 4, 200000 };
+
+// 俯仰角互补滤波的时间常数 (s)
+constexpr float tilt_tau = 0.5f;
+
+// 切换模式时闪烁对应按键的字母两次，优先级高于普通动画
+inline constexpr uint8_t mode_glyphs[] = { 10, 11, 12 }; // A B C
+inline constexpr led::sequence mode_blink[] = {
+    { nullptr, 4, 150, led::render_blink, &mode_glyphs[0] },
+    { nullptr, 4, 150, led::render_blink, &mode_glyphs[1] },
+    { nullptr, 4, 150, led::render_blink, &mode_glyphs[2] },
+};
+constexpr uint8_t mode_blink_priority = 10;
+
+/*
+ * mode switching and display logic over a hal platform, see hal.hpp
+ * every *_task is run by the scheduler at the matching *_period_us
+ * while a trace is recording, the raw inputs the tasks read are streamed to
+ * Hal::serial, see trace.hpp
+ */
+template <typename Hal>
+class application {
+    public:
+    using matrix_type = basic_led_matrix<typename Hal::matrix>;
+    using clock       = typename Hal::clock;
+
+    private:
+    matrix_type m_matrix;
+    typename Hal::knob m_knob;
+    typename Hal::buttons m_buttons;
+    typename Hal::imu m_imu;
+    typename Hal::pixels m_pixels;
+    typename Hal::encoders m_wheels;
+
+    WorkState m_state;
+    imu_params m_params;
+    motion m_motion;
+    att::complementary m_tilt;
+    enc::speed m_speed[enc::wheels];
+    uint8_t m_pixel_step;
+    bool m_imu_reset; // 进入 SHOW_IMU 后用第一个新样本重置滤波器
+    trace::writer<typename Hal::serial> m_trace;
+
+    // 开机动画直接从 flash 中的压缩数据解码
+    led::packed_anim m_boot_anim;
+    led::sequence m_boot_seq;
+
+    // 只有 SHOW_IMU 读取 IMU，其它模式下传感器 FIFO 不累积数据
+    auto set_state(WorkState s) -> void {
+        if (s == WorkState::SHOW_IMU && m_state != WorkState::SHOW_IMU) {
+            m_imu.stream(true);
+            m_imu_reset = true;
+        } else if (s != WorkState::SHOW_IMU && m_state == WorkState::SHOW_IMU) {
+            m_imu.stream(false);
+        }
+        m_state = s;
+    }
+
+    // 模式切换：清屏并闪烁对应字母
+    auto enter(WorkState s, uint8_t blink) -> void {
+        m_matrix.clear();
+        m_matrix.play(mode_blink[blink], led::play_mode::once, mode_blink_priority);
+        set_state(s);
+    }
+
+    public:
+    application() noexcept
+    : m_state(WorkState::IDLE), m_params(default_imu_params), m_motion{},
+      m_tilt(static_cast<float>(imu_rate.v), tilt_tau), m_speed{ enc::speed(wheel_config), enc::speed(wheel_config) },
+      m_pixel_step(0), m_imu_reset(false), m_boot_anim(led::assets::boot), m_boot_seq(m_boot_anim.seq()) {}
+
+    application(const application&)            = delete;
+    application& operator=(const application&) = delete;
+
+    auto begin() -> void {
+        LOG_INFO("Knob begin");
+        m_knob.begin();
+        m_knob.set(0);
+
+        LOG_INFO("Pixels begin");
+        m_pixels.begin();
+        m_pixels.clear();
+        m_pixels.show();
+
+        LOG_INFO("Button begin");
+        m_buttons.begin();
+
+        LOG_INFO("IMU begin");
+        m_imu.begin();
+        m_imu.stream(false);
+
+        LOG_INFO("Encoders begin");
+        m_wheels.begin();
+
+        LOG_INFO("LED Matrix begin");
+        m_matrix.begin();
+        m_matrix.play(m_boot_seq, led::play_mode::once, UINT8_MAX); // 非阻塞，由 anim 任务播放
+    }
+
+    /// ===================== INPUT ====================
+    auto input_task() -> void {
+        {
+            PROF_SCOPE(prof::button_update);
+            m_buttons.update();
+        }
+
+        if (m_trace.active()) {
+            uint32_t now = clock::micros();
+            m_trace.sample_buttons(now, m_buttons.pressed('A') | m_buttons.pressed('B') << 1 | m_buttons.pressed('C') << 2);
+            m_trace.sample_knob(now, m_knob.get(), m_knob.pressed());
+        }
+
+        if (m_buttons.pressed('A') && m_buttons.pressed('B') && m_buttons.pressed('C')) {
+            set_state(WorkState::IDLE);
+        }
+
+        if (m_buttons.pressed('A') && m_state != WorkState::SHOW_KNOB) {
+            LOGM_INFO(input, "Press A");
+            enter(WorkState::SHOW_KNOB, 0);
+        } else if (m_buttons.pressed('B') && m_state != WorkState::SHOW_IMU) {
+            LOGM_INFO(input, "Press B");
+            enter(WorkState::SHOW_IMU, 1);
+        } else if (m_buttons.pressed('C') && m_state != WorkState::PIXEL_TEST) {
+            LOGM_INFO(input, "Press C");
+            enter(WorkState::PIXEL_TEST, 2);
+        }
+    }
+
+    /// ===================== SHOW_IMU ====================
+    auto imu_task() -> void {
+        if (m_state != WorkState::SHOW_IMU) return;
+
+        // 依次处理上次以来的每个新样本，没有新样本时不会重复处理旧数据
+        for (;;) {
+            bool fresh;
+            {
+                PROF_SCOPE(prof::imu_update);
+                fresh = m_imu.update();
+            }
+            if (!fresh) break;
+
+            // 获取原始加速度，按录制的精度 (1/8192 g) 取整，回放时滤波的输入完全相同
+            float acc_x_raw = trace::to_g(trace::to_raw(m_imu.x()));
+            float acc_y_raw = trace::to_g(trace::to_raw(m_imu.y()));
+
+            // 以进入模式后的第一个样本作为偏移初值，FIFO 已在进入时清空
+            if (m_imu_reset) {
+                m_imu_reset = false;
+                m_motion.reset(acc_x_raw, acc_y_raw);
+                m_tilt.reset();
+                if (m_trace.active()) m_trace.sample_reset(m_imu.t_us(), acc_x_raw, acc_y_raw, m_imu.z());
+                continue;
+            }
+            if (m_trace.active()) m_trace.sample_imu(m_imu.t_us(), acc_x_raw, acc_y_raw, m_imu.z());
+
+            // 传感器按固定频率采样，dt 即采样周期
+            m_motion.step(m_params, acc_x_raw, acc_y_raw, imu_dt);
+
+            {
+                PROF_SCOPE(prof::attitude);
+                m_tilt.update(att::sample{ acc_x_raw, acc_y_raw, m_imu.z(), m_imu.gx(), m_imu.gy(), m_imu.gz() });
+            }
+
+            // 原始数据，默认被运行时级别过滤，每 40 个样本（约 200 ms）最多一条
+            LOG_EVERY_N(40, LOGM_TRACE(imu, "raw: {}, {}", acc_x_raw, acc_y_raw));
+        }
+    }
+
+    /// ===================== WHEELS ====================
+    auto wheel_task() -> void {
+        for (uint8_t w = 0; w < enc::wheels; w++) {
+            enc::snapshot s = m_wheels.read(static_cast<enc::wheel>(w));
+            m_speed[w].update(s, clock::micros());
+        }
+    }
+
+    /// ===================== ANIMATION ====================
+    auto anim_task() -> void {
+        m_matrix.tick(clock::millis());
+    }
+
+    /// ===================== DISPLAY ====================
+    auto display_task() -> void {
+        switch (m_state) {
+        case WorkState::SHOW_IMU: {
+            // 缩放到LED矩阵坐标，限制显示范围
+            float display_y = std::clamp(m_motion.pos_y * position_scale, -50.0f, 50.0f);
+
+            m_matrix.clean();
+            // 向下取整，(-1, 0) 在第 0 行之外
+            m_matrix.draw_hline(0, led::width - 1, static_cast<int>(floorf(display_y)));
+            m_matrix.show();
+            break;
+        }
+        case WorkState::SHOW_KNOB: {
+            if (m_knob.pressed()) {
+                if (m_knob.get() != 0) {
+                    LOGM_INFO(input, "Knob at pos:{} fine", m_knob.get());
+                }
+                m_knob.set(0);
+            } else {
+                auto val = std::clamp<int16_t>(m_knob.get(), -999, 9999);
+                m_knob.set(val);
+
+                // 只有数值变化时才会刷新硬件
+                m_matrix.print(val);
+            }
+            break;
+        }
+        default: break;
+        }
+    }
+
+    /// ===================== PIXEL_TEST ====================
+    auto pixel_task() -> void {
+        if (m_state != WorkState::PIXEL_TEST) return;
+
+        enum : uint8_t {
+            S1,
+            S2,
+            S3,
+            S4,
+            S_CLEAN,
+        };
+
+        uint8_t brightness = static_cast<uint8_t>(std::clamp<int16_t>(m_knob.get(), 0, 100));
+        m_knob.set(brightness);
+
+        auto wave = [](unsigned long time) -> hal::color {
+            return hal::color{
+                static_cast<uint8_t>(((sin(time + 5) + 1.) / 2) * 255),
+                static_cast<uint8_t>(((sin(time - 3) + 1.) / 2) * 255),
+                static_cast<uint8_t>(((sin(time + 2) + 1.) / 2) * 255)
+            };
+        };
+
+        auto t = clock::millis();
+        switch (m_pixel_step) {
+        case S1:
+            m_pixels.set(0, wave(t), brightness);
+            m_pixels.set(1, wave(t), brightness);
+            LOGM_DEBUG(pixel, "S1");
+            m_pixel_step = S2;
+            break;
+        case S2:
+            m_pixels.set(2, wave(t), brightness);
+            m_pixels.set(3, wave(t), brightness);
+            LOGM_DEBUG(pixel, "S2");
+            m_pixel_step = S3;
+            break;
+        case S3:
+            m_pixels.set(4, wave(t), brightness);
+            m_pixels.set(5, wave(t), brightness);
+            LOGM_DEBUG(pixel, "S3");
+            m_pixel_step = S4;
+            break;
+        case S4:
+            m_pixels.set(6, wave(t), brightness);
+            m_pixels.set(7, wave(t), brightness);
+            LOGM_DEBUG(pixel, "S4");
+            m_pixel_step = S_CLEAN;
+            break;
+        default:
+            m_pixels.clear();
+            LOGM_DEBUG(pixel, "S_CLEAN");
+            m_pixel_step = S1;
+            break;
+        }
+        m_pixels.show();
+    }
+
+    /// ===================== TELEMETRY ====================
+    auto telemetry_task() -> void {
+        if (m_state != WorkState::SHOW_IMU) return;
+
+        // 两条记录，延迟日志每条最多 logging::record::max_args 个参数
+        LOGM_INFO(imu, "Pos: {}, {}; Vel: {}, {}", m_motion.pos_x, m_motion.pos_y, m_motion.vel_x, m_motion.vel_y);
+        LOGM_INFO(imu, "Acc: {}, {}; Pitch: {}", m_motion.acc_x, m_motion.acc_y, m_tilt.pitch());
+    }
+
+    // 开始或停止录制传感器数据
+    // SHOW_IMU 中途开始录制时先写入滤波器当前的状态，回放从这里继续
+    auto trace_begin() -> void {
+        uint32_t now = clock::micros();
+        m_trace.begin(now);
+        if (m_state == WorkState::SHOW_IMU && !m_imu_reset) {
+            float v[motion::state_size];
+            m_motion.save(v);
+            m_trace.sample_state(now, v);
+        }
+    }
+    auto trace_end() -> void { m_trace.end(); }
+    auto tracing() const -> bool { return m_trace.active(); }
+
+    auto state() const -> WorkState { return m_state; }
+    auto kinematics() const -> const motion& { return m_motion; }
+    auto tilt() const -> const att::complementary& { return m_tilt; }
+    auto wheel_speed(enc::wheel w) const -> literals::val_t { return m_speed[w].value(); }
+    auto params() -> imu_params& { return m_params; }
+    auto recorder() -> trace::writer<typename Hal::serial>& { return m_trace; }
+
+    auto matrix() -> matrix_type& { return m_matrix; }
+    auto knob() -> typename Hal::knob& { return m_knob; }
+    auto buttons() -> typename Hal::buttons& { return m_buttons; }
+    auto imu() -> typename Hal::imu& { return m_imu; }
+    auto pixels() -> typename Hal::pixels& { return m_pixels; }
+    auto encoders() -> typename Hal::encoders& { return m_wheels; }
+};
+
+} // namespace app
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+namespace att {
+
+/*
+ * tilt estimators fusing gyro and accelerometer at a fixed sample rate
+ * float only, no heap, every update is a fixed number of operations
+ *
+ * body axes: x forward, y left, z up, a level board at rest reads a = (0, 0, 1) g
+ * pitch      := rotation about y, positive nose down (a.x = -sin(pitch) at rest)
+ * roll       := rotation about x
+ *
+ * budget_cycles is the per-update ceiling on the Cortex-M4F at 48 MHz with
+ * the FPU, check it with the prof::attitude probe, the host benchmark only
+ * guards against accidental blowups such as double precision libm calls
+ */
+struct sample {
+    float ax, ay, az; // g, only the direction is used
+    float gx, gy, gz; // rad/s
+};
+
+constexpr float deg_to_rad = 0.017453292f;
+
+// pitch seen by the accelerometer alone, valid while the board is not accelerating
+inline auto accel_pitch(const sample& s) -> float {
+    return atan2f(-s.ax, sqrtf(s.ay * s.ay + s.az * s.az));
+}
+
+inline auto accel_roll(const sample& s) -> float {
+    return atan2f(s.ay, s.az);
+}
+
+/*
+ * complementary filter on pitch
+ * angle := alpha * (angle + gy * dt) + (1 - alpha) * accel_pitch
+ * tau is the crossover time constant in seconds, alpha = tau / (tau + dt)
+ */
+class complementary {
+    public:
+    static constexpr uint32_t budget_cycles = 400;
+
+    private:
+    float m_dt;
+    float m_alpha;
+    float m_angle;
+    float m_rate;
+    bool m_first;
+
+    public:
+    constexpr complementary(float rate_hz, float tau) noexcept
+    : m_dt(1.0f / rate_hz), m_alpha(tau / (tau + 1.0f / rate_hz)), m_angle(0), m_rate(0), m_first(true) {}
+
+    auto update(const sample& s) -> void {
+        float acc = accel_pitch(s);
+        m_rate    = s.gy;
+
+        // 第一个样本直接采用加速度计角度，避免从 0 慢慢收敛
+        m_angle = m_first ? acc : m_alpha * (m_angle + m_rate * m_dt) + (1 - m_alpha) * acc;
+        m_first = false;
+    }
+
+    auto reset() -> void {
+        m_angle = 0;
+        m_rate  = 0;
+        m_first = true;
+    }
+
+    auto pitch() const -> float { return m_angle; }
+    auto pitch_rate() const -> float { return m_rate; }
+};
+
+/*
+ * Mahony nonlinear complementary filter, 6 axis, quaternion state
+ * kp pulls the estimate towards the measured gravity, ki integrates the
+ * remaining error into a gyro bias estimate
+ * yaw is kept but drifts without a magnetometer
+ */
+class mahony {
+    public:
+    static constexpr uint32_t budget_cycles = 900;
+
+    private:
+    float m_dt;
+    float m_kp;
+    float m_ki;
+    float m_q0, m_q1, m_q2, m_q3;
+    float m_bx, m_by, m_bz; // integral feedback, the negated gyro bias
+    float m_rate_x, m_rate_y;
+    bool m_first;
+
+    // 用加速度计的 roll / pitch 初始化四元数
+    auto align(const sample& s) -> void {
+        float hr = accel_roll(s) * 0.5f;
+        float hp = accel_pitch(s) * 0.5f;
+        float cr = cosf(hr), sr = sinf(hr);
+        float cp = cosf(hp), sp = sinf(hp);
+        m_q0     = cr * cp;
+        m_q1     = sr * cp;
+        m_q2     = cr * sp;
+        m_q3     = -sr * sp;
+    }
+
+    public:
+    constexpr mahony(float rate_hz, float kp, float ki) noexcept
+    : m_dt(1.0f / rate_hz), m_kp(kp), m_ki(ki),
+      m_q0(1), m_q1(0), m_q2(0), m_q3(0),
+      m_bx(0), m_by(0), m_bz(0),
+      m_rate_x(0), m_rate_y(0),
+      m_first(true) {}
+
+    auto update(const sample& s) -> void {
+        if (m_first) {
+            align(s);
+            m_first = false;
+        }
+
+        float gx = s.gx, gy = s.gy, gz = s.gz;
+
+        float norm = s.ax * s.ax + s.ay * s.ay + s.az * s.az;
+        if (norm > 0.0f) {
+            float inv = 1.0f / sqrtf(norm);
+            float ax = s.ax * inv, ay = s.ay * inv, az = s.az * inv;
+
+            // 由姿态估计的重力方向
+            float vx = 2.0f * (m_q1 * m_q3 - m_q0 * m_q2);
+            float vy = 2.0f * (m_q0 * m_q1 + m_q2 * m_q3);
+            float vz = m_q0 * m_q0 - m_q1 * m_q1 - m_q2 * m_q2 + m_q3 * m_q3;
+
+            // 测量与估计方向的叉积即为误差
+            float ex = ay * vz - az * vy;
+            float ey = az * vx - ax * vz;
+            float ez = ax * vy - ay * vx;
+
+            if (m_ki > 0.0f) {
+                m_bx += m_ki * ex * m_dt;
+                m_by += m_ki * ey * m_dt;
+                m_bz += m_ki * ez * m_dt;
+            }
+
+            gx += m_kp * ex + m_bx;
+            gy += m_kp * ey + m_by;
+            gz += m_kp * ez + m_bz;
+        }
+
+        m_rate_x = s.gx + m_bx;
+        m_rate_y = s.gy + m_by;
+
+        // q += 0.5 * q ⊗ (0, g) * dt
+        gx *= 0.5f * m_dt;
+        gy *= 0.5f * m_dt;
+        gz *= 0.5f * m_dt;
+        float q0 = m_q0, q1 = m_q1, q2 = m_q2, q3 = m_q3;
+        m_q0 += -q1 * gx - q2 * gy - q3 * gz;
+        m_q1 += q0 * gx + q2 * gz - q3 * gy;
+        m_q2 += q0 * gy - q1 * gz + q3 * gx;
+        m_q3 += q0 * gz + q1 * gy - q2 * gx;
+
+        float inv = 1.0f / sqrtf(m_q0 * m_q0 + m_q1 * m_q1 + m_q2 * m_q2 + m_q3 * m_q3);
+        m_q0 *= inv;
+        m_q1 *= inv;
+        m_q2 *= inv;
+        m_q3 *= inv;
+    }
+
+    auto reset() -> void {
+        m_q0 = 1;
+        m_q1 = m_q2 = m_q3 = 0;
+        m_bx = m_by = m_bz = 0;
+        m_rate_x = m_rate_y = 0;
+        m_first  = true;
+    }
+
+    auto pitch() const -> float {
+        float v = 2.0f * (m_q0 * m_q2 - m_q1 * m_q3);
+        return asinf(v > 1.0f ? 1.0f : v < -1.0f ? -1.0f : v);
+    }
+    auto roll() const -> float { return atan2f(m_q0 * m_q1 + m_q2 * m_q3, 0.5f - m_q1 * m_q1 - m_q2 * m_q2); }
+    auto yaw() const -> float { return atan2f(m_q1 * m_q2 + m_q0 * m_q3, 0.5f - m_q2 * m_q2 - m_q3 * m_q3); }
+
+    // bias corrected body rates
+    auto pitch_rate() const -> float { return m_rate_y; }
+    auto roll_rate() const -> float { return m_rate_x; }
+    auto gyro_bias_y() const -> float { return -m_by; }
+};
+
+/*
+ * two state Kalman filter on pitch, state := (angle, gyro bias)
+ * q_angle and q_bias are the process noise densities, r the variance of the
+ * accelerometer angle in rad^2
+ */
+class kalman {
+    public:
+    static constexpr uint32_t budget_cycles = 600;
+
+    private:
+    float m_dt;
+    float m_q_angle;
+    float m_q_bias;
+    float m_r;
+    float m_angle;
+    float m_bias;
+    float m_rate;
+    float m_p00, m_p01, m_p10, m_p11;
+    bool m_first;
+
+    public:
+    constexpr kalman(float rate_hz, float q_angle, float q_bias, float r) noexcept
+    : m_dt(1.0f / rate_hz), m_q_angle(q_angle), m_q_bias(q_bias), m_r(r),
+      m_angle(0), m_bias(0), m_rate(0),
+      m_p00(0), m_p01(0), m_p10(0), m_p11(0),
+      m_first(true) {}
+
+    auto update(const sample& s) -> void {
+        float acc = accel_pitch(s);
+        if (m_first) {
+            m_angle = acc;
+            m_first = false;
+        }
+
+        // 预测
+        m_rate = s.gy - m_bias;
+        m_angle += m_dt * m_rate;
+
+        m_p00 += m_dt * (m_dt * m_p11 - m_p01 - m_p10 + m_q_angle);
+        m_p01 -= m_dt * m_p11;
+        m_p10 -= m_dt * m_p11;
+        m_p11 += m_q_bias * m_dt;
+
+        // 用加速度计角度修正
+        float sv = m_p00 + m_r;
+        float k0 = m_p00 / sv;
+        float k1 = m_p10 / sv;
+        float y  = acc - m_angle;
+
+        m_angle += k0 * y;
+        m_bias += k1 * y;
+
+        float p00 = m_p00, p01 = m_p01;
+        m_p00 -= k0 * p00;
+        m_p01 -= k0 * p01;
+        m_p10 -= k1 * p00;
+        m_p11 -= k1 * p01;
+    }
+
+    auto reset() -> void {
+        m_angle = m_bias = m_rate = 0;
+        m_p00 = m_p01 = m_p10 = m_p11 = 0;
+        m_first = true;
+    }
+
+    auto pitch() const -> float { return m_angle; }
+    auto pitch_rate() const -> float { return m_rate; }
+    auto gyro_bias_y() const -> float { return m_bias; }
+};
+
+} // namespace att
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <tuple>
+#include <utility>
+
+namespace ctrl {
+
+/*
+ * one loop of a cascade
+ * Controller := fixed-rate controller with set_target(v) and update(meas) -> v,
+ *               e.g. basic_discrete_pid built with period = base period * Divider
+ * Divider    := the stage runs once every Divider base ticks
+ */
+template <typename Controller, uint32_t Divider>
+struct stage {
+    static_assert(Divider > 0, "stage divider must be positive");
+
+    using controller_type = Controller;
+    using value_type      = typename Controller::value_type;
+
+    static constexpr uint32_t divider = Divider;
+};
+
+/*
+ * cascade<stage<outer, 4>, stage<inner, 1>>
+ * stages are listed from the outermost to the innermost loop, the output of a
+ * stage becomes the target of the next one, update() is called at the base rate
+ * and returns the output of the innermost stage
+ * all chaining is resolved at compile time, there is no virtual dispatch
+ */
+template <typename... Stages>
+class cascade {
+    static_assert(sizeof...(Stages) >= 2, "cascade needs at least two stages");
+
+    public:
+    static constexpr size_t depth = sizeof...(Stages);
+
+    private:
+    static constexpr uint32_t m_dividers[depth] = { Stages::divider... };
+
+    static constexpr auto dividers_nested() -> bool {
+        for (size_t i = 1; i < depth; i++)
+            if (m_dividers[i - 1] % m_dividers[i] != 0) return false;
+        return true;
+    }
+    static_assert(dividers_nested(), "each stage must run at an integer fraction of the next inner stage rate");
+
+    template <size_t I>
+    using stage_t = std::tuple_element_t<I, std::tuple<Stages...>>;
+
+    std::tuple<typename Stages::controller_type...> m_ctrl;
+    std::tuple<typename Stages::value_type...> m_out;
+    uint32_t m_tick;
+
+    template <size_t I, typename M>
+    auto step(M meas) -> void {
+        constexpr uint32_t div = stage_t<I>::divider;
+        if constexpr (div > 1) {
+            if (m_tick % div != 0) return;
+        }
+
+        auto& ctrl = std::get<I>(m_ctrl);
+        if constexpr (I > 0) {
+            ctrl.set_target(static_cast<typename stage_t<I>::value_type>(std::get<I - 1>(m_out)));
+        }
+        std::get<I>(m_out) = ctrl.update(meas);
+    }
+
+    template <size_t... I, typename... M>
+    auto step_all(std::index_sequence<I...>, M... meas) -> void {
+        (step<I>(meas), ...);
+    }
+
+    public:
+    using value_type = typename stage_t<depth - 1>::value_type;
+
+    explicit cascade(typename Stages::controller_type... ctrls) noexcept
+    : m_ctrl(ctrls...),
+      m_out(typename Stages::value_type(0)...),
+      m_tick(0) {
+    }
+
+    ~cascade() noexcept = default;
+
+    // one measurement per stage, outermost first
+    template <typename... M>
+    auto update(M... meas) -> value_type {
+        static_assert(sizeof...(M) == depth, "one measurement per stage is required");
+
+        step_all(std::index_sequence_for<Stages...>{}, meas...);
+
+        if (++m_tick == m_dividers[0]) m_tick = 0;
+        return std::get<depth - 1>(m_out);
+    }
+
+    auto reset() -> void {
+        std::apply([](auto&... c) { (c.reset(), ...); }, m_ctrl);
+        m_out  = std::make_tuple(typename Stages::value_type(0)...);
+        m_tick = 0;
+    }
+
+    template <size_t I>
+    auto get() noexcept -> typename stage_t<I>::controller_type& { return std::get<I>(m_ctrl); }
+
+    template <size_t I>
+    auto get_output() const noexcept -> typename stage_t<I>::value_type { return std::get<I>(m_out); }
+
+    auto get_target() noexcept { return std::get<0>(m_ctrl).get_target(); }
+    auto set_target(typename stage_t<0>::value_type target) -> void { std::get<0>(m_ctrl).set_target(target); }
+};
+
+} // namespace ctrl
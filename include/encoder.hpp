@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "literals.hpp"
+
+namespace enc {
+
+/*
+ * wheel encoders, ticks are counted in the pin interrupt and turned into a
+ * wheel speed by the control loop
+ *
+ * only phase A interrupts (D2 left, D3 right), at its rising edge phase B
+ * gives the direction, one count per encoder cycle (x1): rising to rising
+ * edges of one phase always span a full cycle, so the edge period used at
+ * low speed does not depend on the duty cycle or phase error of the disc
+ */
+enum wheel : uint8_t {
+    left,
+    right,
+};
+constexpr size_t wheels = 2;
+
+// what the loop sees of one encoder
+struct snapshot {
+    int32_t count;      // forward positive, wraps
+    uint32_t t_us;      // time of the last edge
+    uint32_t period_us; // between the last two edges, 0 unless both went the same way
+    bool forward;       // direction of the last edge
+};
+
+/*
+ * interrupt side of one encoder, edge() is the whole handler body
+ * the ISR is the only writer, read() takes a consistent snapshot through a
+ * sequence counter that is odd while an edge is being written and retries
+ * when it changed, on the board that only happens when an edge interrupts
+ * read() itself, the handler never waits
+ */
+class counter {
+    private:
+    std::atomic<uint32_t> m_seq;
+    std::atomic<int32_t> m_count;
+    std::atomic<uint32_t> m_t_us;
+    std::atomic<uint32_t> m_period_us;
+    std::atomic<bool> m_forward;
+    bool m_started; // 仅由中断访问
+
+    public:
+    counter() noexcept : m_seq(0), m_count(0), m_t_us(0), m_period_us(0), m_forward(true), m_started(false) {}
+
+    auto edge(bool forward, uint32_t now_us) -> void {
+        uint32_t seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        bool same = m_started && forward == m_forward.load(std::memory_order_relaxed);
+        m_period_us.store(same ? now_us - m_t_us.load(std::memory_order_relaxed) : 0, std::memory_order_relaxed);
+        m_count.store(m_count.load(std::memory_order_relaxed) + (forward ? 1 : -1), std::memory_order_relaxed);
+        m_t_us.store(now_us, std::memory_order_relaxed);
+        m_forward.store(forward, std::memory_order_relaxed);
+        m_started = true;
+
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    auto read() const -> snapshot {
+        snapshot s;
+        uint32_t seq;
+        do {
+            seq         = m_seq.load(std::memory_order_acquire);
+            s.count     = m_count.load(std::memory_order_relaxed);
+            s.t_us      = m_t_us.load(std::memory_order_relaxed);
+            s.period_us = m_period_us.load(std::memory_order_relaxed);
+            s.forward   = m_forward.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((seq & 1) || seq != m_seq.load(std::memory_order_relaxed));
+        return s;
+    }
+};
+
+// wheel travel per count for an encoder with counts_per_rev x1 counts per wheel turn
+constexpr auto travel_per_count(uint32_t counts_per_rev, literals::leng_t wheel_diameter) -> literals::leng_t {
+    return wheel_diameter * (3.14159265358979323846 / counts_per_rev);
+}
+
+struct config {
+    literals::leng_t per_count; // see travel_per_count
+    uint32_t fast_counts;       // counts per update from which the M method is used
+    uint32_t timeout_us;        // no edge for this long means stopped
+};
+
+/*
+ * hybrid speed estimate, update() once per control period
+ *
+ * M method at high speed: the counts since the last update divided by the
+ * time between the last edges seen at the two updates, with many counts per
+ * update the +-1 count quantisation of a fixed window would dominate, timing
+ * the edges themselves removes it
+ * T method at low speed: one count over the last edge period, available
+ * every update even when no edge arrived in it; with no edge for longer than
+ * that period the wheel cannot be faster than one count over the time since
+ * the last edge, so the estimate decays to zero instead of holding
+ *
+ * the switch has hysteresis, M from fast_counts counts per update and back
+ * to T below half of that
+ */
+class speed {
+    private:
+    config m_cfg;
+    int32_t m_count;
+    uint32_t m_edge_us;
+    bool m_started;
+    bool m_fast;
+    literals::val_t m_value;
+
+    public:
+    explicit speed(const config& cfg) noexcept
+    : m_cfg(cfg), m_count(0), m_edge_us(0), m_started(false), m_fast(false), m_value(0.0) {}
+
+    auto update(const snapshot& s, uint32_t now_us) -> literals::val_t {
+        int32_t dn    = static_cast<int32_t>(static_cast<uint32_t>(s.count) - static_cast<uint32_t>(m_count));
+        uint32_t span = s.t_us - m_edge_us;
+        bool started  = m_started;
+        m_count       = s.count;
+        m_edge_us     = s.t_us;
+        m_started     = true;
+        if (!started) return m_value;
+
+        uint32_t n = dn < 0 ? static_cast<uint32_t>(-dn) : static_cast<uint32_t>(dn);
+        if (n >= m_cfg.fast_counts) m_fast = true;
+        else if (2 * n < m_cfg.fast_counts) m_fast = false;
+
+        double counts_per_s = 0.0;
+        uint32_t since      = now_us - s.t_us;
+        if (static_cast<int32_t>(since) < 0) since = 0; // 读取快照之后又来了一个沿
+        if (m_fast && span > 0) {
+            counts_per_s = dn * 1e6 / span;
+        } else if (s.period_us != 0 && since < m_cfg.timeout_us) {
+            uint32_t period = since > s.period_us ? since : s.period_us;
+            counts_per_s    = (s.forward ? 1e6 : -1e6) / period;
+        }
+
+        m_value = m_cfg.per_count * literals::frq_t(counts_per_s);
+        return m_value;
+    }
+
+    auto reset() -> void {
+        m_started = false;
+        m_fast    = false;
+        m_value   = literals::val_t(0.0);
+    }
+
+    auto value() const -> literals::val_t { return m_value; }
+    // true while the M method is in use
+    auto fast() const -> bool { return m_fast; }
+};
+
+} // namespace enc
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <type_traits>
+
+#include "literals.hpp"
+
+namespace dsp {
+
+/*
+ * fixed-rate IIR and FIR filters for sensor data, header only, no heap
+ * coefficients are designed in double by constexpr functions from a cutoff
+ * frequency and the sample rate, so a constexpr table pulls in no libm code
+ * and costs no startup time, and are stored as float for the Cortex-M4F FPU
+ *
+ * every filter is templated on the channel count N and keeps its state as
+ * structure of arrays, step() filters one sample of all N channels at once
+ * Example:
+ * constexpr auto lp = dsp::biquad_coeffs::lowpass(20Hz, 200Hz);
+ * dsp::biquad<3> acc{ lp };
+ * acc.step(xyz, xyz);
+ */
+using literals::dura_t;
+using literals::frq_t;
+
+constexpr double pi = 3.14159265358979323846;
+
+// sample rate of a fixed period
+constexpr auto rate(dura_t period) -> frq_t {
+    return literals::dim_less(1.0) / period;
+}
+
+namespace __details {
+
+// Taylor series after range reduction, exact to a few ulp for the design range
+constexpr auto sin(double x) -> double {
+    while (x > pi) x -= 2 * pi;
+    while (x < -pi) x += 2 * pi;
+    double term = x, sum = x;
+    for (int n = 1; n < 12; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr auto cos(double x) -> double {
+    return sin(x + pi / 2);
+}
+
+constexpr auto exp(double x) -> double {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x /= 2;
+        halvings++;
+    }
+    double term = 1, sum = 1;
+    for (int n = 1; n < 16; n++) {
+        term *= x / n;
+        sum += term;
+    }
+    while (halvings-- > 0) sum *= sum;
+    return sum;
+}
+
+} // namespace __details
+
+/*
+ * first order low pass, y += a * (x - y)
+ * a := 1 - exp(-2 * pi * fc / fs), the impulse invariant pole
+ */
+struct one_pole {
+    float a;
+
+    static constexpr auto lowpass(frq_t fc, frq_t fs) -> one_pole {
+        return one_pole{ static_cast<float>(1.0 - __details::exp(-2 * pi * fc.v / fs.v)) };
+    }
+
+    // tau is the RC time constant, fc = 1 / (2 * pi * tau)
+    static constexpr auto lowpass(dura_t tau, dura_t period) -> one_pole {
+        return one_pole{ static_cast<float>(1.0 - __details::exp(-period.v / tau.v)) };
+    }
+};
+
+/*
+ * normalized biquad, a0 = 1
+ * H(z) := (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ * designs follow the RBJ audio EQ cookbook (bilinear transform, prewarped)
+ */
+struct biquad_coeffs {
+    float b0, b1, b2;
+    float a1, a2;
+
+    static constexpr double butterworth_q = 0.70710678118654752;
+
+    static constexpr auto lowpass(frq_t fc, frq_t fs, double q = butterworth_q) -> biquad_coeffs {
+        double w = 2 * pi * fc.v / fs.v, c = __details::cos(w), alpha = __details::sin(w) / (2 * q);
+        return normalize((1 - c) / 2, 1 - c, (1 - c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+    }
+
+    static constexpr auto highpass(frq_t fc, frq_t fs, double q = butterworth_q) -> biquad_coeffs {
+        double w = 2 * pi * fc.v / fs.v, c = __details::cos(w), alpha = __details::sin(w) / (2 * q);
+        return normalize((1 + c) / 2, -(1 + c), (1 + c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+    }
+
+    // unit gain at 0 and at fs / 2, zero at f0, q sets the width of the notch
+    static constexpr auto notch(frq_t f0, frq_t fs, double q) -> biquad_coeffs {
+        double w = 2 * pi * f0.v / fs.v, c = __details::cos(w), alpha = __details::sin(w) / (2 * q);
+        return normalize(1, -2 * c, 1, 1 + alpha, -2 * c, 1 - alpha);
+    }
+
+    private:
+    static constexpr auto normalize(double b0, double b1, double b2, double a0, double a1, double a2) -> biquad_coeffs {
+        return biquad_coeffs{ static_cast<float>(b0 / a0), static_cast<float>(b1 / a0), static_cast<float>(b2 / a0),
+                              static_cast<float>(a1 / a0), static_cast<float>(a2 / a0) };
+    }
+};
+
+/*
+ * Butterworth of even Order as Order / 2 second order sections, stage k uses
+ * q := 1 / (2 * sin((2k + 1) * pi / (2 * Order)))
+ */
+template <size_t Order>
+constexpr auto butterworth_lowpass(frq_t fc, frq_t fs) -> std::array<biquad_coeffs, Order / 2> {
+    static_assert(Order >= 2 && Order % 2 == 0, "butterworth order must be even");
+    std::array<biquad_coeffs, Order / 2> s{};
+    for (size_t k = 0; k < Order / 2; k++)
+        s[k] = biquad_coeffs::lowpass(fc, fs, 1.0 / (2 * __details::sin((2 * k + 1) * pi / (2 * Order))));
+    return s;
+}
+
+template <size_t Order>
+constexpr auto butterworth_highpass(frq_t fc, frq_t fs) -> std::array<biquad_coeffs, Order / 2> {
+    static_assert(Order >= 2 && Order % 2 == 0, "butterworth order must be even");
+    std::array<biquad_coeffs, Order / 2> s{};
+    for (size_t k = 0; k < Order / 2; k++)
+        s[k] = biquad_coeffs::highpass(fc, fs, 1.0 / (2 * __details::sin((2 * k + 1) * pi / (2 * Order))));
+    return s;
+}
+
+// |H(e^jw)| of the designs above, for tests and offline tuning, not for the control loop
+inline auto gain(const one_pole& c, frq_t f, frq_t fs) -> double {
+    double w = 2 * pi * f.v / fs.v, p = 1.0 - c.a;
+    return c.a / sqrt(1 - 2 * p * ::cos(w) + p * p);
+}
+
+inline auto gain(const biquad_coeffs& c, frq_t f, frq_t fs) -> double {
+    double w = 2 * pi * f.v / fs.v, c1 = ::cos(w), s1 = ::sin(w), c2 = ::cos(2 * w), s2 = ::sin(2 * w);
+    double nr = c.b0 + c.b1 * c1 + c.b2 * c2, ni = -(c.b1 * s1 + c.b2 * s2);
+    double dr = 1 + c.a1 * c1 + c.a2 * c2, di = -(c.a1 * s1 + c.a2 * s2);
+    return sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+template <size_t Stages>
+inline auto gain(const std::array<biquad_coeffs, Stages>& s, frq_t f, frq_t fs) -> double {
+    double g = 1;
+    for (const auto& c : s) g *= gain(c, f, fs);
+    return g;
+}
+
+/*
+ * first order low pass on N channels
+ * the coefficient can also be passed per step when it is tuned at run time
+ */
+template <size_t N>
+class lowpass1 {
+    private:
+    one_pole m_c;
+    float m_y[N];
+
+    public:
+    constexpr lowpass1() noexcept : m_c{ 1.0f }, m_y{} {}
+    constexpr explicit lowpass1(one_pole c) noexcept : m_c(c), m_y{} {}
+
+    auto step(const one_pole& c, const float* x, float* y) -> void {
+        const float a = c.a; // y may alias c, keep it out of the loop
+        for (size_t i = 0; i < N; i++) {
+            float v = m_y[i] + a * (x[i] - m_y[i]);
+            m_y[i]  = v;
+            y[i]    = v;
+        }
+    }
+    auto step(const float* x, float* y) -> void { step(m_c, x, y); }
+
+    // starts from x instead of 0, avoids the initial step
+    auto reset(const float* x) -> void {
+        for (size_t i = 0; i < N; i++) m_y[i] = x[i];
+    }
+    auto reset() -> void {
+        for (size_t i = 0; i < N; i++) m_y[i] = 0;
+    }
+
+    auto value(size_t i) const -> float { return m_y[i]; }
+};
+
+/*
+ * first order high pass as the input minus its low pass, removes a slowly
+ * changing offset, the coefficient is the one of the low pass it subtracts
+ */
+template <size_t N>
+class highpass1 {
+    private:
+    lowpass1<N> m_lp;
+
+    public:
+    constexpr highpass1() noexcept = default;
+    constexpr explicit highpass1(one_pole c) noexcept : m_lp(c) {}
+
+    auto step(const one_pole& c, const float* x, float* y) -> void {
+        float lp[N];
+        m_lp.step(c, x, lp);
+        for (size_t i = 0; i < N; i++) y[i] = x[i] - lp[i];
+    }
+    auto step(const float* x, float* y) -> void {
+        float lp[N];
+        m_lp.step(x, lp);
+        for (size_t i = 0; i < N; i++) y[i] = x[i] - lp[i];
+    }
+
+    // takes x as the current offset
+    auto reset(const float* x) -> void { m_lp.reset(x); }
+    auto reset() -> void { m_lp.reset(); }
+
+    auto offset(size_t i) const -> float { return m_lp.value(i); }
+};
+
+/*
+ * cascade of Stages biquads on N channels, transposed direct form II
+ * the channel loop is innermost so the compiler can keep it in registers
+ */
+template <size_t N, size_t Stages = 1>
+class biquad {
+    private:
+    std::array<biquad_coeffs, Stages> m_c;
+    float m_z1[Stages][N];
+    float m_z2[Stages][N];
+
+    public:
+    constexpr explicit biquad(const std::array<biquad_coeffs, Stages>& c) noexcept : m_c(c), m_z1{}, m_z2{} {}
+
+    template <size_t S = Stages, typename = std::enable_if_t<S == 1>>
+    constexpr explicit biquad(const biquad_coeffs& c) noexcept : m_c{ { c } }, m_z1{}, m_z2{} {}
+
+    // x and y may alias
+    auto step(const float* x, float* y) -> void {
+        float v[N];
+        for (size_t i = 0; i < N; i++) v[i] = x[i];
+        for (size_t s = 0; s < Stages; s++) {
+            const biquad_coeffs c = m_c[s]; // a copy, stores to the state could alias a reference
+            for (size_t i = 0; i < N; i++) {
+                float in  = v[i];
+                float out = c.b0 * in + m_z1[s][i];
+                m_z1[s][i] = c.b1 * in - c.a1 * out + m_z2[s][i];
+                m_z2[s][i] = c.b2 * in - c.a2 * out;
+                v[i]       = out;
+            }
+        }
+        for (size_t i = 0; i < N; i++) y[i] = v[i];
+    }
+
+    // settles every stage at the steady state of a constant input x
+    auto reset(const float* x) -> void {
+        for (size_t i = 0; i < N; i++) {
+            float in = x[i];
+            for (size_t s = 0; s < Stages; s++) {
+                const biquad_coeffs& c = m_c[s];
+                float out  = in * (c.b0 + c.b1 + c.b2) / (1 + c.a1 + c.a2);
+                m_z2[s][i] = c.b2 * in - c.a2 * out;
+                m_z1[s][i] = out - c.b0 * in;
+                in         = out;
+            }
+        }
+    }
+    auto reset() -> void {
+        for (size_t s = 0; s < Stages; s++)
+            for (size_t i = 0; i < N; i++) m_z1[s][i] = m_z2[s][i] = 0;
+    }
+};
+
+/*
+ * boxcar average of the last Len samples on N channels, O(1) per step
+ * the running sums are rebuilt from the window once per Len steps so float
+ * rounding does not accumulate
+ */
+template <size_t N, size_t Len>
+class moving_average {
+    static_assert(Len > 0, "empty window");
+
+    private:
+    float m_buf[Len][N];
+    float m_sum[N];
+    size_t m_pos;
+
+    public:
+    constexpr moving_average() noexcept : m_buf{}, m_sum{}, m_pos(0) {}
+
+    auto step(const float* x, float* y) -> void {
+        float* slot = m_buf[m_pos];
+        for (size_t i = 0; i < N; i++) {
+            m_sum[i] += x[i] - slot[i];
+            slot[i] = x[i];
+        }
+
+        if (++m_pos == Len) {
+            m_pos = 0;
+            for (size_t i = 0; i < N; i++) {
+                float s = 0;
+                for (size_t k = 0; k < Len; k++) s += m_buf[k][i];
+                m_sum[i] = s;
+            }
+        }
+
+        for (size_t i = 0; i < N; i++) y[i] = m_sum[i] * (1.0f / Len);
+    }
+
+    // fills the window with x
+    auto reset(const float* x) -> void {
+        for (size_t k = 0; k < Len; k++)
+            for (size_t i = 0; i < N; i++) m_buf[k][i] = x[i];
+        for (size_t i = 0; i < N; i++) m_sum[i] = x[i] * Len;
+        m_pos = 0;
+    }
+    auto reset() -> void {
+        const float zero[N] = {};
+        reset(zero);
+    }
+};
+
+} // namespace dsp
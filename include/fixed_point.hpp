@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <limits>
+#include <type_traits>
+
+namespace fxp {
+
+/*
+ * Saturating two's complement fixed-point number
+ * Frac := number of fractional bits
+ * Example:
+ * fixed<16, int32_t> = Q16.16, range [-32768, 32768), lsb 2^-16
+ * fixed<31, int32_t> = Q31,    range [-1, 1),         lsb 2^-31
+ */
+template <int Frac, typename Storage = int32_t>
+struct fixed {
+    static_assert(std::is_signed<Storage>::value, "fixed storage must be signed");
+    static_assert(Frac > 0 && Frac < static_cast<int>(sizeof(Storage) * 8), "invalid fractional bits");
+
+    using storage_t = Storage;
+    using wide_t    = int64_t;
+
+    static constexpr int frac_bits = Frac;
+    static constexpr wide_t one    = wide_t(1) << Frac;
+    static constexpr wide_t max    = std::numeric_limits<Storage>::max();
+    static constexpr wide_t min    = std::numeric_limits<Storage>::min();
+
+    Storage raw;
+
+    constexpr fixed() noexcept : raw(0) {}
+
+    template <typename A, typename = std::enable_if_t<std::is_arithmetic<A>::value>>
+    explicit constexpr fixed(A v) noexcept : raw(from_arith(v)) {}
+
+    static constexpr auto from_raw(wide_t r) noexcept -> fixed {
+        fixed f;
+        f.raw = saturate(r);
+        return f;
+    }
+
+    static constexpr auto saturate(wide_t r) noexcept -> Storage {
+        return static_cast<Storage>(r > max ? max : (r < min ? min : r));
+    }
+
+    template <typename A>
+    static constexpr auto from_arith(A v) noexcept -> Storage {
+        if constexpr (std::is_floating_point<A>::value) {
+            double s = static_cast<double>(v) * static_cast<double>(one);
+            s += s >= 0 ? .5 : -.5;
+            return s >= static_cast<double>(max) ? static_cast<Storage>(max)
+                 : s <= static_cast<double>(min) ? static_cast<Storage>(min)
+                                                 : static_cast<Storage>(static_cast<wide_t>(s));
+        } else {
+            wide_t w = static_cast<wide_t>(v);
+            return (w > (max >> Frac)) ? static_cast<Storage>(max)
+                 : (w < (min >> Frac)) ? static_cast<Storage>(min)
+                                       : static_cast<Storage>(w * one);
+        }
+    }
+
+    explicit constexpr operator double() const noexcept { return static_cast<double>(raw) / static_cast<double>(one); }
+    explicit constexpr operator float() const noexcept { return static_cast<float>(raw) / static_cast<float>(one); }
+
+    constexpr auto operator-() const noexcept -> fixed { return from_raw(-static_cast<wide_t>(raw)); }
+
+    constexpr auto operator+=(fixed rhs) noexcept -> fixed& { return *this = *this + rhs; }
+    constexpr auto operator-=(fixed rhs) noexcept -> fixed& { return *this = *this - rhs; }
+    constexpr auto operator*=(fixed rhs) noexcept -> fixed& { return *this = *this * rhs; }
+    constexpr auto operator/=(fixed rhs) noexcept -> fixed& { return *this = *this / rhs; }
+
+    friend constexpr auto operator+(fixed lhs, fixed rhs) noexcept -> fixed {
+        return from_raw(static_cast<wide_t>(lhs.raw) + rhs.raw);
+    }
+    friend constexpr auto operator-(fixed lhs, fixed rhs) noexcept -> fixed {
+        return from_raw(static_cast<wide_t>(lhs.raw) - rhs.raw);
+    }
+    // round to nearest, the product of two Q31 still fits in 64 bits
+    friend constexpr auto operator*(fixed lhs, fixed rhs) noexcept -> fixed {
+        return from_raw((static_cast<wide_t>(lhs.raw) * rhs.raw + (one >> 1)) >> Frac);
+    }
+    // division by zero saturates towards the sign of the dividend
+    // scaled by a multiply, left shifting a negative dividend is undefined
+    friend constexpr auto operator/(fixed lhs, fixed rhs) noexcept -> fixed {
+        if (rhs.raw == 0) return from_raw(lhs.raw >= 0 ? max : min);
+        return from_raw(static_cast<wide_t>(lhs.raw) * one / rhs.raw);
+    }
+
+    friend constexpr auto operator==(fixed lhs, fixed rhs) noexcept -> bool { return lhs.raw == rhs.raw; }
+    friend constexpr auto operator!=(fixed lhs, fixed rhs) noexcept -> bool { return lhs.raw != rhs.raw; }
+    friend constexpr auto operator<(fixed lhs, fixed rhs) noexcept -> bool { return lhs.raw < rhs.raw; }
+    friend constexpr auto operator>(fixed lhs, fixed rhs) noexcept -> bool { return lhs.raw > rhs.raw; }
+    friend constexpr auto operator<=(fixed lhs, fixed rhs) noexcept -> bool { return lhs.raw <= rhs.raw; }
+    friend constexpr auto operator>=(fixed lhs, fixed rhs) noexcept -> bool { return lhs.raw >= rhs.raw; }
+};
+
+using q16_16 = fixed<16, int32_t>;
+using q31    = fixed<31, int32_t>;
+
+template <typename T>
+struct is_fixed : std::false_type {};
+template <int Frac, typename Storage>
+struct is_fixed<fixed<Frac, Storage>> : std::true_type {};
+
+} // namespace fxp
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "encoder.hpp"
+
+/*
+ * compile-time hardware abstraction, every device is a CRTP base that forwards
+ * to the backend's *_impl functions, nothing is virtual so the calls inline away
+ *
+ * a platform is a struct naming one backend per device:
+ *   struct platform {
+ *       using matrix   = ...; // hal::matrix<...>
+ *       using imu      = ...; // hal::imu<...>
+ *       using knob     = ...; // hal::knob<...>
+ *       using buttons  = ...; // hal::buttons<...>
+ *       using pixels   = ...; // hal::pixels<...>
+ *       using clock    = ...; // hal::clock<...>
+ *       using serial   = ...; // hal::serial<...>
+ *       using encoders = ...; // hal::encoders<...>
+ *   };
+ * see hal_arduino.hpp for the target and hal_host.hpp for the native env
+ */
+namespace hal {
+
+#define HAL_CRTP_SELF                                                                   \
+    auto self() -> Derived& { return static_cast<Derived&>(*this); }                    \
+    auto self() const -> const Derived& { return static_cast<const Derived&>(*this); }
+
+// 12x8 matrix taking the three frame words of led_frame.hpp
+template <typename Derived>
+class matrix {
+    HAL_CRTP_SELF
+
+    public:
+    auto begin() -> void { self().begin_impl(); }
+    auto load(const uint32_t* words) -> void { self().load_impl(words); }
+    auto clear() -> void { self().clear_impl(); }
+};
+
+/*
+ * accelerometer in g, gyro in rad/s, both latched by update()
+ * update() latches the next unread sample and returns false when there is
+ * none, calling it until false drains the backlog and never repeats a sample
+ * stream(false) stops sampling into the backlog and discards it, update()
+ * then has nothing to return until stream(true)
+ * t_us() is when the latched sample was taken, not when it was read
+ */
+template <typename Derived>
+class imu {
+    HAL_CRTP_SELF
+
+    public:
+    auto begin() -> bool { return self().begin_impl(); }
+    auto update() -> bool { return self().update_impl(); }
+    auto stream(bool on) -> void { self().stream_impl(on); }
+    auto t_us() -> uint32_t { return self().t_us_impl(); }
+    auto x() -> float { return self().x_impl(); }
+    auto y() -> float { return self().y_impl(); }
+    auto z() -> float { return self().z_impl(); }
+    auto gx() -> float { return self().gx_impl(); }
+    auto gy() -> float { return self().gy_impl(); }
+    auto gz() -> float { return self().gz_impl(); }
+};
+
+template <typename Derived>
+class knob {
+    HAL_CRTP_SELF
+
+    public:
+    auto begin() -> bool { return self().begin_impl(); }
+    auto get() -> int16_t { return self().get_impl(); }
+    auto set(int16_t value) -> void { self().set_impl(value); }
+    auto pressed() -> bool { return self().pressed_impl(); }
+};
+
+// buttons named 'A', 'B', 'C'
+template <typename Derived>
+class buttons {
+    HAL_CRTP_SELF
+
+    public:
+    auto begin() -> bool { return self().begin_impl(); }
+    auto update() -> bool { return self().update_impl(); }
+    auto pressed(char name) -> bool { return self().pressed_impl(name); }
+};
+
+struct color {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
+
+template <typename Derived>
+class pixels {
+    HAL_CRTP_SELF
+
+    public:
+    auto begin() -> bool { return self().begin_impl(); }
+    auto set(int idx, color c, uint8_t brightness) -> void { self().set_impl(idx, c, brightness); }
+    auto clear() -> void { self().clear_impl(); }
+    auto show() -> void { self().show_impl(); }
+};
+
+// wheel encoders counted in their pin interrupts, see encoder.hpp
+template <typename Derived>
+class encoders {
+    HAL_CRTP_SELF
+
+    public:
+    auto begin() -> bool { return self().begin_impl(); }
+    auto read(enc::wheel w) -> enc::snapshot { return self().read_impl(w); }
+};
+
+// free running clocks, both wrap, usable as the scheduler's Clock through now()
+template <typename Derived>
+class clock {
+    public:
+    static auto millis() -> uint32_t { return Derived::millis_impl(); }
+    static auto micros() -> uint32_t { return Derived::micros_impl(); }
+    static auto now() -> uint32_t { return Derived::micros_impl(); }
+};
+
+// byte stream, print() overloads cover what the profiler and dumps need
+template <typename Derived>
+class serial {
+    HAL_CRTP_SELF
+
+    public:
+    auto available() -> int { return self().available_impl(); }
+    auto read() -> int { return self().read_impl(); }
+    auto write(const char* data, size_t len) -> size_t { return self().write_impl(data, len); }
+
+    auto print(const char* s) -> size_t {
+        size_t n = 0;
+        while (s[n]) n++;
+        return write(s, n);
+    }
+    auto print(char c) -> size_t { return write(&c, 1); }
+    auto print(unsigned long v) -> size_t {
+        char buf[3 * sizeof(unsigned long)];
+        char* p = buf + sizeof(buf);
+        do {
+            *--p = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v);
+        return write(p, buf + sizeof(buf) - p);
+    }
+    auto println(const char* s) -> size_t { return print(s) + print('\n'); }
+};
+
+#undef HAL_CRTP_SELF
+
+} // namespace hal
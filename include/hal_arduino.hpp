@@ -0,0 +1,178 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Arduino_LED_Matrix.h>
+#include <Modulino.h>
+#include <Wire.h>
+
+#include "hal.hpp"
+#include "lsm6dsox.hpp"
+
+/*
+ * UNO R4 WiFi backends, every call forwards to the Arduino or Modulino object
+ * it wraps and inlines to the same code as calling that object directly
+ */
+namespace hal {
+
+class arduino_matrix : public matrix<arduino_matrix> {
+    friend class matrix<arduino_matrix>;
+
+    private:
+    ArduinoLEDMatrix m_dev;
+
+    auto begin_impl() -> void { m_dev.begin(); }
+    auto load_impl(const uint32_t* words) -> void { m_dev.loadFrame(words); }
+    auto clear_impl() -> void { m_dev.clear(); }
+};
+
+/*
+ * Modulino Movement read through the sensor FIFO on the Qwiic bus (Wire1)
+ * instead of the library's one-sample register reads, when the queue runs
+ * dry the whole FIFO is fetched in bursts, each update() hands out one sample
+ */
+class arduino_imu : public imu<arduino_imu> {
+    friend class imu<arduino_imu>;
+
+    private:
+    lsm6::fifo<TwoWire> m_fifo{ Wire1 };
+    lsm6::queue<16> m_queue;
+    lsm6::sample m_cur{};
+    bool m_streaming = false;
+
+    auto begin_impl() -> bool { return m_streaming = m_fifo.begin(); }
+    auto update_impl() -> bool {
+        if (!m_streaming) return false;
+        if (m_queue.empty()) m_fifo.read(m_queue, ::micros());
+        return m_queue.pop(m_cur);
+    }
+    auto stream_impl(bool on) -> void {
+        m_fifo.stream(on);
+        m_queue.clear();
+        m_streaming = on;
+    }
+    auto t_us_impl() -> uint32_t { return m_cur.t_us; }
+    auto x_impl() -> float { return m_cur.ax(); }
+    auto y_impl() -> float { return m_cur.ay(); }
+    auto z_impl() -> float { return m_cur.az(); }
+    auto gx_impl() -> float { return m_cur.gx(); }
+    auto gy_impl() -> float { return m_cur.gy(); }
+    auto gz_impl() -> float { return m_cur.gz(); }
+
+    public:
+    // the latched sample with its sequence number and sampling time
+    auto current() const -> const lsm6::sample& { return m_cur; }
+    auto overruns() const -> uint32_t { return m_fifo.overruns(); }
+    auto dropped() const -> uint32_t { return m_queue.dropped(); }
+};
+
+class arduino_knob : public knob<arduino_knob> {
+    friend class knob<arduino_knob>;
+
+    private:
+    ModulinoKnob m_dev;
+
+    auto begin_impl() -> bool { return m_dev.begin(); }
+    auto get_impl() -> int16_t { return m_dev.get(); }
+    auto set_impl(int16_t value) -> void { m_dev.set(value); }
+    auto pressed_impl() -> bool { return m_dev.isPressed(); }
+};
+
+class arduino_buttons : public buttons<arduino_buttons> {
+    friend class buttons<arduino_buttons>;
+
+    private:
+    ModulinoButtons m_dev;
+
+    auto begin_impl() -> bool { return m_dev.begin(); }
+    auto update_impl() -> bool { return m_dev.update(); }
+    auto pressed_impl(char name) -> bool { return m_dev.isPressed(name); }
+};
+
+class arduino_pixels : public pixels<arduino_pixels> {
+    friend class pixels<arduino_pixels>;
+
+    private:
+    ModulinoPixels m_dev;
+
+    auto begin_impl() -> bool { return m_dev.begin(); }
+    auto set_impl(int idx, color c, uint8_t brightness) -> void { m_dev.set(idx, ModulinoColor(c.r, c.g, c.b), brightness); }
+    auto clear_impl() -> void { m_dev.clear(); }
+    auto show_impl() -> void { m_dev.show(); }
+};
+
+class arduino_clock : public clock<arduino_clock> {
+    friend class clock<arduino_clock>;
+
+    private:
+    static auto millis_impl() -> uint32_t { return ::millis(); }
+    static auto micros_impl() -> uint32_t { return ::micros(); }
+};
+
+class arduino_serial : public serial<arduino_serial> {
+    friend class serial<arduino_serial>;
+
+    private:
+    auto available_impl() -> int { return Serial.available(); }
+    auto read_impl() -> int { return Serial.read(); }
+    // through Print, the board serial classes hide the buffer overloads
+    auto write_impl(const char* data, size_t len) -> size_t {
+        return static_cast<Print&>(Serial).write(reinterpret_cast<const uint8_t*>(data), len);
+    }
+};
+
+// encoder pins, phase A on the interrupt pins of the wiring plan
+namespace pins {
+constexpr uint8_t enc_left_a  = 2;
+constexpr uint8_t enc_right_a = 3;
+// D0 / D1 (Serial1, not the USB Serial) are the header pins the plan leaves free
+constexpr uint8_t enc_left_b  = 0;
+constexpr uint8_t enc_right_b = 1;
+// B low at the rising edge of A is forward, the right motor is mounted mirrored
+constexpr bool enc_left_mirrored  = false;
+constexpr bool enc_right_mirrored = true;
+} // namespace pins
+
+/*
+ * wheel encoders, the handler reads phase B straight from the port input
+ * register, digitalRead() alone would cost more than the rest of it
+ */
+class arduino_encoders : public encoders<arduino_encoders> {
+    friend class encoders<arduino_encoders>;
+
+    private:
+    // 中断处理函数只能是普通函数指针，状态放在静态存储中
+    static inline enc::counter s_counters[enc::wheels];
+    static inline bsp_io_port_pin_t s_b[enc::wheels];
+
+    template <enc::wheel W, bool Mirrored>
+    static auto isr() -> void {
+        bool b = R_BSP_PinRead(s_b[W]) != 0;
+        s_counters[W].edge(b == Mirrored, ::micros());
+    }
+
+    auto begin_impl() -> bool {
+        pinMode(pins::enc_left_a, INPUT_PULLUP);
+        pinMode(pins::enc_right_a, INPUT_PULLUP);
+        pinMode(pins::enc_left_b, INPUT_PULLUP);
+        pinMode(pins::enc_right_b, INPUT_PULLUP);
+        s_b[enc::left]  = digitalPinToBspPin(pins::enc_left_b);
+        s_b[enc::right] = digitalPinToBspPin(pins::enc_right_b);
+        attachInterrupt(digitalPinToInterrupt(pins::enc_left_a), isr<enc::left, pins::enc_left_mirrored>, RISING);
+        attachInterrupt(digitalPinToInterrupt(pins::enc_right_a), isr<enc::right, pins::enc_right_mirrored>, RISING);
+        return true;
+    }
+    auto read_impl(enc::wheel w) -> enc::snapshot { return s_counters[w].read(); }
+};
+
+struct arduino {
+    using matrix   = arduino_matrix;
+    using imu      = arduino_imu;
+    using knob     = arduino_knob;
+    using buttons  = arduino_buttons;
+    using pixels   = arduino_pixels;
+    using clock    = arduino_clock;
+    using serial   = arduino_serial;
+    using encoders = arduino_encoders;
+};
+
+} // namespace hal
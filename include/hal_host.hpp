@@ -0,0 +1,336 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "hal.hpp"
+
+/*
+ * native backends for tests and benchmarks
+ * time only moves when host_clock is advanced, so a run is deterministic and
+ * as fast as the host can go, scripted inputs change at their timestamps,
+ * matrix frames are recorded and can be written out as PBM images
+ */
+namespace hal {
+
+class host_clock : public clock<host_clock> {
+    friend class clock<host_clock>;
+
+    private:
+    static inline uint64_t s_us = 0;
+
+    static auto millis_impl() -> uint32_t { return static_cast<uint32_t>(s_us / 1000); }
+    static auto micros_impl() -> uint32_t { return static_cast<uint32_t>(s_us); }
+
+    public:
+    static auto set(uint64_t us) -> void { s_us = us; }
+    static auto advance(uint32_t us) -> void { s_us += us; }
+    static auto elapsed_us() -> uint64_t { return s_us; }
+};
+
+class host_matrix : public matrix<host_matrix> {
+    friend class matrix<host_matrix>;
+
+    public:
+    struct frame {
+        uint32_t t_us;
+        std::array<uint32_t, 3> words;
+    };
+
+    private:
+    std::vector<frame> m_frames;
+    bool m_begun = false;
+
+    auto begin_impl() -> void { m_begun = true; }
+    auto load_impl(const uint32_t* words) -> void {
+        m_frames.push_back(frame{ host_clock::micros(), { words[0], words[1], words[2] } });
+    }
+    auto clear_impl() -> void { m_frames.push_back(frame{ host_clock::micros(), { 0, 0, 0 } }); }
+
+    public:
+    auto begun() const -> bool { return m_begun; }
+    auto frames() const -> const std::vector<frame>& { return m_frames; }
+    auto last() const -> std::array<uint32_t, 3> { return m_frames.empty() ? std::array<uint32_t, 3>{} : m_frames.back().words; }
+    auto reset() -> void { m_frames.clear(); }
+
+    // plain PBM (P1), one text row per matrix row, 1 is a lit pixel
+    static auto to_pbm(const std::array<uint32_t, 3>& words) -> std::string {
+        std::string s = "P1\n12 8\n";
+        for (int r = 0; r < 8; r++) {
+            for (int c = 0; c < 12; c++) {
+                int idx = r * 12 + c;
+                s += (words[idx / 32] >> (31 - idx % 32)) & 0x01 ? '1' : '0';
+                s += c == 11 ? '\n' : ' ';
+            }
+        }
+        return s;
+    }
+
+    // frame idx as <prefix><idx>.pbm, false when out of range or not writable
+    auto save_pbm(const char* prefix, size_t idx) const -> bool {
+        if (idx >= m_frames.size()) return false;
+
+        std::string path = std::string(prefix) + std::to_string(idx) + ".pbm";
+        FILE* fp         = fopen(path.c_str(), "w");
+        if (!fp) return false;
+
+        std::string img = to_pbm(m_frames[idx].words);
+        bool ok         = fwrite(img.data(), 1, img.size(), fp) == img.size();
+        return fclose(fp) == 0 && ok;
+    }
+};
+
+/*
+ * IMU driven by a function of time, constant when no source is set
+ * the source fills v[0..2] with the acceleration in g and v[3..5] with the
+ * gyro rates in rad/s, entries it does not write keep their last value
+ *
+ * with a period set samples are produced on that grid like a sensor FIFO,
+ * update() catches up one sample at a time, without one every new clock
+ * value is a new sample, in both cases a sample is never handed out twice
+ */
+class host_imu : public imu<host_imu> {
+    friend class imu<host_imu>;
+
+    public:
+    using source_fn = void (*)(uint32_t t_us, float* v, void* ctx);
+
+    private:
+    source_fn m_source   = nullptr;
+    void* m_ctx          = nullptr;
+    float m_v[6]         = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+    uint32_t m_updates   = 0;
+    uint32_t m_period_us = 0;
+    uint32_t m_last_us   = 0;
+    bool m_streaming     = true;
+    bool m_anchored      = false; // 已有样本，下一个按周期排在其后
+
+    auto begin_impl() -> bool { return true; }
+    auto update_impl() -> bool {
+        if (!m_streaming) return false;
+        uint32_t now = host_clock::micros();
+        uint32_t t   = now;
+        if (m_anchored) {
+            t = m_period_us ? m_last_us + m_period_us : now;
+            if (t == m_last_us || static_cast<int32_t>(now - t) < 0) return false;
+        }
+
+        if (m_source) m_source(t, m_v, m_ctx);
+        m_last_us  = t;
+        m_anchored = true;
+        m_updates++;
+        return true;
+    }
+    // 重新打开后第一个样本取当前时间
+    auto stream_impl(bool on) -> void {
+        if (!on) m_anchored = false;
+        m_streaming = on;
+    }
+    auto t_us_impl() -> uint32_t { return m_last_us; }
+    auto x_impl() -> float { return m_v[0]; }
+    auto y_impl() -> float { return m_v[1]; }
+    auto z_impl() -> float { return m_v[2]; }
+    auto gx_impl() -> float { return m_v[3]; }
+    auto gy_impl() -> float { return m_v[4]; }
+    auto gz_impl() -> float { return m_v[5]; }
+
+    public:
+    auto period(uint32_t us) -> void { m_period_us = us; }
+    auto source(source_fn fn, void* ctx = nullptr) -> void {
+        m_source = fn;
+        m_ctx    = ctx;
+    }
+    auto hold(float x, float y, float z) -> void {
+        m_v[0] = x;
+        m_v[1] = y;
+        m_v[2] = z;
+    }
+    auto updates() const -> uint32_t { return m_updates; }
+    auto streaming() const -> bool { return m_streaming; }
+    auto last_us() const -> uint32_t { return m_last_us; }
+};
+
+/*
+ * timed input events, ordered by t_ms, every event up to the current time is
+ * applied on the next read so inputs between polls are still seen in order
+ */
+template <typename Event>
+class script {
+    private:
+    const Event* m_events = nullptr;
+    size_t m_count        = 0;
+    size_t m_next         = 0;
+
+    public:
+    auto load(const Event* events, size_t count) -> void {
+        m_events = events;
+        m_count  = count;
+        m_next   = 0;
+    }
+
+    template <typename Apply>
+    auto run(Apply&& apply) -> bool {
+        bool changed = false;
+        uint32_t now = host_clock::millis();
+        for (; m_next < m_count && m_events[m_next].t_ms <= now; m_next++) {
+            apply(m_events[m_next]);
+            changed = true;
+        }
+        return changed;
+    }
+
+    auto done() const -> bool { return m_next == m_count; }
+};
+
+class host_knob : public knob<host_knob> {
+    friend class knob<host_knob>;
+
+    public:
+    struct event {
+        uint32_t t_ms;
+        int16_t value;
+        bool pressed;
+    };
+
+    private:
+    script<event> m_script;
+    int16_t m_value = 0;
+    bool m_pressed  = false;
+
+    auto poll() -> void {
+        m_script.run([this](const event& e) {
+            m_value   = e.value;
+            m_pressed = e.pressed;
+        });
+    }
+
+    auto begin_impl() -> bool { return true; }
+    auto get_impl() -> int16_t {
+        poll();
+        return m_value;
+    }
+    auto set_impl(int16_t value) -> void {
+        poll();
+        m_value = value;
+    }
+    auto pressed_impl() -> bool {
+        poll();
+        return m_pressed;
+    }
+
+    public:
+    template <size_t N>
+    auto play(const event (&events)[N]) -> void { m_script.load(events, N); }
+};
+
+// state changes only on update(), like the Modulino buttons
+class host_buttons : public buttons<host_buttons> {
+    friend class buttons<host_buttons>;
+
+    public:
+    struct event {
+        uint32_t t_ms;
+        char name; // 'A', 'B' or 'C'
+        bool down;
+    };
+
+    private:
+    script<event> m_script;
+    bool m_down[3] = { false, false, false };
+
+    auto begin_impl() -> bool { return true; }
+    auto update_impl() -> bool {
+        return m_script.run([this](const event& e) {
+            if (e.name >= 'A' && e.name <= 'C') m_down[e.name - 'A'] = e.down;
+        });
+    }
+    auto pressed_impl(char name) -> bool { return name >= 'A' && name <= 'C' && m_down[name - 'A']; }
+
+    public:
+    template <size_t N>
+    auto play(const event (&events)[N]) -> void { m_script.load(events, N); }
+};
+
+class host_pixels : public pixels<host_pixels> {
+    friend class pixels<host_pixels>;
+
+    public:
+    static constexpr int count = 8;
+
+    struct pixel {
+        color c;
+        uint8_t brightness;
+    };
+
+    private:
+    std::array<pixel, count> m_staged{};
+    std::array<pixel, count> m_shown{};
+    uint32_t m_shows = 0;
+
+    auto begin_impl() -> bool { return true; }
+    auto set_impl(int idx, color c, uint8_t brightness) -> void {
+        if (idx >= 0 && idx < count) m_staged[idx] = pixel{ c, brightness };
+    }
+    auto clear_impl() -> void { m_staged = {}; }
+    auto show_impl() -> void {
+        m_shown = m_staged;
+        m_shows++;
+    }
+
+    public:
+    auto shown(int idx) const -> const pixel& { return m_shown[idx]; }
+    auto shows() const -> uint32_t { return m_shows; }
+};
+
+class host_serial : public serial<host_serial> {
+    friend class serial<host_serial>;
+
+    private:
+    std::string m_in;
+    size_t m_pos = 0;
+    std::string m_out;
+
+    auto available_impl() -> int { return static_cast<int>(m_in.size() - m_pos); }
+    auto read_impl() -> int { return m_pos < m_in.size() ? static_cast<unsigned char>(m_in[m_pos++]) : -1; }
+    auto write_impl(const char* data, size_t len) -> size_t {
+        m_out.append(data, len);
+        return len;
+    }
+
+    public:
+    auto feed(const char* s) -> void { m_in += s; }
+    auto output() const -> const std::string& { return m_out; }
+    auto clear_output() -> void { m_out.clear(); }
+};
+
+// edges are injected by the test, stamped with host_clock unless given a time
+class host_encoders : public encoders<host_encoders> {
+    friend class encoders<host_encoders>;
+
+    private:
+    enc::counter m_counters[enc::wheels];
+
+    auto begin_impl() -> bool { return true; }
+    auto read_impl(enc::wheel w) -> enc::snapshot { return m_counters[w].read(); }
+
+    public:
+    auto edge(enc::wheel w, bool forward) -> void { m_counters[w].edge(forward, host_clock::micros()); }
+    auto edge(enc::wheel w, bool forward, uint32_t t_us) -> void { m_counters[w].edge(forward, t_us); }
+};
+
+struct host {
+    using matrix   = host_matrix;
+    using imu      = host_imu;
+    using knob     = host_knob;
+    using buttons  = host_buttons;
+    using pixels   = host_pixels;
+    using clock    = host_clock;
+    using serial   = host_serial;
+    using encoders = host_encoders;
+};
+
+} // namespace hal
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include "filter.hpp"
+#include "literals.hpp"
+#include "lsm6dsox.hpp"
+#include "trace.hpp"
+
+namespace app {
+
+/*
+ * SHOW_IMU pipeline: high pass (raw - slow low pass), smoothing, deadzone,
+ * integration to velocity with decay, integration to position
+ * the firmware and the trace replay both run motion::step, so parameters
+ * tuned offline behave the same on the board
+ */
+struct imu_params {
+    dsp::one_pole offset;     // 低通滤波提取缓慢变化的偏移
+    dsp::one_pole smoothing;  // 平滑滤波（更快响应）
+    float deadzone;           // 加速度死区 (g)
+    float velocity_threshold; // 速度死区 (m/s)
+    float decay_idle;         // 速度低于死区时的衰减
+    float decay_moving;       // 运动中的速度轻度衰减
+};
+
+// SHOW_IMU 的采样率即传感器 FIFO 的输出频率，每个样本按固定的 dt 积分
+inline constexpr literals::frq_t imu_rate(lsm6::rate_hz);
+inline constexpr float imu_dt = static_cast<float>(1.0 / lsm6::rate_hz);
+
+// 调整后的参数，截止频率与原来 200 Hz 下的 alpha 0.98、0.3 相当
+inline constexpr imu_params default_imu_params{
+    dsp::one_pole::lowpass(literals::frq_t(0.64), imu_rate),
+    dsp::one_pole::lowpass(literals::frq_t(38.0), imu_rate),
+    0.01f, 0.001f, 0.9f, 0.99f,
+};
+
+// IMU 积分状态，x / y 两个通道一起滤波
+struct motion {
+    float vel_x, vel_y;
+    float pos_x, pos_y;
+
+    // 使用高通滤波去除DC偏移，而不是简单的offset
+    dsp::highpass1<2> dynamic;
+    dsp::lowpass1<2> smooth;
+    float acc_x, acc_y;
+
+    // 以当前读数作为偏移的初值，避免进入模式时的阶跃
+    auto reset(float acc_x_raw, float acc_y_raw) -> void {
+        *this = motion{};
+
+        const float raw[2] = { acc_x_raw, acc_y_raw };
+        dynamic.reset(raw);
+    }
+
+    // 全部状态，录制从运行中途开始时写入 trace，回放从这里继续
+    static constexpr size_t state_size = 10;
+    static_assert(state_size == trace::state_values, "trace state record does not match motion");
+
+    auto save(float* v) const -> void {
+        const float s[state_size] = { vel_x, vel_y, pos_x, pos_y, dynamic.offset(0), dynamic.offset(1),
+                                      smooth.value(0), smooth.value(1), acc_x, acc_y };
+        for (size_t i = 0; i < state_size; i++) v[i] = s[i];
+    }
+
+    auto restore(const float* v) -> void {
+        vel_x = v[0];
+        vel_y = v[1];
+        pos_x = v[2];
+        pos_y = v[3];
+        dynamic.reset(v + 4);
+        smooth.reset(v + 6);
+        acc_x = v[8];
+        acc_y = v[9];
+    }
+
+    // 原始加速度 (g)，dt 为固定采样周期 (s)
+    auto step(const imu_params& p, float acc_x_raw, float acc_y_raw, float dt) -> void {
+        // 高通滤波：原始信号 - 低频成分，再轻度平滑以减少噪声
+        const float raw[2] = { acc_x_raw, acc_y_raw };
+        float acc[2];
+        dynamic.step(p.offset, raw, acc);
+        smooth.step(p.smoothing, acc, acc);
+
+        // 应用死区
+        acc_x = (fabsf(acc[0]) > p.deadzone) ? acc[0] : 0.0f;
+        acc_y = (fabsf(acc[1]) > p.deadzone) ? acc[1] : 0.0f;
+
+        // 转换为 m/s²，积分得到速度
+        vel_x += acc_x * 9.81f * dt;
+        vel_y += acc_y * 9.81f * dt;
+
+        // 速度死区和轻度衰减（仅在小速度时快速衰减）
+        vel_x *= fabsf(vel_x) < p.velocity_threshold ? p.decay_idle : p.decay_moving;
+        vel_y *= fabsf(vel_y) < p.velocity_threshold ? p.decay_idle : p.decay_moving;
+
+        // 积分得到位置
+        pos_x += vel_x * dt;
+        pos_y += vel_y * dt;
+    }
+};
+
+/*
+ * trace::replay handler running motion::step on recorded samples, dt is the
+ * fixed period the firmware stepped with, see app::imu_dt
+ */
+struct imu_replay {
+    imu_params params;
+    float dt;
+    motion state;
+    uint32_t steps;
+
+    imu_replay(const imu_params& p, float period_s) noexcept : params(p), dt(period_s), state{}, steps(0) {}
+
+    auto on_reset(const trace::record& r) -> void { state.reset(r.acc.x, r.acc.y); }
+    auto on_state(const trace::record& r) -> void { state.restore(r.state); }
+    auto on_imu(const trace::record& r) -> void {
+        state.step(params, r.acc.x, r.acc.y, dt);
+        steps++;
+    }
+    auto on_buttons(const trace::record&) -> void {}
+    auto on_knob(const trace::record&) -> void {}
+};
+
+} // namespace app
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "led_frame.hpp"
+
+namespace led {
+
+enum class play_mode : uint8_t {
+    once,
+    loop,
+};
+
+struct anim_frame {
+    mask words;
+    uint16_t duration_ms;
+};
+
+/*
+ * a frame sequence, either a static table (frames) or a render callback
+ * called with the step index, render returns the step duration in ms or 0 for step_ms
+ * the sequence and ctx must outlive the playback
+ */
+struct sequence {
+    const anim_frame* frames;
+    uint16_t count;
+    uint16_t step_ms;
+    uint16_t (*render)(uint32_t* f, uint16_t idx, const void* ctx);
+    const void* ctx;
+};
+
+/*
+ * non-blocking sequence player, tick() renders at most one frame and never waits
+ * a late tick shows the next frame and restarts its timing instead of catching up,
+ * so the cost of one tick is bounded by one render
+ * play() preempts a running sequence of lower or equal priority, a preempted loop
+ * is kept and resumed when the one-shot that replaced it ends
+ */
+class player {
+    public:
+    enum result : uint8_t {
+        idle,  // nothing playing
+        hold,  // current frame still due
+        frame, // out holds a new frame
+        done,  // the last sequence ended, out is untouched
+    };
+
+    private:
+    struct slot {
+        const sequence* seq;
+        uint16_t idx;
+        uint8_t priority;
+        play_mode mode;
+    };
+
+    slot m_cur;
+    slot m_saved;
+    uint32_t m_next;
+    bool m_active;
+    bool m_has_saved;
+    bool m_pending; // frame idx not rendered yet
+
+    auto render(uint32_t* out, uint32_t now) -> void {
+        const sequence& seq = *m_cur.seq;
+        uint16_t dur;
+        if (seq.frames) {
+            for (int w = 0; w < words; w++) out[w] = seq.frames[m_cur.idx].words[w];
+            dur = seq.frames[m_cur.idx].duration_ms;
+        } else {
+            dur = seq.render(out, m_cur.idx, seq.ctx);
+            if (!dur) dur = seq.step_ms;
+        }
+
+        uint32_t base = m_pending || now - m_next >= dur ? now : m_next;
+        m_next        = base + dur;
+        m_pending     = false;
+    }
+
+    public:
+    player() noexcept
+    : m_cur{}, m_saved{}, m_next(0), m_active(false), m_has_saved(false), m_pending(false) {}
+
+    // false when the sequence is empty or a higher priority one is playing
+    auto play(const sequence& seq, play_mode mode = play_mode::once, uint8_t priority = 0) -> bool {
+        if (seq.count == 0 || (!seq.frames && !seq.render)) return false;
+
+        if (m_active) {
+            if (priority < m_cur.priority) return false;
+            if (m_cur.mode == play_mode::loop && mode == play_mode::once) {
+                m_saved     = m_cur;
+                m_has_saved = true;
+            }
+        }
+        if (mode == play_mode::loop) m_has_saved = false;
+
+        m_cur     = slot{ &seq, 0, priority, mode };
+        m_active  = true;
+        m_pending = true;
+        return true;
+    }
+
+    auto stop() -> void {
+        m_active    = false;
+        m_has_saved = false;
+    }
+
+    auto tick(uint32_t now, uint32_t* out) -> result {
+        if (!m_active) return idle;
+        if (m_pending) {
+            render(out, now);
+            return frame;
+        }
+        if (static_cast<int32_t>(now - m_next) < 0) return hold;
+
+        if (++m_cur.idx >= m_cur.seq->count) {
+            if (m_cur.mode == play_mode::loop) {
+                m_cur.idx = 0;
+            } else if (m_has_saved) {
+                m_cur       = m_saved;
+                m_has_saved = false;
+                m_pending   = true;
+            } else {
+                m_active = false;
+                return done;
+            }
+        }
+        render(out, now);
+        return frame;
+    }
+
+    auto active() const noexcept -> bool { return m_active; }
+    auto priority() const noexcept -> uint8_t { return m_cur.priority; }
+    auto index() const noexcept -> uint16_t { return m_cur.idx; }
+};
+
+/// render callbacks for the common effects
+
+// even steps fully on, odd steps off, count = 2 * times
+inline auto render_flash(uint32_t* f, uint16_t idx, const void*) -> uint16_t {
+    uint32_t v = (idx & 1) ? 0x00000000 : 0xFFFFFFFF;
+    for (int w = 0; w < words; w++) f[w] = v;
+    return 0;
+}
+
+// ctx := const uint8_t* glyph index, shown centred on even steps
+inline auto render_blink(uint32_t* f, uint16_t idx, const void* ctx) -> uint16_t {
+    for (int w = 0; w < words; w++) f[w] = 0;
+    if (!(idx & 1)) draw_glyph(f, *static_cast<const uint8_t*>(ctx), (width - glyph_width) / 2, (height - glyph_height) / 2);
+    return 0;
+}
+
+/*
+ * glyph string scrolling right to left, enters from the right edge and leaves on the left
+ * ctx := const scroll_text*, count = scroll_text::steps()
+ */
+struct scroll_text {
+    static constexpr int advance = glyph_width + 1;
+
+    const uint8_t* glyphs;
+    uint8_t len;
+
+    constexpr auto steps() const -> uint16_t { return width + len * advance; }
+};
+
+inline auto render_scroll(uint32_t* f, uint16_t idx, const void* ctx) -> uint16_t {
+    const scroll_text& t = *static_cast<const scroll_text*>(ctx);
+
+    for (int w = 0; w < words; w++) f[w] = 0;
+
+    int x0 = width - idx;
+    int y  = (height - glyph_height) / 2;
+    for (uint8_t i = 0; i < t.len; i++) {
+        int x = x0 + i * scroll_text::advance;
+        if (x >= width) break;
+        if (x + glyph_width <= 0) continue;
+        draw_glyph(f, t.glyphs[i], x, y);
+    }
+    return 0;
+}
+
+} // namespace led
@@ -0,0 +1,22 @@
+// generated by utils/frame_gen.py pack boot.txt, do not edit
+// 10 frames, 113 bytes packed, 120 bytes unpacked
+#pragma once
+
+#include <stdint.h>
+
+namespace led::assets {
+
+inline constexpr uint8_t boot[113] = {
+    0x0A, 0x08, 0x04, 0x81, 0x60, 0x06, 0x04, 0x08, 0x02, 0x85, 0x1F, 0x81,
+    0x68, 0x16, 0x81, 0xF8, 0x02, 0x08, 0x00, 0x89, 0x07, 0xFE, 0x5F, 0xA5,
+    0x0A, 0x50, 0xA5, 0xFA, 0x7F, 0xE0, 0x00, 0x08, 0x42, 0xFF, 0x85, 0xC0,
+    0x3C, 0x03, 0xC0, 0x3C, 0x03, 0x42, 0xFF, 0x0F, 0x00, 0x89, 0x07, 0xFE,
+    0x7F, 0xE7, 0xFE, 0x7F, 0xE7, 0xFE, 0x7F, 0xE0, 0x00, 0x06, 0x00, 0x89,
+    0x07, 0xFE, 0x7F, 0xE7, 0xFE, 0x7F, 0xE7, 0xFE, 0x7F, 0xE0, 0x00, 0x06,
+    0x42, 0xFF, 0x85, 0xC0, 0x3C, 0x03, 0xC0, 0x3C, 0x03, 0x42, 0xFF, 0x06,
+    0x00, 0x89, 0x07, 0xFE, 0x5F, 0xA5, 0x0A, 0x50, 0xA5, 0xFA, 0x7F, 0xE0,
+    0x00, 0x06, 0x02, 0x85, 0x1F, 0x81, 0x68, 0x16, 0x81, 0xF8, 0x02, 0x0A,
+    0x04, 0x81, 0x60, 0x06, 0x04,
+};
+
+} // namespace led::assets
@@ -0,0 +1,621 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+namespace led {
+
+/*
+ * bitmap fonts compiled from ASCII-art string literals at compile time
+ * a glyph is its rows written one after another, '#' lit and '.' or ' ' unlit,
+ * the glyph width is the literal length divided by the font height, so
+ * proportional fonts just use literals of different lengths
+ * every row is stored frame-aligned: column c of the glyph is bit 11 - c of a
+ * 12 bit matrix row, drawing at column x is one shift per row
+ */
+constexpr int font_max_height = 8;
+constexpr int font_row_bits   = 12;
+
+struct font_glyph {
+    uint16_t rows[font_max_height];
+    uint8_t width;
+};
+
+constexpr uint8_t font_missing = 0xFF;
+
+// type erased view over a compiled font, what print() takes
+struct font {
+    const font_glyph* glyphs;
+    const uint8_t* index; // ascii -> glyph, font_missing when absent
+    uint8_t height;
+    uint8_t spacing; // unlit columns between glyphs
+
+    constexpr auto find(char c) const -> const font_glyph* {
+        uint8_t u = static_cast<uint8_t>(c);
+        return u < 128 && index[u] != font_missing ? &glyphs[index[u]] : nullptr;
+    }
+};
+
+template <size_t N>
+struct font_table {
+    std::array<font_glyph, N> glyphs;
+    std::array<uint8_t, 128> index;
+    uint8_t height;
+    uint8_t spacing;
+
+    constexpr auto view() const -> font { return font{ glyphs.data(), index.data(), height, spacing }; }
+};
+
+namespace __details {
+
+// not constexpr, reaching it during constant evaluation fails the build with this name in the error
+auto font_art_error_bad_length_or_pixel() -> void;
+
+constexpr auto length(const char* s) -> size_t {
+    size_t n = 0;
+    while (s[n]) n++;
+    return n;
+}
+
+} // namespace __details
+
+/*
+ * charset := one character per art entry, in the same order
+ * art     := glyph literals, each height * width characters
+ */
+template <size_t N>
+constexpr auto compile_font(const char* charset, const char* const (&art)[N], uint8_t height, uint8_t spacing = 1)
+    -> font_table<N> {
+    font_table<N> t{};
+    t.height  = height;
+    t.spacing = spacing;
+    for (auto& i : t.index) i = font_missing;
+
+    if (height == 0 || height > font_max_height || __details::length(charset) != N)
+        __details::font_art_error_bad_length_or_pixel();
+
+    for (size_t g = 0; g < N; g++) {
+        size_t len = __details::length(art[g]);
+        size_t w   = len / height;
+        if (len % height != 0 || w == 0 || w > 8) __details::font_art_error_bad_length_or_pixel();
+
+        t.glyphs[g].width = static_cast<uint8_t>(w);
+        for (size_t r = 0; r < height; r++) {
+            uint16_t row = 0;
+            for (size_t c = 0; c < w; c++) {
+                char p = art[g][r * w + c];
+                if (p == '#') row |= uint16_t(1) << (font_row_bits - 1 - c);
+                else if (p != '.' && p != ' ') __details::font_art_error_bad_length_or_pixel();
+            }
+            t.glyphs[g].rows[r] = row;
+        }
+        t.index[static_cast<uint8_t>(charset[g]) & 0x7F] = static_cast<uint8_t>(g);
+    }
+    return t;
+}
+
+namespace fonts {
+
+// 3x5, the first 17 glyphs are the digit slots used by draw_digits
+inline constexpr const char* art_3x5[] = {
+    // 0
+    "###"
+    "#.#"
+    "#.#"
+    "#.#"
+    "###",
+    // 1
+    ".#."
+    "##."
+    ".#."
+    ".#."
+    "###",
+    // 2
+    "###"
+    "..#"
+    "###"
+    "#.."
+    "###",
+    // 3
+    "###"
+    "..#"
+    "###"
+    "..#"
+    "###",
+    // 4
+    "#.#"
+    "#.#"
+    "###"
+    "..#"
+    "..#",
+    // 5
+    "###"
+    "#.."
+    "###"
+    "..#"
+    "###",
+    // 6
+    "###"
+    "#.."
+    "###"
+    "#.#"
+    "###",
+    // 7
+    "###"
+    "..#"
+    "..#"
+    "..#"
+    "..#",
+    // 8
+    "###"
+    "#.#"
+    "###"
+    "#.#"
+    "###",
+    // 9
+    "###"
+    "#.#"
+    "###"
+    "..#"
+    "###",
+    // A
+    ".#."
+    "#.#"
+    "###"
+    "#.#"
+    "#.#",
+    // B
+    "##."
+    "#.#"
+    "##."
+    "#.#"
+    "##.",
+    // C
+    "###"
+    "#.."
+    "#.."
+    "#.."
+    "###",
+    // D
+    "##."
+    "..#"
+    "..#"
+    "..#"
+    "##.",
+    // E
+    "###"
+    "#.."
+    "###"
+    "#.."
+    "###",
+    // F
+    "###"
+    "#.."
+    "###"
+    "#.."
+    "#..",
+    // -
+    "..."
+    "..."
+    "###"
+    "..."
+    "...",
+    // space
+    "..."
+    "..."
+    "..."
+    "..."
+    "...",
+};
+
+// 6x8 hex digits, two fit on the matrix
+inline constexpr const char* art_6x8[] = {
+    // 0
+    ".####."
+    "#....#"
+    "#...##"
+    "#..#.#"
+    "#.#..#"
+    "##...#"
+    "#....#"
+    ".####.",
+    // 1
+    "..#..."
+    ".##..."
+    "..#..."
+    "..#..."
+    "..#..."
+    "..#..."
+    "..#..."
+    ".###..",
+    // 2
+    ".####."
+    "#....#"
+    ".....#"
+    "....#."
+    "...#.."
+    "..#..."
+    ".#...."
+    "######",
+    // 3
+    ".####."
+    "#....#"
+    ".....#"
+    "...##."
+    ".....#"
+    ".....#"
+    "#....#"
+    ".####.",
+    // 4
+    "....#."
+    "...##."
+    "..#.#."
+    ".#..#."
+    "#...#."
+    "######"
+    "....#."
+    "....#.",
+    // 5
+    "######"
+    "#....."
+    "#....."
+    "#####."
+    ".....#"
+    ".....#"
+    "#....#"
+    ".####.",
+    // 6
+    "..###."
+    ".#...."
+    "#....."
+    "#####."
+    "#....#"
+    "#....#"
+    "#....#"
+    ".####.",
+    // 7
+    "######"
+    ".....#"
+    "....#."
+    "...#.."
+    "..#..."
+    ".#...."
+    ".#...."
+    ".#....",
+    // 8
+    ".####."
+    "#....#"
+    "#....#"
+    ".####."
+    "#....#"
+    "#....#"
+    "#....#"
+    ".####.",
+    // 9
+    ".####."
+    "#....#"
+    "#....#"
+    "#....#"
+    ".#####"
+    ".....#"
+    "....#."
+    ".###..",
+    // A
+    "..##.."
+    ".#..#."
+    "#....#"
+    "#....#"
+    "######"
+    "#....#"
+    "#....#"
+    "#....#",
+    // B
+    "#####."
+    "#....#"
+    "#....#"
+    "#####."
+    "#....#"
+    "#....#"
+    "#....#"
+    "#####.",
+    // C
+    ".####."
+    "#....#"
+    "#....."
+    "#....."
+    "#....."
+    "#....."
+    "#....#"
+    ".####.",
+    // D
+    "####.."
+    "#...#."
+    "#....#"
+    "#....#"
+    "#....#"
+    "#....#"
+    "#...#."
+    "####..",
+    // E
+    "######"
+    "#....."
+    "#....."
+    "#####."
+    "#....."
+    "#....."
+    "#....."
+    "######",
+    // F
+    "######"
+    "#....."
+    "#....."
+    "#####."
+    "#....."
+    "#....."
+    "#....."
+    "#.....",
+};
+
+// 5 rows, 1 to 5 columns wide
+inline constexpr const char* art_prop[] = {
+    // 0
+    "###"
+    "#.#"
+    "#.#"
+    "#.#"
+    "###",
+    // 1
+    ".#"
+    "##"
+    ".#"
+    ".#"
+    ".#",
+    // 2
+    "##."
+    "..#"
+    ".#."
+    "#.."
+    "###",
+    // 3
+    "##."
+    "..#"
+    ".#."
+    "..#"
+    "##.",
+    // 4
+    "#.#"
+    "#.#"
+    "###"
+    "..#"
+    "..#",
+    // 5
+    "###"
+    "#.."
+    "##."
+    "..#"
+    "##.",
+    // 6
+    ".##"
+    "#.."
+    "###"
+    "#.#"
+    "###",
+    // 7
+    "###"
+    "..#"
+    ".#."
+    ".#."
+    ".#.",
+    // 8
+    "###"
+    "#.#"
+    "###"
+    "#.#"
+    "###",
+    // 9
+    "###"
+    "#.#"
+    "###"
+    "..#"
+    "##.",
+    // A
+    ".#."
+    "#.#"
+    "###"
+    "#.#"
+    "#.#",
+    // B
+    "##."
+    "#.#"
+    "##."
+    "#.#"
+    "##.",
+    // C
+    ".##"
+    "#.."
+    "#.."
+    "#.."
+    ".##",
+    // D
+    "##."
+    "#.#"
+    "#.#"
+    "#.#"
+    "##.",
+    // E
+    "###"
+    "#.."
+    "##."
+    "#.."
+    "###",
+    // F
+    "###"
+    "#.."
+    "##."
+    "#.."
+    "#..",
+    // G
+    ".##"
+    "#.."
+    "#.#"
+    "#.#"
+    ".##",
+    // H
+    "#.#"
+    "#.#"
+    "###"
+    "#.#"
+    "#.#",
+    // I
+    "#"
+    "#"
+    "#"
+    "#"
+    "#",
+    // J
+    "..#"
+    "..#"
+    "..#"
+    "#.#"
+    ".#.",
+    // K
+    "#.#"
+    "#.#"
+    "##."
+    "#.#"
+    "#.#",
+    // L
+    "#.."
+    "#.."
+    "#.."
+    "#.."
+    "###",
+    // M
+    "#...#"
+    "##.##"
+    "#.#.#"
+    "#...#"
+    "#...#",
+    // N
+    "#..#"
+    "##.#"
+    "#.##"
+    "#..#"
+    "#..#",
+    // O
+    ".#."
+    "#.#"
+    "#.#"
+    "#.#"
+    ".#.",
+    // P
+    "##."
+    "#.#"
+    "##."
+    "#.."
+    "#..",
+    // Q
+    ".#.."
+    "#.#."
+    "#.#."
+    "#.#."
+    ".#.#",
+    // R
+    "##."
+    "#.#"
+    "##."
+    "#.#"
+    "#.#",
+    // S
+    ".##"
+    "#.."
+    ".#."
+    "..#"
+    "##.",
+    // T
+    "###"
+    ".#."
+    ".#."
+    ".#."
+    ".#.",
+    // U
+    "#.#"
+    "#.#"
+    "#.#"
+    "#.#"
+    "###",
+    // V
+    "#.#"
+    "#.#"
+    "#.#"
+    "#.#"
+    ".#.",
+    // W
+    "#...#"
+    "#...#"
+    "#.#.#"
+    "##.##"
+    "#...#",
+    // X
+    "#.#"
+    "#.#"
+    ".#."
+    "#.#"
+    "#.#",
+    // Y
+    "#.#"
+    "#.#"
+    ".#."
+    ".#."
+    ".#.",
+    // Z
+    "###"
+    "..#"
+    ".#."
+    "#.."
+    "###",
+    // -
+    ".."
+    ".."
+    "##"
+    ".."
+    "..",
+    // .
+    "."
+    "."
+    "."
+    "."
+    "#",
+    // :
+    "."
+    "#"
+    "."
+    "#"
+    ".",
+    // !
+    "#"
+    "#"
+    "#"
+    "."
+    "#",
+    // space
+    ".."
+    ".."
+    ".."
+    ".."
+    "..",
+};
+
+} // namespace fonts
+
+inline constexpr auto font_3x5_table  = compile_font("0123456789ABCDEF- ", fonts::art_3x5, 5);
+inline constexpr auto font_6x8_table  = compile_font("0123456789ABCDEF", fonts::art_6x8, 8, 0);
+inline constexpr auto font_prop_table = compile_font("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-.:! ", fonts::art_prop, 5);
+
+inline constexpr font font_3x5  = font_3x5_table.view();
+inline constexpr font font_6x8  = font_6x8_table.view();
+inline constexpr font font_prop = font_prop_table.view();
+
+} // namespace led
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "led_font.hpp"
+
+namespace led {
+
+/*
+ * frame combined with 96 bits (12 * 8), three words fi sc tr
+ * pixel idx = row * 12 + col, idx 0 is the msb of fi, idx 95 the lsb of tr
+ */
+constexpr int width  = 12;
+constexpr int height = 8;
+constexpr int words  = 3;
+
+constexpr int glyph_width  = 3;
+constexpr int glyph_height = 5;
+constexpr int slot_count   = width / glyph_width;
+
+constexpr uint8_t glyph_minus = 16; // '-'
+
+// the digit slots index the first glyph_count glyphs of font_3x5, "0123456789ABCDEF-"
+constexpr size_t glyph_count = 17;
+
+// bit c of row r of digit glyph g, 0 is the left column
+constexpr auto glyph_bit(uint8_t g, int r, int c) -> bool {
+    return (font_3x5_table.glyphs[g].rows[r] >> (font_row_bits - 1 - c)) & 0x01;
+}
+
+// 96 bit mask in frame layout
+using mask = std::array<uint32_t, words>;
+
+// set or clear one pixel, out of range indices are ignored
+inline auto set_bit(uint32_t* f, int idx, bool val) -> void {
+    if (idx < 0 || idx >= width * height) return;
+
+    uint32_t bit = uint32_t(1) << (31 - idx % 32);
+    if (val) f[idx / 32] |= bit;
+    else f[idx / 32] &= ~bit;
+}
+
+namespace __details {
+
+constexpr auto or_bit(mask& m, int idx) -> void {
+    m[idx / 32] |= uint32_t(1) << (31 - idx % 32);
+}
+
+// pixels of glyph g placed at slot s
+constexpr auto glyph_mask(uint8_t g, int s) -> mask {
+    mask m{};
+    for (int r = 0; r < glyph_height; r++)
+        for (int c = 0; c < glyph_width; c++)
+            if (glyph_bit(g, r, c)) or_bit(m, r * width + s * glyph_width + c);
+    return m;
+}
+
+// every pixel a glyph at slot s can cover
+constexpr auto box_mask(int s) -> mask {
+    mask m{};
+    for (int r = 0; r < glyph_height; r++)
+        for (int c = 0; c < glyph_width; c++) or_bit(m, r * width + s * glyph_width + c);
+    return m;
+}
+
+constexpr auto build_glyph_masks() -> std::array<std::array<mask, glyph_count>, slot_count> {
+    std::array<std::array<mask, glyph_count>, slot_count> t{};
+    for (int s = 0; s < slot_count; s++)
+        for (size_t g = 0; g < glyph_count; g++) t[s][g] = glyph_mask(static_cast<uint8_t>(g), s);
+    return t;
+}
+
+constexpr auto build_box_masks() -> std::array<mask, slot_count> {
+    std::array<mask, slot_count> t{};
+    for (int s = 0; s < slot_count; s++) t[s] = box_mask(s);
+    return t;
+}
+
+} // namespace __details
+
+// precompiled at compile time, indexed [slot][glyph]
+inline constexpr auto glyph_masks = __details::build_glyph_masks();
+inline constexpr auto box_masks   = __details::build_box_masks();
+
+// replace the 3x5 box of slot s with glyph g, g must be below glyph_count
+inline auto blit(uint32_t* f, int s, uint8_t g) -> void {
+    const mask& box = box_masks[s];
+    const mask& gm  = glyph_masks[s][g];
+    for (int w = 0; w < words; w++) f[w] = (f[w] & ~box[w]) | gm[w];
+}
+
+// four glyphs over the top five rows, rows 5..7 are left untouched
+inline auto draw_digits(uint32_t* f, uint8_t a, uint8_t b, uint8_t c, uint8_t d) -> void {
+    blit(f, 0, a);
+    blit(f, 1, b);
+    blit(f, 2, c);
+    blit(f, 3, d);
+}
+
+// glyph g with its top left corner at (x, y), pixels off the matrix are clipped, unlit pixels are kept
+inline auto draw_glyph(uint32_t* f, uint8_t g, int x, int y) -> void {
+    for (int r = 0; r < glyph_height; r++) {
+        if (y + r < 0 || y + r >= height) continue;
+        for (int c = 0; c < glyph_width; c++) {
+            if (x + c < 0 || x + c >= width) continue;
+            if (glyph_bit(g, r, c)) set_bit(f, (y + r) * width + x + c, true);
+        }
+    }
+}
+
+// pixel by pixel version of draw_digits, kept as the reference for tests and benchmarks
+inline auto draw_digits_bitwise(uint32_t* f, uint8_t a, uint8_t b, uint8_t c, uint8_t d) -> void {
+    auto set_digit = [f](uint8_t dig, int r, int c) {
+        for (int i = 0; i < glyph_height; i++) {
+            for (int j = 0; j < glyph_width; j++) {
+                set_bit(f, (r + i) * width + (c + j), glyph_bit(dig, i, j));
+            }
+        }
+    };
+
+    set_digit(a, 0, 0);
+    set_digit(b, 0, 3);
+    set_digit(c, 0, 6);
+    set_digit(d, 0, 9);
+}
+
+// OR a 12 bit frame-aligned row into matrix row r, the row may straddle two words
+inline auto or_row(uint32_t* f, int r, uint16_t bits) -> void {
+    int idx = r * width;
+    int off = idx % 32;
+    int w   = idx / 32;
+    if (off <= 32 - width) {
+        f[w] |= uint32_t(bits) << (32 - width - off);
+    } else {
+        f[w] |= uint32_t(bits) >> (off - (32 - width));
+        f[w + 1] |= uint32_t(bits) << (64 - width - off);
+    }
+}
+
+// width in columns of s drawn with fnt, missing characters take no space
+inline auto text_width(const font& fnt, const char* s) -> int {
+    int w = 0;
+    for (; *s; s++) {
+        const font_glyph* g = fnt.find(*s);
+        if (g) w += g->width + fnt.spacing;
+    }
+    return w ? w - fnt.spacing : 0;
+}
+
+/*
+ * OR s into the frame with its top left corner at (x, y), clipped to the matrix
+ * one shift and one or_row per glyph row, returns the column after the text
+ */
+inline auto draw_text(uint32_t* f, const font& fnt, const char* s, int x, int y) -> int {
+    for (; *s; s++) {
+        const font_glyph* g = fnt.find(*s);
+        if (!g) continue;
+
+        if (x < width && x + g->width > 0) {
+            for (int r = 0; r < fnt.height; r++) {
+                if (y + r < 0 || y + r >= height) continue;
+                uint16_t row = x >= 0 ? g->rows[r] >> x : g->rows[r] << -x;
+                row &= (1u << width) - 1;
+                if (row) or_row(f, y + r, row);
+            }
+        }
+        x += g->width + fnt.spacing;
+    }
+    return x;
+}
+
+// value as text in base 2..16 with upper case digits, out needs 34 bytes
+inline auto format_int(int32_t val, int base, char* out) -> char* {
+    base = base < 2 ? 2 : base > 16 ? 16 : base;
+
+    char tmp[33];
+    int n      = 0;
+    uint32_t v = val < 0 ? 0u - static_cast<uint32_t>(val) : static_cast<uint32_t>(val);
+    do {
+        tmp[n++] = "0123456789ABCDEF"[v % base];
+        v /= base;
+    } while (v);
+
+    char* p = out;
+    if (val < 0) *p++ = '-';
+    while (n) *p++ = tmp[--n];
+    *p = 0;
+    return out;
+}
+
+/*
+ * split a value into four glyph indices, most significant first
+ * base is clamped to 2..16, the value to what four digits can show,
+ * negative values use the first slot for '-'
+ */
+inline auto split_digits(int32_t val, int base, uint8_t* out) -> void {
+    base = base < 2 ? 2 : base > 16 ? 16 : base;
+
+    int32_t max_positive = base * base * base * base - 1;
+    int32_t min_negative = -(base * base * base - 1);
+
+    val = val < min_negative ? min_negative : val > max_positive ? max_positive : val;
+
+    bool negative = val < 0;
+    uint32_t v    = negative ? -val : val;
+
+    out[3] = v % base;
+    v /= base;
+    out[2] = v % base;
+    v /= base;
+    out[1] = v % base;
+    v /= base;
+    out[0] = negative ? glyph_minus : v % base;
+}
+
+} // namespace led
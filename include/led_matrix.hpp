@@ -1,38 +1,210 @@
 // led_matrix.hpp
 #pragma once
 
-#include <array>
-#include <initializer_list>
-#include <memory>
+#include <math.h>
 #include <stdint.h>
-#include <tuple>
 
-class LED_Matrix {
+#include "hal.hpp"
+#include "led_anim.hpp"
+#include "led_pack.hpp"
+#include "led_raster.hpp"
+#include "profiler.hpp"
+
+namespace led::__details {
+
+inline constexpr uint32_t full_on[] = {
+    0xFFFFFFFF,
+    0xFFFFFFFF,
+    0xFFFFFFFF
+};
+
+} // namespace led::__details
+
+// Device := a hal::matrix backend, hal::arduino_matrix on the board, hal::host_matrix in tests
+template <typename Device>
+class basic_led_matrix {
     private:
-    struct {
+    struct frame {
         uint32_t fi;
         uint32_t sc;
         uint32_t tr;
-    } m_frame;
-    std::shared_ptr<class ArduinoLEDMatrix> m_matrix;
+    };
+
+    frame m_frame; // back buffer, every drawing call goes here
+    frame m_front; // what the hardware currently shows
+    uint32_t m_pushed;
+    uint32_t m_skipped;
+    led::player m_player;
+    led::sequence m_flash;
+    uint32_t m_anim[led::words]; // last frame rendered by the player
+    Device m_device;
+
+    // load the frame only when it differs from the front buffer
+    void push(const uint32_t* words) {
+        if (words[0] == m_front.fi && words[1] == m_front.sc && words[2] == m_front.tr) {
+            m_skipped++;
+            return;
+        }
+
+        PROF_SCOPE(prof::matrix_show);
+        m_front = frame{ words[0], words[1], words[2] };
+        m_device.load(words);
+        m_pushed++;
+    }
 
     public:
-    void generate_frame(uint8_t a, uint8_t b, uint8_t c, uint8_t d);
+    void generate_frame(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        /*
+        frame combined with 96 bits (12 * 8)
+        '-' when val = 16
+
+        f31 f30 f29 | f28 f27 f26 | f25 f24 f23 | f22 f21 f20
+        f19 f18 f17 | f16 f15 f14 | f13 f12 f11 | f10 f09 f08
+        f07 f06 f05 | f04 f03 f02 | f01 f00 s31 | s30 s29 s28
+        s27 s26 s25 | s24 s23 s22 | s21 s20 s19 | s18 s17 s16
+        -----------------------------------------------------
+        s15 s14 s13 | s12 s11 s10 | s09 s08 s07 | s06 s05 s04
+        s03 s02 s01 | t00 t31 t30 | t29 t28 t27 | t26 t25 t24
+        t23 t22 t21 | t20 t19 t18 | t17 t16 t15 | t14 t13 t12
+        t11 t10 t09 | t08 t07 t06 | t05 t04 t03 | t02 t01 t00
+        */
+
+        a = a > led::glyph_minus ? led::glyph_minus : a;
+        b = b > led::glyph_minus ? led::glyph_minus : b;
+        c = c > led::glyph_minus ? led::glyph_minus : c;
+        d = d > led::glyph_minus ? led::glyph_minus : d;
+
+        // one and/or per word and slot, see led_frame.hpp
+        led::draw_digits(buffer(), a, b, c, d);
+    }
+
+    basic_led_matrix()
+    : m_frame{ 0, 0, 0 }, m_front{ 0, 0, 0 }, m_pushed(0), m_skipped(0), m_flash{}, m_anim{ 0, 0, 0 } {
+    }
+
+    ~basic_led_matrix() {
+        m_device.clear();
+    }
+
+    // floor, not truncation, so points in (-1, 0) are clipped instead of landing on 0
+    void draw_point(float rx, float ry) { led::pixel(buffer(), static_cast<int>(floorf(rx)), static_cast<int>(floorf(ry))); }
+
+    // integer primitives, clipped to the matrix, see led_raster.hpp
+    void draw_pixel(int x, int y) { led::pixel(buffer(), x, y); }
+    void draw_hline(int x0, int x1, int y) { led::hline(buffer(), x0, x1, y); }
+    void draw_vline(int x, int y0, int y1) { led::vline(buffer(), x, y0, y1); }
+    void draw_rect(int x0, int y0, int x1, int y1, bool filled = false) { led::rect(buffer(), x0, y0, x1, y1, filled); }
+    void draw_chart(const led::strip_chart& chart, led::strip_chart::style s = led::strip_chart::dots) { chart.draw(buffer(), s); }
+
+    // back buffer as the three frame words
+    uint32_t* buffer() { return reinterpret_cast<uint32_t*>(&m_frame); }
 
-    LED_Matrix();
-    ~LED_Matrix();
+    void set_bit(int idx, bool val) { led::set_bit(buffer(), idx, val); }
 
-    void draw_point(float x, float y);
+    void print(uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3) {
+        clean();
+        generate_frame(d0, d1, d2, d3);
+        show();
+    }
 
-    void set_bit(int idx, bool val);
+    void print(int32_t value, int base = 10) {
+        uint8_t d[4];
+        led::split_digits(value, base, d);
+        print(d[0], d[1], d[2], d[3]);
+    }
 
-    void print(uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3);
-    void print(int32_t value, int base = 10);
+    // any font, the value is right aligned and vertically centred, digits that do not fit are clipped
+    void print(int32_t value, int base, const led::font& font) {
+        char text[34];
+        led::format_int(value, base, text);
 
-    void show();
-    void begin();
-    void clean();
-    void clear();
-    void fill();
-    void flash(uint8_t times = 3, uint16_t duration = 100);
+        clean();
+        led::draw_text(buffer(), font, text, led::width - led::text_width(font, text), (led::height - font.height) / 2);
+        show();
+    }
+
+    void print(const char* text, const led::font& font = led::font_prop, int x = 0, int y = 0) {
+        clean();
+        led::draw_text(buffer(), font, text, x, y);
+        show();
+    }
+
+    // decode frame idx of a packed blob into the back buffer, false when out of range
+    bool draw(led::packed_anim& anim, uint16_t idx) {
+        const uint32_t* f = anim.seek(idx);
+        if (!f) return false;
+        m_frame = frame{ f[0], f[1], f[2] };
+        return true;
+    }
+
+    void show() {
+        if (m_player.active()) return;
+        push(buffer());
+    }
+
+    void begin() { m_device.begin(); }
+
+    void clean() {
+        m_frame = frame{ 0, 0, 0 };
+    }
+
+    void clear() {
+        clean();
+        show();
+    }
+
+    void fill() {
+        if (m_player.active()) return;
+        push(led::__details::full_on);
+    }
+
+    // non-blocking, played by tick()
+    void flash(uint8_t times = 3, uint16_t duration = 100) {
+        m_flash = led::sequence{ nullptr, static_cast<uint16_t>(times * 2), static_cast<uint16_t>(duration >> 1), led::render_flash, nullptr };
+        play(m_flash, led::play_mode::once, UINT8_MAX);
+    }
+
+    /*
+     * while a sequence plays it owns the hardware, drawing calls still go to the
+     * back buffer and show() only keeps it, the back buffer is shown again when
+     * the sequence ends
+     */
+    bool play(const led::sequence& seq, led::play_mode mode = led::play_mode::once, uint8_t priority = 0) {
+        return m_player.play(seq, mode, priority);
+    }
+
+    void stop() {
+        if (!m_player.active()) return;
+        m_player.stop();
+        show();
+    }
+
+    void tick(uint32_t now_ms) {
+        PROF_SCOPE(prof::matrix_anim);
+        switch (m_player.tick(now_ms, m_anim)) {
+        case led::player::frame: push(m_anim); break;
+        case led::player::done: show(); break;
+        default: break;
+        }
+    }
+
+    bool animating() const { return m_player.active(); }
+
+    // frames sent to the hardware / frames dropped because nothing changed
+    uint32_t pushed_frames() const { return m_pushed; }
+    uint32_t skipped_frames() const { return m_skipped; }
+    void reset_counters() {
+        m_pushed  = 0;
+        m_skipped = 0;
+    }
+
+    Device& device() { return m_device; }
 };
+
+#ifdef ARDUINO
+#include "hal_arduino.hpp"
+
+// compiled once in led_matrix.cpp
+extern template class basic_led_matrix<hal::arduino_matrix>;
+using LED_Matrix = basic_led_matrix<hal::arduino_matrix>;
+#endif
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "led_anim.hpp"
+#include "led_frame.hpp"
+
+namespace led {
+
+/*
+ * packed frame sequence, decoded straight from flash, see utils/frame_gen.py pack
+ *
+ * blob  := count:u8 frame{count}
+ * frame := duration:u8 (10 ms units) token... covering exactly 12 bytes
+ *
+ * a frame is 12 bytes in pixel order (byte k = bits 31..24 >> 8 * (k % 4) of word k / 4),
+ * every frame is XORed onto the previous one, the first one onto an empty frame
+ *
+ * token := 00nnnnnn                skip n + 1 bytes, unchanged
+ *          01nnnnnn b              XOR b into the next n + 1 bytes
+ *          10nnnnnn b{n + 1}       XOR n + 1 literal bytes
+ */
+namespace pack {
+
+constexpr uint8_t frame_bytes = words * 4;
+constexpr uint16_t tick_ms    = 10;
+
+constexpr uint8_t skip    = 0x00;
+constexpr uint8_t repeat  = 0x40;
+constexpr uint8_t literal = 0x80;
+constexpr uint8_t kind    = 0xC0;
+constexpr uint8_t len     = 0x3F;
+
+// worst case: duration plus alternating one byte literals and skips, 3 bytes per 2
+constexpr size_t max_frame_size = 1 + frame_bytes * 3 / 2;
+
+inline auto byte_at(const uint32_t* f, uint8_t k) -> uint8_t {
+    return static_cast<uint8_t>(f[k >> 2] >> (24 - 8 * (k & 3)));
+}
+
+inline auto xor_byte(uint32_t* f, uint8_t k, uint8_t b) -> void {
+    f[k >> 2] ^= uint32_t(b) << (24 - 8 * (k & 3));
+}
+
+} // namespace pack
+
+/*
+ * apply one packed frame onto f, which must hold the previous frame
+ * end is one past the last byte of the blob, nothing at or after it is read
+ * returns the start of the next frame, nullptr when the frame is malformed
+ * or would cross end, f may then be partially updated
+ */
+inline auto unpack_frame(const uint8_t* p, const uint8_t* end, uint32_t* f, uint16_t* duration_ms) -> const uint8_t* {
+    if (p >= end) return nullptr;
+    if (duration_ms) *duration_ms = *p * pack::tick_ms;
+    p++;
+
+    uint8_t k = 0;
+    while (k < pack::frame_bytes) {
+        if (p >= end) return nullptr;
+        uint8_t t = *p++;
+        uint8_t n = (t & pack::len) + 1;
+        if (k + n > pack::frame_bytes) return nullptr;
+
+        switch (t & pack::kind) {
+        case pack::skip: k += n; break;
+        case pack::repeat: {
+            if (p >= end) return nullptr;
+            uint8_t b = *p++;
+            for (; n; n--) pack::xor_byte(f, k++, b);
+            break;
+        }
+        case pack::literal:
+            if (end - p < n) return nullptr;
+            for (; n; n--) pack::xor_byte(f, k++, *p++);
+            break;
+        default: return nullptr;
+        }
+    }
+    return p;
+}
+
+/*
+ * encode cur against prev, same greedy choice as the python packer so both
+ * produce identical blobs, out needs pack::max_frame_size bytes
+ * returns the number of bytes written, host side tooling and tests only
+ */
+inline auto pack_frame(const uint32_t* prev, const uint32_t* cur, uint16_t duration_ms, uint8_t* out) -> size_t {
+    uint8_t d[pack::frame_bytes];
+    for (uint8_t k = 0; k < pack::frame_bytes; k++) d[k] = pack::byte_at(prev, k) ^ pack::byte_at(cur, k);
+
+    auto run_at = [&d](uint8_t k) -> uint8_t {
+        uint8_t r = 1;
+        while (k + r < pack::frame_bytes && d[k + r] == d[k]) r++;
+        return r;
+    };
+
+    size_t n = 0;
+    uint32_t ticks = duration_ms / pack::tick_ms;
+    out[n++]       = static_cast<uint8_t>(ticks > 255 ? 255 : ticks);
+
+    uint8_t k = 0;
+    while (k < pack::frame_bytes) {
+        uint8_t r = run_at(k);
+        if (d[k] == 0) {
+            out[n++] = pack::skip | (r - 1);
+            k += r;
+        } else if (r >= 3) {
+            out[n++] = pack::repeat | (r - 1);
+            out[n++] = d[k];
+            k += r;
+        } else {
+            // literal up to the next unchanged byte or the next run worth a repeat token
+            uint8_t j = k;
+            while (j < pack::frame_bytes && d[j] != 0 && (j == k || run_at(j) < 3)) j++;
+            out[n++] = pack::literal | (j - k - 1);
+            for (; k < j; k++) out[n++] = d[k];
+        }
+    }
+    return n;
+}
+
+/*
+ * sequential decoder over a packed blob, keeps only the current frame
+ * seeking backwards restarts from the first frame
+ */
+class packed_anim {
+    private:
+    const uint8_t* m_blob;
+    const uint8_t* m_end;
+    const uint8_t* m_next; // packed data of frame m_idx + 1
+    uint16_t m_idx;        // frame held in m_frame, count() when none
+    uint16_t m_duration;
+    uint32_t m_frame[words];
+
+    auto rewind() -> void {
+        m_next     = m_blob + 1;
+        m_idx      = count();
+        m_duration = 0;
+        for (auto& w : m_frame) w = 0;
+    }
+
+    public:
+    packed_anim(const uint8_t* blob, size_t size) noexcept : m_blob(blob), m_end(blob + size) { rewind(); }
+
+    template <size_t N>
+    explicit packed_anim(const uint8_t (&blob)[N]) noexcept : packed_anim(blob, N) {}
+
+    auto count() const noexcept -> uint16_t { return m_end > m_blob ? m_blob[0] : 0; }
+
+    // frame idx, nullptr when out of range or malformed
+    auto seek(uint16_t idx) -> const uint32_t* {
+        if (idx >= count()) return nullptr;
+        if (m_idx == count() || idx < m_idx) rewind();
+
+        while (m_idx != idx) {
+            const uint8_t* p = unpack_frame(m_next, m_end, m_frame, &m_duration);
+            if (!p) {
+                rewind();
+                return nullptr;
+            }
+            m_next = p;
+            m_idx  = m_idx == count() ? 0 : m_idx + 1;
+        }
+        return m_frame;
+    }
+
+    // duration of the last frame returned by seek
+    auto duration() const noexcept -> uint16_t { return m_duration; }
+
+    // the returned sequence must be stored while it plays, frames with duration 0 last one tick
+    auto seq() -> sequence { return sequence{ nullptr, count(), pack::tick_ms, render, this }; }
+
+    static auto render(uint32_t* f, uint16_t idx, const void* ctx) -> uint16_t {
+        auto* self         = const_cast<packed_anim*>(static_cast<const packed_anim*>(ctx));
+        const uint32_t* fr = self->seek(idx);
+        for (int w = 0; w < words; w++) f[w] = fr ? fr[w] : 0;
+        return self->duration();
+    }
+};
+
+} // namespace led
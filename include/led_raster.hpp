@@ -0,0 +1,172 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "led_frame.hpp"
+
+namespace led {
+
+/*
+ * integer raster primitives on the 96 bit frame
+ * all coordinates are clipped, end points are inclusive and may come in any order,
+ * lines and rectangles become a few mask operations on the three words
+ */
+namespace __details {
+
+constexpr auto clamp(int v, int lo, int hi) -> int {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+// frame bits idx a .. b - 1
+constexpr auto bit_range(int a, int b) -> mask {
+    mask m{};
+    for (int w = 0; w < words; w++) {
+        int lo = a > 32 * w ? a : 32 * w;
+        int hi = b < 32 * w + 32 ? b : 32 * w + 32;
+        if (lo >= hi) continue;
+        uint32_t ones = hi - lo == 32 ? 0xFFFFFFFF : (uint32_t(1) << (hi - lo)) - 1;
+        m[w]          = ones << (32 * w + 32 - hi);
+    }
+    return m;
+}
+
+constexpr auto build_column_masks() -> std::array<mask, width> {
+    std::array<mask, width> t{};
+    for (int c = 0; c < width; c++)
+        for (int r = 0; r < height; r++) or_bit(t[c], r * width + c);
+    return t;
+}
+
+} // namespace __details
+
+// column c over all rows
+inline constexpr auto column_masks = __details::build_column_masks();
+
+inline auto pixel(uint32_t* f, int x, int y, bool on = true) -> void {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    set_bit(f, y * width + x, on);
+}
+
+inline auto hline(uint32_t* f, int x0, int x1, int y) -> void {
+    if (x0 > x1) {
+        int t = x0;
+        x0    = x1;
+        x1    = t;
+    }
+    if (y < 0 || y >= height || x1 < 0 || x0 >= width) return;
+
+    x0 = __details::clamp(x0, 0, width - 1);
+    x1 = __details::clamp(x1, 0, width - 1);
+
+    // columns x0..x1 of a 12 bit row, bit 11 is column 0
+    uint16_t bits = static_cast<uint16_t>(((1u << (x1 - x0 + 1)) - 1) << (width - 1 - x1));
+    or_row(f, y, bits);
+}
+
+inline auto vline(uint32_t* f, int x, int y0, int y1) -> void {
+    if (y0 > y1) {
+        int t = y0;
+        y0    = y1;
+        y1    = t;
+    }
+    if (x < 0 || x >= width || y1 < 0 || y0 >= height) return;
+
+    y0 = __details::clamp(y0, 0, height - 1);
+    y1 = __details::clamp(y1, 0, height - 1);
+
+    mask rows = __details::bit_range(y0 * width, (y1 + 1) * width);
+    for (int w = 0; w < words; w++) f[w] |= rows[w] & column_masks[x][w];
+}
+
+inline auto rect(uint32_t* f, int x0, int y0, int x1, int y1, bool filled = false) -> void {
+    if (x0 > x1) {
+        int t = x0;
+        x0    = x1;
+        x1    = t;
+    }
+    if (y0 > y1) {
+        int t = y0;
+        y0    = y1;
+        y1    = t;
+    }
+
+    if (filled) {
+        for (int y = y0 < 0 ? 0 : y0; y <= y1 && y < height; y++) hline(f, x0, x1, y);
+        return;
+    }
+    hline(f, x0, x1, y0);
+    hline(f, x0, x1, y1);
+    vline(f, x0, y0, y1);
+    vline(f, x1, y0, y1);
+}
+
+// value in lo..hi as 0..n lit pixels, rounded, clamped
+inline auto scale(int32_t value, int32_t lo, int32_t hi, int n) -> int {
+    if (hi <= lo) return 0;
+    if (value <= lo) return 0;
+    if (value >= hi) return n;
+    return static_cast<int>((int64_t(value - lo) * n + (hi - lo) / 2) / (hi - lo));
+}
+
+// vertical bar in column x growing up from the bottom row
+inline auto bar_v(uint32_t* f, int x, int32_t value, int32_t lo, int32_t hi) -> void {
+    int n = scale(value, lo, hi, height);
+    if (n) vline(f, x, height - n, height - 1);
+}
+
+// horizontal bar in row y growing right from column 0
+inline auto bar_h(uint32_t* f, int y, int32_t value, int32_t lo, int32_t hi) -> void {
+    int n = scale(value, lo, hi, width);
+    if (n) hline(f, 0, n - 1, y);
+}
+
+// one bar per column, values[0] in column 0, at most width values
+inline auto bar_graph(uint32_t* f, const int32_t* values, size_t n, int32_t lo, int32_t hi) -> void {
+    for (size_t i = 0; i < n && i < size_t(width); i++) bar_v(f, static_cast<int>(i), values[i], lo, hi);
+}
+
+/*
+ * scrolling strip chart, the newest sample is drawn in the rightmost column
+ * samples are stored already scaled to a row so draw() is width pixel or vline calls
+ */
+class strip_chart {
+    public:
+    enum style : uint8_t {
+        dots,
+        bars,
+    };
+
+    private:
+    int8_t m_rows[width]; // row of each column, -1 when empty
+    uint8_t m_head;       // next column slot to overwrite
+    int32_t m_lo;
+    int32_t m_hi;
+
+    public:
+    strip_chart(int32_t lo, int32_t hi) noexcept : m_head(0), m_lo(lo), m_hi(hi) { clear(); }
+
+    auto clear() -> void {
+        for (auto& r : m_rows) r = -1;
+        m_head = 0;
+    }
+
+    auto push(int32_t value) -> void {
+        // lo on the bottom row, hi on the top row
+        m_rows[m_head] = static_cast<int8_t>(height - 1 - scale(value, m_lo, m_hi, height - 1));
+        m_head         = m_head + 1 == width ? 0 : m_head + 1;
+    }
+
+    auto draw(uint32_t* f, style s = dots) const -> void {
+        uint8_t idx = m_head;
+        for (int x = 0; x < width; x++) {
+            int8_t r = m_rows[idx];
+            idx      = idx + 1 == width ? 0 : idx + 1;
+            if (r < 0) continue;
+            if (s == bars) vline(f, x, r, height - 1);
+            else pixel(f, x, r);
+        }
+    }
+};
+
+} // namespace led
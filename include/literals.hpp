@@ -1,8 +1,12 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <tuple>
+#include <type_traits>
+
+#include "fixed_point.hpp"
 
 namespace literals {
 /*
@@ -10,16 +14,81 @@ namespace literals {
  * M := mass
  * L := length
  * T := time
+ * Rep := storage of the value, double by default, float or fxp::fixed<>
+ *        keep the arithmetic on the single precision FPU or in integers
  * Example:
  * <0, 0, 1> = s
  * <0, 1, -1> = m/s
+ * <0, 1, -1, float> = m/s in a float
  */
-template <int M, int L, int T>
+template <int M, int L, int T, typename Rep = double>
 struct Quantity {
-    double v;
+    using rep = Rep;
+    Rep v;
     static constexpr std::tuple<int, int, int> dim() { return std::make_tuple(M, L, T); }
-    explicit constexpr Quantity(double v) : v(v) {}
+    template <typename A, typename = std::enable_if_t<std::is_arithmetic<A>::value || std::is_same<A, Rep>::value>>
+    explicit constexpr Quantity(A v) : v(static_cast<Rep>(v)) {}
+    // change of representation, see also quantity_cast
+    template <typename R>
+    explicit constexpr Quantity(Quantity<M, L, T, R> q);
+};
+
+namespace __details {
+
+template <typename To, typename From>
+constexpr auto rep_cast(From v) -> To {
+    if constexpr (std::is_same<To, From>::value) {
+        return v;
+    } else if constexpr (fxp::is_fixed<To>::value && fxp::is_fixed<From>::value) {
+        constexpr int shift = To::frac_bits - From::frac_bits;
+        typename To::wide_t raw = v.raw;
+        if constexpr (shift >= 0) return To::from_raw(raw * (typename To::wide_t(1) << shift));
+        else return To::from_raw(raw >> -shift);
+    } else {
+        return static_cast<To>(v);
+    }
+}
+
+/*
+ * representation of the result of a mixed operation, picked at compile time
+ * two arithmetic types follow the usual promotion (float op double = double)
+ * fixed with floating point gives the floating point type, fixed with an
+ * integer stays fixed, two different fixed formats need an explicit cast
+ */
+template <typename A, typename B, bool = std::is_arithmetic<A>::value, bool = std::is_arithmetic<B>::value>
+struct common_rep {};
+template <typename A, typename B>
+struct common_rep<A, B, true, true> {
+    using type = std::common_type_t<A, B>;
+};
+template <typename A, typename B>
+struct common_rep<A, B, false, true> {
+    using type = std::conditional_t<std::is_floating_point<B>::value, B, A>;
 };
+template <typename A, typename B>
+struct common_rep<A, B, true, false> : common_rep<B, A> {};
+template <typename A>
+struct common_rep<A, A, false, false> {
+    using type = A;
+};
+
+// a plain number next to a quantity is converted to the quantity's rep
+template <typename S, typename Rep>
+using scalar_t = std::enable_if_t<std::is_arithmetic<S>::value || std::is_same<S, Rep>::value, Rep>;
+
+} // namespace __details
+
+template <typename A, typename B>
+using common_rep_t = typename __details::common_rep<A, B>::type;
+
+template <int M, int L, int T, typename Rep>
+template <typename R>
+constexpr Quantity<M, L, T, Rep>::Quantity(Quantity<M, L, T, R> q) : v(__details::rep_cast<Rep>(q.v)) {}
+
+template <typename To, int M, int L, int T, typename Rep>
+constexpr auto quantity_cast(Quantity<M, L, T, Rep> q) -> Quantity<M, L, T, To> {
+    return Quantity<M, L, T, To>(q);
+}
 
 using dim_less = Quantity<0, 0, 0>;
 
@@ -38,120 +107,319 @@ using pwr_t = Quantity<1, 2, -3>; // kg*m^2/s^3 (Watt)
 using frq_t = Quantity<0, 0, -1>; // 1/s (Hz)
 
 /// * /
-template <int M1, int L1, int T1, int M2, int L2, int T2>
-constexpr auto operator*(Quantity<M1, L1, T1> lhs, Quantity<M2, L2, T2> rhs) -> Quantity<M1 + M2, L1 + L2, T1 + T2> {
-    return Quantity<M1 + M2, L1 + L2, T1 + T2>(lhs.v * rhs.v);
+template <int M1, int L1, int T1, typename R1, int M2, int L2, int T2, typename R2>
+constexpr auto operator*(Quantity<M1, L1, T1, R1> lhs, Quantity<M2, L2, T2, R2> rhs)
+    -> Quantity<M1 + M2, L1 + L2, T1 + T2, common_rep_t<R1, R2>> {
+    using R = common_rep_t<R1, R2>;
+    return Quantity<M1 + M2, L1 + L2, T1 + T2, R>(__details::rep_cast<R>(lhs.v) * __details::rep_cast<R>(rhs.v));
 }
-template <int M1, int L1, int T1, int M2, int L2, int T2>
-constexpr auto operator/(Quantity<M1, L1, T1> lhs, Quantity<M2, L2, T2> rhs) -> Quantity<M1 - M2, L1 - L2, T1 - T2> {
-    return Quantity<M1 - M2, L1 - L2, T1 - T2>(lhs.v / rhs.v);
+template <int M1, int L1, int T1, typename R1, int M2, int L2, int T2, typename R2>
+constexpr auto operator/(Quantity<M1, L1, T1, R1> lhs, Quantity<M2, L2, T2, R2> rhs)
+    -> Quantity<M1 - M2, L1 - L2, T1 - T2, common_rep_t<R1, R2>> {
+    using R = common_rep_t<R1, R2>;
+    return Quantity<M1 - M2, L1 - L2, T1 - T2, R>(__details::rep_cast<R>(lhs.v) / __details::rep_cast<R>(rhs.v));
 }
 
 /// + -
-template <int M, int L, int T>
-constexpr auto operator+(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> Quantity<M, L, T> {
-    return Quantity<M, L, T>(lhs.v + rhs.v);
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator+(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> Quantity<M, L, T, common_rep_t<R1, R2>> {
+    using R = common_rep_t<R1, R2>;
+    return Quantity<M, L, T, R>(__details::rep_cast<R>(lhs.v) + __details::rep_cast<R>(rhs.v));
 }
-template <int M, int L, int T>
-constexpr auto operator-(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> Quantity<M, L, T> {
-    return Quantity<M, L, T>(lhs.v - rhs.v);
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator-(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> Quantity<M, L, T, common_rep_t<R1, R2>> {
+    using R = common_rep_t<R1, R2>;
+    return Quantity<M, L, T, R>(__details::rep_cast<R>(lhs.v) - __details::rep_cast<R>(rhs.v));
 }
 
-/// * / scalar
-template <int M, int L, int T>
-constexpr auto operator*(Quantity<M, L, T> lhs, double rhs) -> Quantity<M, L, T> {
-    return Quantity<M, L, T>(lhs.v * rhs);
+/// * / scalar, the quantity keeps its rep
+template <int M, int L, int T, typename R, typename S>
+constexpr auto operator*(Quantity<M, L, T, R> lhs, S rhs) -> Quantity<M, L, T, __details::scalar_t<S, R>> {
+    return Quantity<M, L, T, R>(lhs.v * static_cast<R>(rhs));
 }
-template <int M, int L, int T>
-constexpr auto operator/(Quantity<M, L, T> lhs, double rhs) -> Quantity<M, L, T> {
-    return Quantity<M, L, T>(lhs.v / rhs);
+template <int M, int L, int T, typename R, typename S>
+constexpr auto operator/(Quantity<M, L, T, R> lhs, S rhs) -> Quantity<M, L, T, __details::scalar_t<S, R>> {
+    return Quantity<M, L, T, R>(lhs.v / static_cast<R>(rhs));
 }
 
-template <int M, int L, int T>
-constexpr auto operator*(double lhs, Quantity<M, L, T> rhs) -> Quantity<M, L, T> {
-    return Quantity<M, L, T>(lhs * rhs.v);
+template <int M, int L, int T, typename R, typename S>
+constexpr auto operator*(S lhs, Quantity<M, L, T, R> rhs) -> Quantity<M, L, T, __details::scalar_t<S, R>> {
+    return Quantity<M, L, T, R>(static_cast<R>(lhs) * rhs.v);
 }
-template <int M, int L, int T>
-constexpr auto operator/(double lhs, Quantity<M, L, T> rhs) -> Quantity<M, L, T> {
-    return Quantity<M, L, T>(lhs / rhs.v);
+template <int M, int L, int T, typename R, typename S>
+constexpr auto operator/(S lhs, Quantity<M, L, T, R> rhs) -> Quantity<M, L, T, __details::scalar_t<S, R>> {
+    return Quantity<M, L, T, R>(static_cast<R>(lhs) / rhs.v);
 }
 
 // compare
-template <int M, int L, int T>
-constexpr auto operator==(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> bool {
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator==(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> bool {
+    using R = common_rep_t<R1, R2>;
+    return __details::rep_cast<R>(lhs.v) == __details::rep_cast<R>(rhs.v);
+}
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator!=(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> bool {
+    using R = common_rep_t<R1, R2>;
+    return __details::rep_cast<R>(lhs.v) != __details::rep_cast<R>(rhs.v);
+}
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator<(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> bool {
+    using R = common_rep_t<R1, R2>;
+    return __details::rep_cast<R>(lhs.v) < __details::rep_cast<R>(rhs.v);
+}
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator>(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> bool {
+    using R = common_rep_t<R1, R2>;
+    return __details::rep_cast<R>(lhs.v) > __details::rep_cast<R>(rhs.v);
+}
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator<=(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> bool {
+    using R = common_rep_t<R1, R2>;
+    return __details::rep_cast<R>(lhs.v) <= __details::rep_cast<R>(rhs.v);
+}
+template <int M, int L, int T, typename R1, typename R2>
+constexpr auto operator>=(Quantity<M, L, T, R1> lhs, Quantity<M, L, T, R2> rhs) -> bool {
+    using R = common_rep_t<R1, R2>;
+    return __details::rep_cast<R>(lhs.v) >= __details::rep_cast<R>(rhs.v);
+}
+
+/*
+ * integer time for the hot path, Rate ticks per second on a free running
+ * 32 bit counter such as micros() or the DWT cycle counter
+ * tick_point := one reading of the counter, wraps
+ * tick_dura  := signed distance between two readings, exact across the wrap
+ *               while they are less than half the counter range apart
+ *               (about 35 min for micros())
+ * dura_t only at the edges: to_dura(), or a tick_dura built from a dura_t
+ * constant at compile time, e.g. constexpr dura_us_t period(5ms)
+ */
+template <uint32_t Rate>
+struct tick_dura {
+    int32_t v;
+    static constexpr uint32_t rate = Rate;
+    constexpr tick_dura() : v(0) {}
+    explicit constexpr tick_dura(int32_t v) : v(v) {}
+    // rounded to the nearest tick
+    template <typename R>
+    explicit constexpr tick_dura(Quantity<0, 0, 1, R> d)
+    : v(static_cast<int32_t>(static_cast<double>(d.v) * Rate + (static_cast<double>(d.v) < 0 ? -0.5 : 0.5))) {}
+
+    constexpr auto to_dura() const -> dura_t { return dura_t(static_cast<double>(v) / Rate); }
+    // seconds in single precision without a double conversion
+    constexpr auto seconds() const -> float { return static_cast<float>(v) * (1.0f / Rate); }
+
+    constexpr auto operator+=(tick_dura rhs) -> tick_dura& { return v += rhs.v, *this; }
+    constexpr auto operator-=(tick_dura rhs) -> tick_dura& { return v -= rhs.v, *this; }
+};
+
+template <uint32_t Rate>
+struct tick_point {
+    uint32_t v;
+    static constexpr uint32_t rate = Rate;
+    constexpr tick_point() : v(0) {}
+    explicit constexpr tick_point(uint32_t v) : v(v) {}
+
+    constexpr auto operator+=(tick_dura<Rate> rhs) -> tick_point& { return v += static_cast<uint32_t>(rhs.v), *this; }
+    constexpr auto operator-=(tick_dura<Rate> rhs) -> tick_point& { return v -= static_cast<uint32_t>(rhs.v), *this; }
+};
+
+using dura_us_t = tick_dura<1000000>;
+using time_us_t = tick_point<1000000>;
+#ifdef F_CPU
+using dura_cyc_t = tick_dura<F_CPU>;
+using time_cyc_t = tick_point<F_CPU>;
+#endif
+
+/// tick_dura
+template <uint32_t R>
+constexpr auto operator+(tick_dura<R> lhs, tick_dura<R> rhs) -> tick_dura<R> {
+    return tick_dura<R>(lhs.v + rhs.v);
+}
+template <uint32_t R>
+constexpr auto operator-(tick_dura<R> lhs, tick_dura<R> rhs) -> tick_dura<R> {
+    return tick_dura<R>(lhs.v - rhs.v);
+}
+template <uint32_t R>
+constexpr auto operator-(tick_dura<R> d) -> tick_dura<R> {
+    return tick_dura<R>(-d.v);
+}
+template <uint32_t R>
+constexpr auto operator*(tick_dura<R> lhs, int32_t rhs) -> tick_dura<R> {
+    return tick_dura<R>(lhs.v * rhs);
+}
+template <uint32_t R>
+constexpr auto operator*(int32_t lhs, tick_dura<R> rhs) -> tick_dura<R> {
+    return tick_dura<R>(lhs * rhs.v);
+}
+template <uint32_t R>
+constexpr auto operator/(tick_dura<R> lhs, int32_t rhs) -> tick_dura<R> {
+    return tick_dura<R>(lhs.v / rhs);
+}
+template <uint32_t R>
+constexpr auto operator/(tick_dura<R> lhs, tick_dura<R> rhs) -> int32_t {
+    return lhs.v / rhs.v;
+}
+
+template <uint32_t R>
+constexpr auto operator==(tick_dura<R> lhs, tick_dura<R> rhs) -> bool {
     return lhs.v == rhs.v;
 }
-template <int M, int L, int T>
-constexpr auto operator!=(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> bool {
+template <uint32_t R>
+constexpr auto operator!=(tick_dura<R> lhs, tick_dura<R> rhs) -> bool {
     return lhs.v != rhs.v;
 }
-template <int M, int L, int T>
-constexpr auto operator<(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> bool {
+template <uint32_t R>
+constexpr auto operator<(tick_dura<R> lhs, tick_dura<R> rhs) -> bool {
     return lhs.v < rhs.v;
 }
-template <int M, int L, int T>
-constexpr auto operator>(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> bool {
+template <uint32_t R>
+constexpr auto operator>(tick_dura<R> lhs, tick_dura<R> rhs) -> bool {
     return lhs.v > rhs.v;
 }
-template <int M, int L, int T>
-constexpr auto operator<=(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> bool {
+template <uint32_t R>
+constexpr auto operator<=(tick_dura<R> lhs, tick_dura<R> rhs) -> bool {
     return lhs.v <= rhs.v;
 }
-template <int M, int L, int T>
-constexpr auto operator>=(Quantity<M, L, T> lhs, Quantity<M, L, T> rhs) -> bool {
+template <uint32_t R>
+constexpr auto operator>=(tick_dura<R> lhs, tick_dura<R> rhs) -> bool {
     return lhs.v >= rhs.v;
 }
 
-/// time
-constexpr auto operator"" s(long double value) -> dura_t { return dura_t(static_cast<double>(value)); }
-constexpr auto operator"" ms(long double value) -> dura_t { return dura_t(static_cast<double>(value) / 1000.); }
-constexpr auto operator"" us(long double value) -> dura_t { return dura_t(static_cast<double>(value)) / 1000000.; }
-constexpr auto operator"" s(unsigned long long value) -> dura_t { return dura_t(static_cast<double>(value)); }
-constexpr auto operator"" ms(unsigned long long value) -> dura_t { return dura_t(static_cast<double>(value) / 1000.); }
-constexpr auto operator"" us(unsigned long long value) -> dura_t { return dura_t(static_cast<double>(value)) / 1000000.; }
-
-/// mass
-constexpr auto operator"" kg(long double value) -> mass_t { return mass_t(static_cast<double>(value)); }
-constexpr auto operator"" g(long double value) -> mass_t { return mass_t(static_cast<double>(value) / 1000.); }
-constexpr auto operator"" kg(unsigned long long value) -> mass_t { return mass_t(static_cast<double>(value)); }
-constexpr auto operator"" g(unsigned long long value) -> mass_t { return mass_t(static_cast<double>(value) / 1000.); }
-
-/// distance
-constexpr auto operator"" km(long double value) -> leng_t { return leng_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" m(long double value) -> leng_t { return leng_t(static_cast<double>(value)); }
-constexpr auto operator"" mm(long double value) -> leng_t { return leng_t(static_cast<double>(value)) / 1000; }
-constexpr auto operator"" km(unsigned long long value) -> leng_t { return leng_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" m(unsigned long long value) -> leng_t { return leng_t(static_cast<double>(value)); }
-constexpr auto operator"" mm(unsigned long long value) -> leng_t { return leng_t(static_cast<double>(value)) / 1000; }
-
-/// Newton
-constexpr auto operator"" kN(long double value) -> frc_t { return frc_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" N(long double value) -> frc_t { return frc_t(static_cast<double>(value)); }
-constexpr auto operator"" mN(long double value) -> frc_t { return frc_t(static_cast<double>(value)) / 1000; }
-
-constexpr auto operator"" kN(unsigned long long value) -> frc_t { return frc_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" N(unsigned long long value) -> frc_t { return frc_t(static_cast<double>(value)); }
-constexpr auto operator"" mN(unsigned long long value) -> frc_t { return frc_t(static_cast<double>(value)) / 1000; }
-
-/// eng_t
-constexpr auto operator"" kJ(long double value) -> eng_t { return eng_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" J(long double value) -> eng_t { return eng_t(static_cast<double>(value)); }
-constexpr auto operator"" mJ(long double value) -> eng_t { return eng_t(static_cast<double>(value)) / 1000; }
-constexpr auto operator"" kJ(unsigned long long value) -> eng_t { return eng_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" J(unsigned long long value) -> eng_t { return eng_t(static_cast<double>(value)); }
-constexpr auto operator"" mJ(unsigned long long value) -> eng_t { return eng_t(static_cast<double>(value)) / 1000; }
-
-/// pwr_t
-constexpr auto operator"" kW(long double value) -> pwr_t { return pwr_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" W(long double value) -> pwr_t { return pwr_t(static_cast<double>(value)); }
-constexpr auto operator"" mW(long double value) -> pwr_t { return pwr_t(static_cast<double>(value)) / 1000; }
-constexpr auto operator"" kW(unsigned long long value) -> pwr_t { return pwr_t(static_cast<double>(value)) * 1000; }
-constexpr auto operator"" W(unsigned long long value) -> pwr_t { return pwr_t(static_cast<double>(value)); }
-constexpr auto operator"" mW(unsigned long long value) -> pwr_t { return pwr_t(static_cast<double>(value)) / 1000; }
-
-/// frq_t
-constexpr auto operator"" Hz(long double value) -> frq_t { return frq_t(static_cast<double>(value)); }
-constexpr auto operator"" Hz(unsigned long long value) -> frq_t { return frq_t(static_cast<double>(value)); }
+/// tick_point, the difference is taken modulo 2^32 and read as signed
+template <uint32_t R>
+constexpr auto operator-(tick_point<R> lhs, tick_point<R> rhs) -> tick_dura<R> {
+    return tick_dura<R>(static_cast<int32_t>(lhs.v - rhs.v));
+}
+template <uint32_t R>
+constexpr auto operator+(tick_point<R> lhs, tick_dura<R> rhs) -> tick_point<R> {
+    return tick_point<R>(lhs.v + static_cast<uint32_t>(rhs.v));
+}
+template <uint32_t R>
+constexpr auto operator+(tick_dura<R> lhs, tick_point<R> rhs) -> tick_point<R> {
+    return rhs + lhs;
+}
+template <uint32_t R>
+constexpr auto operator-(tick_point<R> lhs, tick_dura<R> rhs) -> tick_point<R> {
+    return tick_point<R>(lhs.v - static_cast<uint32_t>(rhs.v));
+}
+
+// ordering through the signed difference, only meaningful within half the range
+template <uint32_t R>
+constexpr auto operator==(tick_point<R> lhs, tick_point<R> rhs) -> bool {
+    return lhs.v == rhs.v;
+}
+template <uint32_t R>
+constexpr auto operator!=(tick_point<R> lhs, tick_point<R> rhs) -> bool {
+    return lhs.v != rhs.v;
+}
+template <uint32_t R>
+constexpr auto operator<(tick_point<R> lhs, tick_point<R> rhs) -> bool {
+    return (lhs - rhs).v < 0;
+}
+template <uint32_t R>
+constexpr auto operator>(tick_point<R> lhs, tick_point<R> rhs) -> bool {
+    return (lhs - rhs).v > 0;
+}
+template <uint32_t R>
+constexpr auto operator<=(tick_point<R> lhs, tick_point<R> rhs) -> bool {
+    return (lhs - rhs).v <= 0;
+}
+template <uint32_t R>
+constexpr auto operator>=(tick_point<R> lhs, tick_point<R> rhs) -> bool {
+    return (lhs - rhs).v >= 0;
+}
+
+/*
+ * the same suffixes in every representation, the literal namespace picks it
+ * using namespace literals      -> double
+ * using namespace literals::f32 -> float
+ * using namespace literals::q16 -> fxp::q16_16
+ * the value is scaled in double and converted once, at compile time for
+ * constants, bring only one of them into a scope or the suffixes are ambiguous
+ * using-directives accumulate across scopes: a file scope `using namespace
+ * literals;` and a block scope `using namespace literals::f32;` make every
+ * suffix ambiguous in the block, switch single suffixes there with
+ * using-declarations instead, e.g. using literals::f32::operator""m;
+ */
+#define LITERALS_UNIT(suffix, type, num, den)                                                                         \
+    constexpr auto operator"" suffix(long double value) -> type { return type(static_cast<double>(value) * num / den); } \
+    constexpr auto operator"" suffix(unsigned long long value) -> type { return type(static_cast<double>(value) * num / den); }
+
+#define LITERALS_UNITS()                  \
+    /* time */                            \
+    LITERALS_UNIT(s, dura_t, 1., 1.)      \
+    LITERALS_UNIT(ms, dura_t, 1., 1000.)  \
+    LITERALS_UNIT(us, dura_t, 1., 1e6)    \
+    /* mass */                            \
+    LITERALS_UNIT(kg, mass_t, 1., 1.)     \
+    LITERALS_UNIT(g, mass_t, 1., 1000.)   \
+    /* distance */                        \
+    LITERALS_UNIT(km, leng_t, 1000., 1.)  \
+    LITERALS_UNIT(m, leng_t, 1., 1.)      \
+    LITERALS_UNIT(mm, leng_t, 1., 1000.)  \
+    /* Newton */                          \
+    LITERALS_UNIT(kN, frc_t, 1000., 1.)   \
+    LITERALS_UNIT(N, frc_t, 1., 1.)       \
+    LITERALS_UNIT(mN, frc_t, 1., 1000.)   \
+    /* eng_t */                           \
+    LITERALS_UNIT(kJ, eng_t, 1000., 1.)   \
+    LITERALS_UNIT(J, eng_t, 1., 1.)       \
+    LITERALS_UNIT(mJ, eng_t, 1., 1000.)   \
+    /* pwr_t */                           \
+    LITERALS_UNIT(kW, pwr_t, 1000., 1.)   \
+    LITERALS_UNIT(W, pwr_t, 1., 1.)       \
+    LITERALS_UNIT(mW, pwr_t, 1., 1000.)   \
+    /* frq_t */                           \
+    LITERALS_UNIT(Hz, frq_t, 1., 1.)
+
+// no leading '_' on the unit suffixes, silenced once for all three namespaces
+// with GNU extensions (gnu++17) 1J and 1.0W stay the builtin imaginary and
+// __float80 literals, the firmware builds with -std=c++17
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wliteral-suffix"
+
+LITERALS_UNITS()
+
+namespace f32 {
+
+using dim_less = Quantity<0, 0, 0, float>;
+using mass_t   = Quantity<1, 0, 0, float>;
+using leng_t   = Quantity<0, 1, 0, float>;
+using dura_t   = Quantity<0, 0, 1, float>;
+using val_t    = Quantity<0, 1, -1, float>;
+using acc_t    = Quantity<0, 1, -2, float>;
+using jrk_t    = Quantity<0, 1, -3, float>;
+using frc_t    = Quantity<1, 1, -2, float>;
+using eng_t    = Quantity<1, 2, -2, float>;
+using pwr_t    = Quantity<1, 2, -3, float>;
+using frq_t    = Quantity<0, 0, -1, float>;
+
+LITERALS_UNITS()
+
+} // namespace f32
+
+// Q16.16: lsb 15 us, 15 um, range +-32768, products of small units lose precision
+namespace q16 {
+
+using dim_less = Quantity<0, 0, 0, fxp::q16_16>;
+using mass_t   = Quantity<1, 0, 0, fxp::q16_16>;
+using leng_t   = Quantity<0, 1, 0, fxp::q16_16>;
+using dura_t   = Quantity<0, 0, 1, fxp::q16_16>;
+using val_t    = Quantity<0, 1, -1, fxp::q16_16>;
+using acc_t    = Quantity<0, 1, -2, fxp::q16_16>;
+using jrk_t    = Quantity<0, 1, -3, fxp::q16_16>;
+using frc_t    = Quantity<1, 1, -2, fxp::q16_16>;
+using eng_t    = Quantity<1, 2, -2, fxp::q16_16>;
+using pwr_t    = Quantity<1, 2, -3, fxp::q16_16>;
+using frq_t    = Quantity<0, 0, -1, fxp::q16_16>;
+
+LITERALS_UNITS()
+
+} // namespace q16
+
+#pragma GCC diagnostic pop
 
+#undef LITERALS_UNITS
+#undef LITERALS_UNIT
 
 } // namespace literals
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace logging {
+
+// subsystems that can be filtered separately, used as LOGM_INFO(imu, ...)
+enum module : uint8_t {
+    core,
+    input,
+    imu,
+    display,
+    pixel,
+    module_count,
+};
+
+// runtime minimum level per module, checked before any argument is touched
+class level_table {
+    private:
+    uint8_t m_levels[module_count];
+
+    public:
+    explicit level_table(uint8_t level) noexcept { set_all(level); }
+
+    inline auto enabled(uint8_t mod, uint8_t level) const -> bool { return level >= m_levels[mod]; }
+
+    auto get(uint8_t mod) const -> uint8_t { return m_levels[mod]; }
+
+    auto set(uint8_t mod, uint8_t level) -> void {
+        if (mod < module_count) m_levels[mod] = level;
+    }
+
+    auto set_all(uint8_t level) -> void {
+        for (auto& l : m_levels) l = level;
+    }
+};
+
+// passes the first call and then at most once per period, one compare when suppressed
+class every_ms {
+    private:
+    uint32_t m_period;
+    uint32_t m_last;
+
+    public:
+    // m_last starts one period in the past so the first call passes at any time
+    // except the last period before the 32 bit clock wraps
+    constexpr explicit every_ms(uint32_t period) noexcept : m_period(period), m_last(0u - period) {}
+
+    // wraparound safe
+    inline auto ready(uint32_t now) -> bool {
+        if (now - m_last < m_period) return false;
+        m_last = now;
+        return true;
+    }
+};
+
+// passes the first call and then every n-th call, one compare when suppressed
+class every_n {
+    private:
+    uint32_t m_left;
+
+    public:
+    constexpr every_n() noexcept : m_left(0) {}
+
+    inline auto ready(uint32_t n) -> bool {
+        if (m_left) {
+            m_left--;
+            return false;
+        }
+        m_left = n ? n - 1 : 0;
+        return true;
+    }
+};
+
+} // namespace logging
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+namespace logging {
+
+// literal text between two "{}" placeholders
+struct segment {
+    uint16_t off;
+    uint16_t len;
+};
+
+/*
+ * a format string split at compile time
+ * argc placeholders always give argc + 1 segments, some of them may be empty
+ */
+struct format_info {
+    const char* str;
+    uint8_t argc;
+    const segment* segs;
+};
+
+constexpr auto count_placeholders(const char* s) -> size_t {
+    size_t n = 0;
+    for (; *s; s++) {
+        if (*s == '{' && *(s + 1) == '}') {
+            n++;
+            s++;
+        }
+    }
+    return n;
+}
+
+template <size_t N>
+constexpr auto split_format(const char* s) -> std::array<segment, N> {
+    std::array<segment, N> segs{};
+    size_t seg   = 0;
+    uint16_t pos = 0;
+    uint16_t off = 0;
+    for (; s[pos]; pos++) {
+        if (s[pos] == '{' && s[pos + 1] == '}') {
+            segs[seg++] = segment{ off, static_cast<uint16_t>(pos - off) };
+            pos++;
+            off = pos + 1;
+        }
+    }
+    segs[seg] = segment{ off, static_cast<uint16_t>(pos - off) };
+    return segs;
+}
+
+/*
+ * S := type with static constexpr str() returning the format literal,
+ *      produced by LOG_COMPILE_FORMAT
+ */
+template <typename S>
+struct compiled_format {
+    static constexpr const char* str = S::str();
+    static constexpr size_t argc     = count_placeholders(str);
+
+    static_assert(argc < 256, "too many placeholders");
+
+    static constexpr std::array<segment, argc + 1> segs = split_format<argc + 1>(str);
+    static constexpr format_info info{ str, static_cast<uint8_t>(argc), segs.data() };
+};
+
+template <typename S>
+constexpr auto info_of(compiled_format<S>) -> const format_info* {
+    return &compiled_format<S>::info;
+}
+
+} // namespace logging
+
+// wrap a string literal into a unique type so it can be parsed at compile time
+#define LOG_COMPILE_FORMAT(format)                                             \
+    ([] {                                                                      \
+        struct _log_format {                                                   \
+            static constexpr const char* str() { return format; }              \
+        };                                                                     \
+        return ::logging::compiled_format<_log_format>{};                      \
+    }())
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+#include "log_format.hpp"
+#include "spsc_queue.hpp"
+
+class __FlashStringHelper;
+
+namespace logging {
+
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 32
+#endif
+
+enum class arg_type : uint8_t {
+    none,
+    i32,
+    u32,
+    i64,
+    u64,
+    f32,
+    f64,
+    chr,
+    boolean,
+    str, // pointer only, the string must outlive the drain (literals, F() strings)
+};
+
+/*
+ * one deferred log call, formatting happens when the record is drained
+ * arguments are stored as raw bytes with a type tag each
+ */
+struct record {
+    static constexpr uint8_t max_args    = 6;
+    static constexpr uint8_t max_payload = 32;
+
+    const format_info* format;
+    const char* file;
+    uint32_t timestamp_us;
+    uint16_t line;
+    uint8_t level;
+    uint8_t argc;
+    arg_type types[max_args];
+    uint8_t size;
+    uint8_t data[max_payload];
+};
+
+template <typename T>
+constexpr auto type_of() -> arg_type {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same<U, bool>::value) return arg_type::boolean;
+    else if constexpr (std::is_same<U, char>::value) return arg_type::chr;
+    else if constexpr (std::is_same<U, float>::value) return arg_type::f32;
+    else if constexpr (std::is_floating_point<U>::value) return arg_type::f64;
+    else if constexpr (std::is_enum<U>::value) return type_of<std::underlying_type_t<U>>();
+    else if constexpr (std::is_integral<U>::value) {
+        constexpr bool wide = sizeof(U) > 4;
+        if constexpr (std::is_signed<U>::value) return wide ? arg_type::i64 : arg_type::i32;
+        else return wide ? arg_type::u64 : arg_type::u32;
+    } else if constexpr (std::is_same<U, const char*>::value || std::is_same<U, char*>::value ||
+                         std::is_same<U, const __FlashStringHelper*>::value) {
+        return arg_type::str;
+    } else {
+        static_assert(sizeof(U) == 0, "unsupported deferred log argument type");
+        return arg_type::none;
+    }
+}
+
+constexpr auto size_of(arg_type t) -> uint8_t {
+    switch (t) {
+    case arg_type::i64:
+    case arg_type::u64:
+    case arg_type::f64: return 8;
+    case arg_type::chr:
+    case arg_type::boolean: return 1;
+    case arg_type::str: return sizeof(const char*);
+    case arg_type::none: return 0;
+    default: return 4;
+    }
+}
+
+// payload bytes of a call with these argument types, checked at compile time by the logger
+template <typename... Args>
+constexpr auto payload_of() -> size_t {
+    return (size_t(0) + ... + size_of(type_of<Args>()));
+}
+
+// false once the record is full, the argument is then not stored
+template <typename T>
+inline auto encode_one(record& r, T value) -> bool {
+    constexpr arg_type t = type_of<T>();
+    constexpr uint8_t n  = size_of(t);
+
+    if (r.argc >= record::max_args || r.size + n > record::max_payload) return false;
+
+    r.types[r.argc++] = t;
+    if constexpr (t == arg_type::i32) {
+        int32_t v = static_cast<int32_t>(value);
+        memcpy(r.data + r.size, &v, n);
+    } else if constexpr (t == arg_type::i64) {
+        int64_t v = static_cast<int64_t>(value);
+        memcpy(r.data + r.size, &v, n);
+    } else if constexpr (t == arg_type::u64) {
+        uint64_t v = static_cast<uint64_t>(value);
+        memcpy(r.data + r.size, &v, n);
+    } else if constexpr (t == arg_type::u32) {
+        uint32_t v = static_cast<uint32_t>(value);
+        memcpy(r.data + r.size, &v, n);
+    } else if constexpr (t == arg_type::str) {
+        const char* v = reinterpret_cast<const char*>(value);
+        memcpy(r.data + r.size, &v, n);
+    } else {
+        memcpy(r.data + r.size, &value, n);
+    }
+    r.size += n;
+    return true;
+}
+
+template <typename... Args>
+inline auto encode(record& r, const char* file, uint16_t line, uint8_t level, uint32_t timestamp_us,
+                   const format_info* format, Args... args) -> void {
+    r.format       = format;
+    r.file         = file;
+    r.timestamp_us = timestamp_us;
+    r.line         = line;
+    r.level        = level;
+    r.argc         = 0;
+    r.size         = 0;
+    // stop at the first argument that does not fit, the remaining placeholders all print {?}
+    (encode_one(r, args) && ...);
+}
+
+template <typename Out>
+auto print_arg(Out& out, arg_type type, const uint8_t* p) -> void {
+    switch (type) {
+    case arg_type::i32: {
+        int32_t v;
+        memcpy(&v, p, 4);
+        out.print(static_cast<long>(v));
+        break;
+    }
+    case arg_type::u32: {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        out.print(static_cast<unsigned long>(v));
+        break;
+    }
+    case arg_type::i64: {
+        int64_t v;
+        memcpy(&v, p, 8);
+        out.print(static_cast<long long>(v));
+        break;
+    }
+    case arg_type::u64: {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        out.print(static_cast<unsigned long long>(v));
+        break;
+    }
+    case arg_type::f32: {
+        float v;
+        memcpy(&v, p, 4);
+        out.print(static_cast<double>(v));
+        break;
+    }
+    case arg_type::f64: {
+        double v;
+        memcpy(&v, p, 8);
+        out.print(v);
+        break;
+    }
+    case arg_type::chr: out.print(static_cast<char>(*p)); break;
+    case arg_type::boolean: out.print(static_cast<int>(*p)); break;
+    case arg_type::str: {
+        const char* v;
+        memcpy(&v, p, sizeof(v));
+        out.print(v);
+        break;
+    }
+    default: break;
+    }
+}
+
+/*
+ * expand a record against its pre-split format, one write() per literal segment
+ * Out := Arduino Print or anything with write(const char*, size_t) and print() overloads
+ * arguments that did not fit in the record are printed as "{?}"
+ */
+template <typename Out>
+auto format_record(Out& out, const record& r) -> void {
+    const format_info& f = *r.format;
+    uint8_t off          = 0;
+
+    for (uint8_t i = 0; i < f.argc; i++) {
+        if (f.segs[i].len) out.write(f.str + f.segs[i].off, f.segs[i].len);
+
+        if (i < r.argc) {
+            print_arg(out, r.types[i], r.data + off);
+            off += size_of(r.types[i]);
+        } else {
+            out.print("{?}");
+        }
+    }
+    if (f.segs[f.argc].len) out.write(f.str + f.segs[f.argc].off, f.segs[f.argc].len);
+}
+
+/*
+ * lock-free single-producer / single-consumer ring of records
+ * the producer fills a slot in place (reserve / commit), nothing blocks,
+ * a full ring drops the record and counts it
+ */
+template <size_t Capacity = LOG_RING_SIZE>
+class record_ring {
+    private:
+    spsc::queue<record, Capacity> m_queue;
+    std::atomic<uint32_t> m_dropped;
+
+    public:
+    record_ring() noexcept : m_dropped(0) {}
+
+    static constexpr auto capacity() noexcept -> size_t { return Capacity; }
+
+    // slot to fill, nullptr when full
+    auto reserve() -> record* {
+        record* r = m_queue.reserve();
+        if (!r) m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return r;
+    }
+
+    auto commit() -> void { m_queue.commit(); }
+
+    // oldest record, nullptr when empty
+    auto front() -> const record* { return m_queue.front(); }
+    auto pop() -> void { m_queue.pop(); }
+
+    auto size() const -> size_t { return m_queue.size(); }
+
+    auto dropped() const -> uint32_t { return m_dropped.load(std::memory_order_relaxed); }
+    auto take_dropped() -> uint32_t { return m_dropped.exchange(0, std::memory_order_relaxed); }
+};
+
+} // namespace logging
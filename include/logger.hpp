@@ -1,7 +1,9 @@
 // logger.h
 #pragma once
 
-#include <Arduino.h>
+#include "log_filter.hpp"
+#include "log_record.hpp"
+#include "profiler.hpp"
 
 #define LOG_LEVEL_TRACE 0
 #define LOG_LEVEL_DEBUG 1
@@ -11,48 +13,56 @@
 #define LOG_LEVEL_FATAL 5
 #define LOG_LEVEL_OFF 6
 
+// compile-time floor, calls below it are removed entirely
 #ifndef LOG_LEVEL
-#define LOG_LEVEL LOG_LEVEL_DEBUG
+#define LOG_LEVEL LOG_LEVEL_TRACE
+#endif
+
+// initial runtime level of every module, can be changed with setLevel()
+#ifndef LOG_RUNTIME_LEVEL
+#define LOG_RUNTIME_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// module used by the plain LOG_X macros, define it before the include to tag a whole file
+#ifndef LOG_MODULE
+#define LOG_MODULE ::logging::core
 #endif
 
+// without ENABLE_LOGGING every macro is empty and the header builds without Arduino.h
+#ifdef ENABLE_LOGGING
+
+#include <Arduino.h>
+
 class Logger {
     private:
     bool m_show_level;
     bool m_show_location;
     Stream* m_output;
+    logging::level_table m_levels;
+
+#ifdef LOG_DEFERRED
+    logging::record_ring<> m_ring;
+#endif
 
     Logger() : m_show_level(true),
                m_show_location(true),
-               m_output(&Serial) {}
+               m_output(&Serial),
+               m_levels(LOG_RUNTIME_LEVEL) {}
 
     Logger(const Logger&)            = delete;
     Logger& operator=(const Logger&) = delete;
 
-    void print_formatted_impl(const char* format) {
-        while (*format) {
-            m_output->print(*format++);
-        }
-    }
-
-    template <typename T, typename... Args>
-    void print_formatted_impl(const char* format, T value, Args... args) {
-        while (*format) {
-            if (*format == '{' && *(format + 1) == '}') {
-                m_output->print(value);
-                print_formatted_impl(format + 2, args...);
-                return;
-            }
-            m_output->print(*format++);
-        }
+    void write_segment(const logging::format_info& format, uint8_t idx) {
+        const logging::segment& seg = format.segs[idx];
+        if (seg.len) m_output->write(format.str + seg.off, seg.len);
     }
 
+    // 格式串在编译期已切分，运行时只交替输出文本段与参数
     template <typename... Args>
-    void printFormattedFlash(const __FlashStringHelper* format, Args... args) {
-        PGM_P p = reinterpret_cast<PGM_P>(format);
-        char buffer[256];
-        strncpy_P(buffer, p, sizeof(buffer) - 1);
-        buffer[sizeof(buffer) - 1] = '\0';
-        print_formatted_impl(buffer, args...);
+    void print_formatted(const logging::format_info& format, Args... args) {
+        uint8_t idx = 0;
+        ((write_segment(format, idx), m_output->print(args), idx++), ...);
+        write_segment(format, idx);
     }
 
     void print_header(const __FlashStringHelper* level, const __FlashStringHelper* file, int line) {
@@ -70,6 +80,43 @@ class Logger {
         }
     }
 
+    static const __FlashStringHelper* level_name(uint8_t level) {
+        switch (level) {
+        case LOG_LEVEL_TRACE: return F("TRACE");
+        case LOG_LEVEL_DEBUG: return F("DEBUG");
+        case LOG_LEVEL_INFO: return F("INFO ");
+        case LOG_LEVEL_WARN: return F("WARN ");
+        case LOG_LEVEL_ERROR: return F("ERROR");
+        default: return F("FATAL");
+        }
+    }
+
+    /*
+     * LOG_DEFERRED: only encode the call into the ring buffer, drain() prints it later
+     * otherwise:    format and print synchronously
+     */
+    template <typename S, typename... Args>
+    void emit(uint8_t level, const __FlashStringHelper* file, int line, logging::compiled_format<S>, Args... args) {
+        using format = logging::compiled_format<S>;
+        static_assert(format::argc == sizeof...(Args), "number of {} placeholders does not match the number of arguments");
+
+        PROF_SCOPE(prof::logger);
+#ifdef LOG_DEFERRED
+        static_assert(sizeof...(Args) <= logging::record::max_args, "too many arguments for a deferred log record");
+        static_assert(logging::payload_of<Args...>() <= logging::record::max_payload,
+                      "arguments do not fit the payload of a deferred log record");
+        logging::record* r = m_ring.reserve();
+        if (!r) return;
+        logging::encode(*r, reinterpret_cast<const char*>(file), line, level, micros(), &format::info, args...);
+        m_ring.commit();
+#else
+        if (!m_output) return;
+        print_header(level_name(level), file, line);
+        print_formatted(format::info, args...);
+        m_output->println();
+#endif
+    }
+
     public:
     static Logger& instance() {
         static Logger logger;
@@ -80,59 +127,88 @@ class Logger {
     void setShowLevel(bool show) { m_show_level = show; }
     void setShowLocation(bool show) { m_show_location = show; }
     void setOutput(Stream* output) { m_output = output; }
+    void setLevel(uint8_t mod, uint8_t level) { m_levels.set(mod, level); }
+    void setLevelAll(uint8_t level) { m_levels.set_all(level); }
+    uint8_t getLevel(uint8_t mod) const { return m_levels.get(mod); }
+
+    // 宏在求值任何参数之前先调用这里
+    bool enabled(uint8_t mod, uint8_t level) const { return m_levels.enabled(mod, level); }
 
     // TRACE
-    template <typename... Args>
-    void trace(const __FlashStringHelper* file, int line, const __FlashStringHelper* format, Args... args) {
-        if (!m_output) return;
-        print_header(F("TRACE"), file, line);
-        printFormattedFlash(format, args...);
-        m_output->println();
+    template <typename S, typename... Args>
+    void trace(const __FlashStringHelper* file, int line, logging::compiled_format<S> format, Args... args) {
+        emit(LOG_LEVEL_TRACE, file, line, format, args...);
     }
 
     // DEBUG
-    template <typename... Args>
-    void debug(const __FlashStringHelper* file, int line, const __FlashStringHelper* format, Args... args) {
-        if (!m_output) return;
-        print_header(F("DEBUG"), file, line);
-        printFormattedFlash(format, args...);
-        m_output->println();
+    template <typename S, typename... Args>
+    void debug(const __FlashStringHelper* file, int line, logging::compiled_format<S> format, Args... args) {
+        emit(LOG_LEVEL_DEBUG, file, line, format, args...);
     }
 
     // INFO
-    template <typename... Args>
-    void info(const __FlashStringHelper* file, int line, const __FlashStringHelper* format, Args... args) {
-        if (!m_output) return;
-        print_header(F("INFO "), file, line);
-        printFormattedFlash(format, args...);
-        m_output->println();
+    template <typename S, typename... Args>
+    void info(const __FlashStringHelper* file, int line, logging::compiled_format<S> format, Args... args) {
+        emit(LOG_LEVEL_INFO, file, line, format, args...);
     }
 
     // WARN
-    template <typename... Args>
-    void warn(const __FlashStringHelper* file, int line, const __FlashStringHelper* format, Args... args) {
-        if (!m_output) return;
-        print_header(F("WARN "), file, line);
-        printFormattedFlash(format, args...);
-        m_output->println();
+    template <typename S, typename... Args>
+    void warn(const __FlashStringHelper* file, int line, logging::compiled_format<S> format, Args... args) {
+        emit(LOG_LEVEL_WARN, file, line, format, args...);
     }
 
     // ERROR
-    template <typename... Args>
-    void error(const __FlashStringHelper* file, int line, const __FlashStringHelper* format, Args... args) {
-        if (!m_output) return;
-        print_header(F("ERROR"), file, line);
-        printFormattedFlash(format, args...);
-        m_output->println();
+    template <typename S, typename... Args>
+    void error(const __FlashStringHelper* file, int line, logging::compiled_format<S> format, Args... args) {
+        emit(LOG_LEVEL_ERROR, file, line, format, args...);
     }
 
     // FATAL
-    template <typename... Args>
-    void fatal(const __FlashStringHelper* file, int line, const __FlashStringHelper* format, Args... args) {
-        if (!m_output) return;
-        print_header(F("FATAL"), file, line);
-        printFormattedFlash(format, args...);
-        m_output->println();
+    template <typename S, typename... Args>
+    void fatal(const __FlashStringHelper* file, int line, logging::compiled_format<S> format, Args... args) {
+        emit(LOG_LEVEL_FATAL, file, line, format, args...);
+    }
+
+    // 延迟模式下在空闲时格式化并输出最多 max_records 条记录，返回输出的条数
+    size_t drain(size_t max_records) {
+#ifdef LOG_DEFERRED
+        if (!m_output) return 0;
+
+        size_t n = 0;
+        for (; n < max_records; n++) {
+            const logging::record* r = m_ring.front();
+            if (!r) break;
+
+            m_output->print('[');
+            m_output->print(static_cast<unsigned long>(r->timestamp_us));
+            m_output->print(F("] "));
+            print_header(level_name(r->level), reinterpret_cast<const __FlashStringHelper*>(r->file), r->line);
+            logging::format_record(*m_output, *r);
+            m_output->println();
+
+            m_ring.pop();
+        }
+
+        uint32_t lost = m_ring.front() ? 0 : m_ring.take_dropped();
+        if (lost) {
+            print_header(level_name(LOG_LEVEL_WARN), F(__FILE__), __LINE__);
+            m_output->print(F("log ring overflow, "));
+            m_output->print(static_cast<unsigned long>(lost));
+            m_output->println(F(" records dropped"));
+        }
+        return n;
+#else
+        return 0;
+#endif
+    }
+
+    uint32_t dropped() const {
+#ifdef LOG_DEFERRED
+        return m_ring.dropped();
+#else
+        return 0;
+#endif
     }
 };
 
@@ -140,57 +216,100 @@ inline Logger& log() {
     return Logger::instance();
 }
 
-#ifdef ENABLE_LOGGING
-
 #define LOG_BEGIN(val) log().begin(val);
 #define LOG_SETSHOWLEVEL(val) log().setShowLevel(val)
 #define LOG_SETSHOWLOCATION(val) log().setShowLocation(val)
+#define LOG_SETLEVEL(mod, level) log().setLevel(::logging::mod, level)
+#define LOG_DRAIN(n) log().drain(n)
+
+// the runtime level is checked first, arguments are not evaluated for a filtered call
+#define LOG_AT(mod, level, method, format, ...)                                              \
+    do {                                                                                     \
+        if (log().enabled(mod, level))                                                       \
+            log().method(F(__FILE__), __LINE__, LOG_COMPILE_FORMAT(format), ##__VA_ARGS__); \
+    } while (0)
+
+// wrap a whole log statement, suppressed calls cost one compare
+#define LOG_EVERY_MS(period, ...)                                              \
+    do {                                                                       \
+        static ::logging::every_ms _log_every(period);                         \
+        if (_log_every.ready(millis())) { __VA_ARGS__; }                       \
+    } while (0)
+
+#define LOG_EVERY_N(n, ...)                                                    \
+    do {                                                                       \
+        static ::logging::every_n _log_every;                                  \
+        if (_log_every.ready(n)) { __VA_ARGS__; }                              \
+    } while (0)
 
 #if LOG_LEVEL <= LOG_LEVEL_TRACE
-#define LOG_TRACE(format, ...) log().trace(F(__FILE__), __LINE__, F(format), ##__VA_ARGS__)
+#define LOG_TRACE(format, ...) LOG_AT(LOG_MODULE, LOG_LEVEL_TRACE, trace, format, ##__VA_ARGS__)
+#define LOGM_TRACE(mod, format, ...) LOG_AT(::logging::mod, LOG_LEVEL_TRACE, trace, format, ##__VA_ARGS__)
 #else
 #define LOG_TRACE(format, ...)
+#define LOGM_TRACE(mod, format, ...)
 #endif
 
 #if LOG_LEVEL <= LOG_LEVEL_DEBUG
-#define LOG_DEBUG(format, ...) log().debug(F(__FILE__), __LINE__, F(format), ##__VA_ARGS__)
+#define LOG_DEBUG(format, ...) LOG_AT(LOG_MODULE, LOG_LEVEL_DEBUG, debug, format, ##__VA_ARGS__)
+#define LOGM_DEBUG(mod, format, ...) LOG_AT(::logging::mod, LOG_LEVEL_DEBUG, debug, format, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG(format, ...)
+#define LOGM_DEBUG(mod, format, ...)
 #endif
 
 #if LOG_LEVEL <= LOG_LEVEL_INFO
-#define LOG_INFO(format, ...) log().info(F(__FILE__), __LINE__, F(format), ##__VA_ARGS__)
+#define LOG_INFO(format, ...) LOG_AT(LOG_MODULE, LOG_LEVEL_INFO, info, format, ##__VA_ARGS__)
+#define LOGM_INFO(mod, format, ...) LOG_AT(::logging::mod, LOG_LEVEL_INFO, info, format, ##__VA_ARGS__)
 #else
 #define LOG_INFO(format, ...)
+#define LOGM_INFO(mod, format, ...)
 #endif
 
 #if LOG_LEVEL <= LOG_LEVEL_WARN
-#define LOG_WARN(format, ...) log().warn(F(__FILE__), __LINE__, F(format), ##__VA_ARGS__)
+#define LOG_WARN(format, ...) LOG_AT(LOG_MODULE, LOG_LEVEL_WARN, warn, format, ##__VA_ARGS__)
+#define LOGM_WARN(mod, format, ...) LOG_AT(::logging::mod, LOG_LEVEL_WARN, warn, format, ##__VA_ARGS__)
 #else
 #define LOG_WARN(format, ...)
+#define LOGM_WARN(mod, format, ...)
 #endif
 
 #if LOG_LEVEL <= LOG_LEVEL_ERROR
-#define LOG_ERROR(format, ...) log().error(F(__FILE__), __LINE__, F(format), ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LOG_AT(LOG_MODULE, LOG_LEVEL_ERROR, error, format, ##__VA_ARGS__)
+#define LOGM_ERROR(mod, format, ...) LOG_AT(::logging::mod, LOG_LEVEL_ERROR, error, format, ##__VA_ARGS__)
 #else
 #define LOG_ERROR(format, ...)
+#define LOGM_ERROR(mod, format, ...)
 #endif
 
 #if LOG_LEVEL <= LOG_LEVEL_FATAL
-#define LOG_FATAL(format, ...) log().fatal(F(__FILE__), __LINE__, F(format), ##__VA_ARGS__)
+#define LOG_FATAL(format, ...) LOG_AT(LOG_MODULE, LOG_LEVEL_FATAL, fatal, format, ##__VA_ARGS__)
+#define LOGM_FATAL(mod, format, ...) LOG_AT(::logging::mod, LOG_LEVEL_FATAL, fatal, format, ##__VA_ARGS__)
 #else
 #define LOG_FATAL(format, ...)
+#define LOGM_FATAL(mod, format, ...)
 #endif
 
 #else
 
-#define LOG_SHOWLEVEL(val)
-#define LOG_SHOWLOCATION(val)
+#define LOG_BEGIN(val)
+#define LOG_SETSHOWLEVEL(val)
+#define LOG_SETSHOWLOCATION(val)
+#define LOG_SETLEVEL(mod, level)
+#define LOG_DRAIN(n)
+#define LOG_EVERY_MS(period, ...)
+#define LOG_EVERY_N(n, ...)
 #define LOG_TRACE(format, ...)
 #define LOG_DEBUG(format, ...)
 #define LOG_INFO(format, ...)
 #define LOG_WARN(format, ...)
 #define LOG_ERROR(format, ...)
 #define LOG_FATAL(format, ...)
+#define LOGM_TRACE(mod, format, ...)
+#define LOGM_DEBUG(mod, format, ...)
+#define LOGM_INFO(mod, format, ...)
+#define LOGM_WARN(mod, format, ...)
+#define LOGM_ERROR(mod, format, ...)
+#define LOGM_FATAL(mod, format, ...)
 
-#endif
\ No newline at end of file
+#endif
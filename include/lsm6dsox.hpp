@@ -0,0 +1,272 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace lsm6 {
+
+/*
+ * LSM6DSOX (Modulino Movement) driven through its internal FIFO
+ * the sensor samples accelerometer and gyro on its own clock and queues
+ * them, so sample times no longer depend on when the loop gets to the bus,
+ * and the whole backlog is fetched with a few burst reads at 400 kHz
+ *
+ * Bus is anything with the TwoWire interface (beginTransmission, write,
+ * endTransmission, requestFrom, read, setClock), the Wire objects on the
+ * board and a register model in the native tests
+ */
+namespace reg {
+constexpr uint8_t fifo_ctrl3    = 0x09;
+constexpr uint8_t fifo_ctrl4    = 0x0A;
+constexpr uint8_t who_am_i      = 0x0F;
+constexpr uint8_t ctrl1_xl      = 0x10;
+constexpr uint8_t ctrl2_g       = 0x11;
+constexpr uint8_t ctrl3_c       = 0x12;
+constexpr uint8_t fifo_status1  = 0x3A;
+constexpr uint8_t fifo_status2  = 0x3B;
+constexpr uint8_t fifo_data_tag = 0x78;
+} // namespace reg
+
+constexpr uint8_t address    = 0x6A; // SDO low on the Modulino
+constexpr uint8_t chip_id    = 0x6C;
+constexpr uint32_t bus_clock = 400000;
+
+// FIFO_STATUS2
+constexpr uint8_t status_overrun   = 0x40;
+constexpr uint8_t status_diff_high = 0x03;
+
+// FIFO_DATA_OUT_TAG bits 7..3
+constexpr uint8_t tag_gyro  = 0x01;
+constexpr uint8_t tag_accel = 0x02;
+
+// 208 Hz is the closest output rate to the old 200 Hz loop
+constexpr uint8_t odr_208hz = 0x5;
+constexpr uint32_t rate_hz  = 208;
+
+// +-4 g and +-500 dps, the full scale bits of CTRL1_XL and CTRL2_G
+constexpr uint8_t fs_xl_4g    = 0x2 << 2;
+constexpr uint8_t fs_g_500dps = 0x1 << 2;
+constexpr float acc_lsb       = 0.122e-3f;               // g
+constexpr float gyro_lsb      = 17.5e-3f * 0.017453292f; // rad/s
+
+// FIFO_CTRL4 modes, bypass stops queuing and empties the FIFO
+constexpr uint8_t fifo_bypass     = 0x0;
+constexpr uint8_t fifo_continuous = 0x6;
+constexpr size_t word_bytes       = 7; // tag + 3 x int16
+
+/*
+ * one accelerometer + gyro pair as read from the FIFO
+ * seq counts delivered samples, a consumer that remembers the last seq it
+ * handled can neither process a sample twice nor miss a gap
+ */
+struct sample {
+    uint32_t seq;
+    uint32_t t_us; // reconstructed sampling time, see fifo::read
+    int16_t acc[3];
+    int16_t gyro[3];
+
+    auto ax() const -> float { return acc[0] * acc_lsb; }
+    auto ay() const -> float { return acc[1] * acc_lsb; }
+    auto az() const -> float { return acc[2] * acc_lsb; }
+    auto gx() const -> float { return gyro[0] * gyro_lsb; }
+    auto gy() const -> float { return gyro[1] * gyro_lsb; }
+    auto gz() const -> float { return gyro[2] * gyro_lsb; }
+};
+
+/*
+ * bounded sample queue between the FIFO reader and the control task
+ * when full the oldest sample is dropped, the control loop wants the newest
+ * data, dropped() counts what it lost
+ */
+template <size_t N>
+class queue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "queue size must be a power of two");
+
+    private:
+    sample m_buf[N];
+    uint32_t m_head    = 0;
+    uint32_t m_tail    = 0;
+    uint32_t m_dropped = 0;
+
+    public:
+    auto push(const sample& s) -> void {
+        if (m_head - m_tail == N) {
+            m_tail++;
+            m_dropped++;
+        }
+        m_buf[m_head++ & (N - 1)] = s;
+    }
+
+    auto pop(sample& s) -> bool {
+        if (m_head == m_tail) return false;
+        s = m_buf[m_tail++ & (N - 1)];
+        return true;
+    }
+
+    auto clear() -> void { m_tail = m_head; }
+
+    auto size() const -> size_t { return m_head - m_tail; }
+    auto empty() const -> bool { return m_head == m_tail; }
+    auto dropped() const -> uint32_t { return m_dropped; }
+};
+
+/*
+ * FIFO reader, MaxBurst words per I2C read so a burst fits the 32 byte
+ * buffer of the smallest Wire implementations
+ */
+template <typename Bus, size_t MaxBurst = 4>
+class fifo {
+    static_assert(MaxBurst * word_bytes <= 32, "burst does not fit a 32 byte Wire buffer");
+
+    // sample period in 1/256 us, keeps the reconstructed times free of drift
+    static constexpr uint32_t period_q8 = (1000000u << 8) / rate_hz;
+    static constexpr uint32_t period_us = period_q8 >> 8;
+
+    private:
+    Bus& m_bus;
+    uint8_t m_addr;
+
+    // 半组数据：加速度计与陀螺仪各自入队，凑齐一对才输出
+    int16_t m_acc[3]  = {};
+    int16_t m_gyro[3] = {};
+    bool m_have_acc   = false;
+    bool m_have_gyro  = false;
+
+    uint32_t m_seq      = 0;
+    uint32_t m_t_us     = 0; // time of the newest sample delivered
+    uint32_t m_t_frac   = 0;
+    bool m_anchored     = false;
+    uint32_t m_overruns = 0;
+    uint32_t m_reads    = 0;
+
+    auto write_reg(uint8_t r, uint8_t v) -> bool {
+        m_bus.beginTransmission(m_addr);
+        m_bus.write(r);
+        m_bus.write(v);
+        return m_bus.endTransmission() == 0;
+    }
+
+    // repeated start, IF_INC advances the register address
+    auto read_regs(uint8_t r, uint8_t* dst, size_t n) -> bool {
+        m_bus.beginTransmission(m_addr);
+        m_bus.write(r);
+        if (m_bus.endTransmission(false) != 0) return false;
+        if (m_bus.requestFrom(m_addr, n) != n) return false;
+        for (size_t i = 0; i < n; i++) dst[i] = static_cast<uint8_t>(m_bus.read());
+        m_reads++;
+        return true;
+    }
+
+    static auto le16(const uint8_t* p) -> int16_t { return static_cast<int16_t>(p[0] | (p[1] << 8)); }
+
+    public:
+    explicit fifo(Bus& bus, uint8_t addr = address) noexcept : m_bus(bus), m_addr(addr) {}
+
+    // 208 Hz for both sensors into a continuous FIFO, false when the chip does not answer
+    auto begin() -> bool {
+        m_bus.setClock(bus_clock);
+
+        uint8_t id = 0;
+        if (!read_regs(reg::who_am_i, &id, 1) || id != chip_id) return false;
+
+        return write_reg(reg::ctrl3_c, 0x44) // BDU | IF_INC
+            && write_reg(reg::ctrl1_xl, static_cast<uint8_t>(odr_208hz << 4 | fs_xl_4g))
+            && write_reg(reg::ctrl2_g, static_cast<uint8_t>(odr_208hz << 4 | fs_g_500dps))
+            && write_reg(reg::fifo_ctrl3, static_cast<uint8_t>(odr_208hz << 4 | odr_208hz))
+            && write_reg(reg::fifo_ctrl4, fifo_continuous);
+    }
+
+    /*
+     * continuous queuing on or off, off (bypass) empties the FIFO on the chip
+     * so nothing piles up while nobody reads it, the first read after turning
+     * it back on anchors the timestamps again
+     */
+    auto stream(bool on) -> bool {
+        m_anchored  = false;
+        m_have_acc  = false;
+        m_have_gyro = false;
+        return write_reg(reg::fifo_ctrl4, on ? fifo_continuous : fifo_bypass);
+    }
+
+    /*
+     * drains the FIFO into out, returns the number of complete samples
+     * now_us is the time of the read and the newest sample was taken at most
+     * one period before it, times advance by exactly one period per sample
+     * and are only pulled back into [now - period, now] when the sensor and
+     * MCU clocks drift apart, a batch that no longer fits after the previous
+     * one is spaced tighter so the times stay strictly increasing
+     */
+    template <typename Out>
+    auto read(Out& out, uint32_t now_us) -> size_t {
+        uint8_t status[2];
+        if (!read_regs(reg::fifo_status1, status, 2)) return 0;
+
+        // 溢出时丢失的数据量未知，时间戳重新对齐
+        if (status[1] & status_overrun) {
+            m_overruns++;
+            m_anchored  = false;
+            m_have_acc  = false;
+            m_have_gyro = false;
+        }
+
+        size_t words = status[0] | static_cast<size_t>(status[1] & status_diff_high) << 8;
+        size_t pairs = (words + (m_have_acc || m_have_gyro ? 1 : 0)) / 2;
+        if (words == 0) return 0;
+
+        // 先确定本次最新样本的时间，再从它往前排
+        uint32_t span_q8 = period_q8;
+        if (pairs > 0) {
+            if (!m_anchored) {
+                m_t_us     = now_us - pairs * period_us;
+                m_t_frac   = 0;
+                m_anchored = true;
+            }
+            uint32_t prev = m_t_us;
+            for (size_t i = 0; i < pairs; i++) {
+                m_t_frac += period_q8 & 0xFF;
+                m_t_us += period_us + (m_t_frac >> 8);
+                m_t_frac &= 0xFF;
+            }
+            if (static_cast<int32_t>(m_t_us - now_us) > 0) m_t_us = now_us;
+            else if (now_us - m_t_us > period_us) m_t_us = now_us - period_us;
+
+            if (m_t_us - prev < pairs * period_us) span_q8 = ((m_t_us - prev) << 8) / pairs;
+        }
+
+        size_t total = 0;
+        while (words > 0) {
+            size_t n = words < MaxBurst ? words : MaxBurst;
+            uint8_t raw[MaxBurst * word_bytes];
+            if (!read_regs(reg::fifo_data_tag, raw, n * word_bytes)) break;
+            words -= n;
+
+            for (size_t w = 0; w < n; w++) {
+                const uint8_t* p = raw + w * word_bytes;
+                uint8_t tag      = p[0] >> 3;
+                int16_t* dst     = tag == tag_accel ? m_acc : tag == tag_gyro ? m_gyro : nullptr;
+                if (!dst) continue; // 温度、时间戳等其它标签
+
+                for (int i = 0; i < 3; i++) dst[i] = le16(p + 1 + 2 * i);
+                (tag == tag_accel ? m_have_acc : m_have_gyro) = true;
+                if (!m_have_acc || !m_have_gyro) continue;
+
+                sample s;
+                s.seq  = m_seq++;
+                s.t_us = m_t_us - ((static_cast<uint32_t>(pairs > total ? pairs - 1 - total : 0) * span_q8) >> 8);
+                for (int i = 0; i < 3; i++) {
+                    s.acc[i]  = m_acc[i];
+                    s.gyro[i] = m_gyro[i];
+                }
+                m_have_acc = m_have_gyro = false;
+                out.push(s);
+                total++;
+            }
+        }
+        return total;
+    }
+
+    auto overruns() const -> uint32_t { return m_overruns; }
+    auto bus_reads() const -> uint32_t { return m_reads; }
+};
+
+} // namespace lsm6
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "fixed_point.hpp"
+#include "literals.hpp"
+
+namespace ctrl {
+
+using namespace ::literals;
+
+/*
+ * N PID channels sampled at the same timestamp, stored as structure-of-arrays
+ * so one update() is a single branch-free loop over contiguous memory
+ * per channel maths is the same as basic_pid_controller::update, except that
+ * 1/dt is computed once and shared by all channels
+ */
+template <typename T, size_t N>
+class basic_pid_bank {
+    static_assert(N > 0, "pid bank needs at least one channel");
+
+    public:
+    using value_type = T;
+    using array_type = std::array<T, N>;
+
+    private:
+    array_type m_target;
+
+    array_type m_kp;
+    array_type m_ki;
+    array_type m_kd;
+
+    array_type m_int;
+    array_type m_prev_err;
+
+    T m_prev_time;
+
+    bool m_first_sample;
+
+    public:
+    basic_pid_bank() noexcept
+    : m_prev_time(0),
+      m_first_sample(true) {
+        m_target.fill(T(0));
+        m_kp.fill(T(0));
+        m_ki.fill(T(0));
+        m_kd.fill(T(0));
+        m_int.fill(T(0));
+        m_prev_err.fill(T(0));
+    }
+
+    ~basic_pid_bank() noexcept = default;
+
+    static constexpr auto size() noexcept -> size_t { return N; }
+
+    // in and out must hold N values and must not alias each other
+    auto update(const T* __restrict in, T* __restrict out, T now_time) -> void {
+        T dt = now_time - m_prev_time;
+        if (m_first_sample) dt = T(0);
+
+        T inv_dt = (!m_first_sample && dt > T(0)) ? T(1) / dt : T(0);
+
+        const T* __restrict target   = m_target.data();
+        const T* __restrict kp       = m_kp.data();
+        const T* __restrict ki       = m_ki.data();
+        const T* __restrict kd       = m_kd.data();
+        T* __restrict       integral = m_int.data();
+        T* __restrict       prev_err = m_prev_err.data();
+
+        for (size_t i = 0; i < N; i++) {
+            T err = target[i] - in[i];
+
+            integral[i] += err * dt;
+            T der = (prev_err[i] - err) * inv_dt;
+
+            out[i]      = err * kp[i] + integral[i] * ki[i] + der * kd[i];
+            prev_err[i] = err;
+        }
+
+        m_prev_time    = now_time;
+        m_first_sample = false;
+    }
+
+    auto update(const array_type& in, array_type& out, T now_time) -> void {
+        update(in.data(), out.data(), now_time);
+    }
+
+    auto update(const array_type& in, array_type& out, dura_t now_time) -> void {
+        update(in.data(), out.data(), T(now_time.v));
+    }
+
+    auto reset() -> void {
+        m_int.fill(T(0));
+        m_prev_err.fill(T(0));
+        m_first_sample = true;
+    }
+
+    auto get_target(size_t ch) const noexcept -> T { return m_target[ch]; }
+    auto set_target(size_t ch, T target) -> void { m_target[ch] = target; }
+
+    auto get_kp(size_t ch) const noexcept -> T { return m_kp[ch]; }
+    auto set_kp(size_t ch, T kp) -> void { m_kp[ch] = kp; }
+
+    auto get_ki(size_t ch) const noexcept -> T { return m_ki[ch]; }
+    auto set_ki(size_t ch, T ki) -> void { m_ki[ch] = ki; }
+
+    auto get_kd(size_t ch) const noexcept -> T { return m_kd[ch]; }
+    auto set_kd(size_t ch, T kd) -> void { m_kd[ch] = kd; }
+
+    auto set_gains(size_t ch, T kp, T ki, T kd) -> void {
+        m_kp[ch] = kp;
+        m_ki[ch] = ki;
+        m_kd[ch] = kd;
+    }
+};
+
+template <size_t N>
+using pid_bank = basic_pid_bank<double, N>;
+template <size_t N>
+using pid_bank_f = basic_pid_bank<float, N>;
+template <size_t N>
+using pid_bank_q16 = basic_pid_bank<fxp::q16_16, N>;
+
+} // namespace ctrl
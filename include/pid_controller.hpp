@@ -2,89 +2,455 @@
 
 #include <stdint.h>
 
+#include <limits>
+#include <type_traits>
+
+#include "fixed_point.hpp"
 #include "literals.hpp"
 
 namespace ctrl {
 
 using namespace ::literals;
 
-class pid_controller {
+namespace __details {
+
+// integer ticks to seconds in T, no double on the way for float and fixed
+template <typename T, uint32_t R>
+constexpr auto seconds(tick_dura<R> d) -> std::enable_if_t<!fxp::is_fixed<T>::value, T> {
+    return static_cast<T>(d.v) * (static_cast<T>(1) / static_cast<T>(R));
+}
+
+template <typename T, uint32_t R>
+constexpr auto seconds(tick_dura<R> d) -> std::enable_if_t<fxp::is_fixed<T>::value, T> {
+    return T::from_raw(static_cast<typename T::wide_t>(d.v) * T::one / R);
+}
+
+template <typename T>
+constexpr auto highest() -> T {
+    if constexpr (fxp::is_fixed<T>::value) return T::from_raw(T::max);
+    else return std::numeric_limits<T>::max();
+}
+
+template <typename T>
+constexpr auto lowest() -> T {
+    if constexpr (fxp::is_fixed<T>::value) return T::from_raw(T::min);
+    else return std::numeric_limits<T>::lowest();
+}
+
+} // namespace __details
+
+// what happens to the integral while the output is at a limit
+enum class anti_windup : uint8_t {
+    none,        // no output limit at all
+    clamp,       // output clipped, the integral keeps running
+    conditional, // output clipped, no integration while it would push further into the limit
+    back_calc,   // output clipped, the integral is driven back by (clipped - unclipped) / Tt,
+                 // Tt defaults to Ti = kp / ki, so with kp == 0 it needs set_tracking
+};
+
+enum class derivative : uint8_t {
+    on_error,       // kicks on every setpoint step
+    on_measurement, // same sign as on_error while the setpoint holds still
+};
+
+/*
+ * compile time options of basic_pid_controller, every feature that is off
+ * has neither state nor code in the controller
+ * Limit    := output saturation and anti-windup
+ * Deriv    := what the derivative acts on
+ * Filtered := first order low pass with time constant Tf on the D term
+ * Weighted := setpoint weights, P acts on b * target - val, D on c * target - val
+ */
+template <anti_windup Limit = anti_windup::none, derivative Deriv = derivative::on_error, bool Filtered = false,
+          bool Weighted = false>
+struct pid_policy {
+    static constexpr anti_windup limit = Limit;
+    static constexpr bool limited      = Limit != anti_windup::none;
+    static constexpr derivative deriv  = Deriv;
+    static constexpr bool filtered     = Filtered;
+    static constexpr bool weighted     = Weighted;
+};
+
+namespace __details {
+
+// state of the optional features, empty bases when a feature is off
+
+template <typename T, anti_windup Limit>
+struct pid_limit {
+    T m_lo = lowest<T>();
+    T m_hi = highest<T>();
+};
+template <typename T>
+struct pid_limit<T, anti_windup::none> {};
+template <typename T>
+struct pid_limit<T, anti_windup::back_calc> {
+    T m_lo = lowest<T>();
+    T m_hi = highest<T>();
+    T m_tt = T(0); // tracking time constant, 0 := Ti = kp / ki
+    T m_kb = T(0); // 1 / (ki * Tt), baked
+};
+
+template <typename T, bool Filtered>
+struct pid_d_filter {
+    T m_tf = T(0);
+    T m_d  = T(0);
+};
+template <typename T>
+struct pid_d_filter<T, false> {};
+
+template <typename T, bool Weighted>
+struct pid_weights {
+    T m_b = T(1);
+    T m_c = T(1);
+};
+template <typename T>
+struct pid_weights<T, false> {};
+
+} // namespace __details
+
+/*
+ * T := scalar used for gains, state and timestamps (in seconds)
+ * double, float and fxp::fixed<> are supported
+ * Policy := pid_policy<>, the default is the plain unlimited PID
+ * timestamps are either T seconds or integer time_us_t ticks, the latter is
+ * exact across the micros() wrap and keeps the time base out of T, a
+ * controller must be fed with only one of the two kinds
+ * the D term is -kd * d(err)/dt, a damping derivative takes kd < 0, the same
+ * convention as basic_pid_bank and basic_discrete_pid
+ */
+template <typename T, typename Policy = pid_policy<>>
+class basic_pid_controller : private __details::pid_limit<T, Policy::limit>,
+                             private __details::pid_d_filter<T, Policy::filtered>,
+                             private __details::pid_weights<T, Policy::weighted> {
+    public:
+    using value_type  = T;
+    using policy_type = Policy;
+
     private:
-    double m_target;
+    T m_target;
 
-    double m_kp;
-    double m_ki;
-    double m_kd;
+    T m_kp;
+    T m_ki;
+    T m_kd;
 
-    double m_int;
-    double m_prev_err;
+    T m_int;
+    T m_prev_err;
 
-    dura_t m_prev_time;
+    T m_prev_time;
+    time_us_t m_prev_tick;
 
     bool m_first_sample;
 
+    auto clip(T u) const -> T {
+        return u > this->m_hi ? this->m_hi : (u < this->m_lo ? this->m_lo : u);
+    }
+
+    auto bake() -> void {
+        if constexpr (Policy::limit == anti_windup::back_calc) {
+            if (m_ki == T(0)) this->m_kb = T(0);
+            else if (this->m_tt > T(0)) this->m_kb = T(1) / (m_ki * this->m_tt);
+            else this->m_kb = m_kp == T(0) ? T(0) : T(1) / m_kp;
+        }
+    }
+
+    auto step(T val, T dt) -> T {
+        if (m_first_sample) dt = T(0);
+
+        T err = m_target - val;
+
+        // the integral always sees the full error
+        T err_p = err;
+        T err_d = err;
+        if constexpr (Policy::weighted) {
+            err_p = this->m_b * m_target - val;
+            err_d = this->m_c * m_target - val;
+        }
+        if constexpr (Policy::deriv == derivative::on_measurement) err_d = -val;
+
+        T p = err_p * m_kp;
+
+        T d = T(0);
+        if (!m_first_sample && dt > T(0)) {
+            T der = -(err_d - m_prev_err) / dt;
+
+            d = der * m_kd;
+        }
+        if constexpr (Policy::filtered) {
+            // backward Euler, holds its value when dt is 0
+            // alpha first: in fixed point (d - m_d) * dt would drop the low bits of a small dt
+            if (dt > T(0)) {
+                T alpha   = dt / (this->m_tf + dt);
+                this->m_d += alpha * (d - this->m_d);
+            }
+            d = this->m_d;
+        }
+
+        T integ = m_int + err * dt;
+        T output;
+        if constexpr (Policy::limited) {
+            T u    = p + integ * m_ki + d;
+            output = clip(u);
+            if constexpr (Policy::limit == anti_windup::conditional) {
+                bool further = (u > this->m_hi && err * m_ki > T(0)) || (u < this->m_lo && err * m_ki < T(0));
+                if (further) output = clip(p + m_int * m_ki + d);
+                else m_int = integ;
+            } else if constexpr (Policy::limit == anti_windup::back_calc) {
+                m_int = integ + (output - u) * this->m_kb * dt;
+            } else {
+                m_int = integ;
+            }
+        } else {
+            m_int = integ;
+            T i   = m_int * m_ki;
+
+            output = p + i + d;
+        }
+
+        m_prev_err     = err_d;
+        m_first_sample = false;
+
+        return output;
+    }
+
     public:
-    pid_controller() noexcept
-    : m_target(.0),
-      m_kp(.0), m_ki(.0), m_kd(.0),
-      m_int(.0),
-      m_prev_err(.0),
-      m_prev_time(0s),
+    basic_pid_controller() noexcept
+    : m_target(0),
+      m_kp(0), m_ki(0), m_kd(0),
+      m_int(0),
+      m_prev_err(0),
+      m_prev_time(0),
+      m_prev_tick(0),
       m_first_sample(true) {
     }
 
-    pid_controller(double kp, double ki, double kd) noexcept
-    : pid_controller() {
+    basic_pid_controller(T kp, T ki, T kd) noexcept
+    : basic_pid_controller() {
         m_kp = kp;
         m_ki = ki;
         m_kd = kd;
+        bake();
     }
 
-    ~pid_controller() noexcept = default;
+    ~basic_pid_controller() noexcept = default;
 
-    auto update(double val, dura_t now_time) -> double {
-        double dt = now_time.v - m_prev_time.v;
-        if (m_first_sample) dt = 0;
+    auto update(T val, T now_time) -> T {
+        T dt        = now_time - m_prev_time;
+        m_prev_time = now_time;
+        return step(val, dt);
+    }
 
-        double err = m_target - val;
+    auto update(T val, time_us_t now) -> T {
+        dura_us_t dt = now - m_prev_tick;
+        m_prev_tick  = now;
+        return step(val, __details::seconds<T>(dt));
+    }
 
-        double p = err * m_kp;
+    auto update(T val, dura_t now_time) -> T {
+        return update(val, T(now_time.v));
+    }
 
-        m_int += err * dt;
-        double i = m_int * m_ki;
+    auto reset() -> void {
+        m_int          = T(0);
+        m_prev_err     = T(0);
+        m_first_sample = true;
+        if constexpr (Policy::filtered) this->m_d = T(0);
+    }
 
-        double d = 0;
-        if (!m_first_sample) {
-            double der = -(err - m_prev_err) / dt;
+    auto get_target() noexcept -> const decltype(m_target) { return m_target; }
+    auto set_target(T target) -> void { m_target = target; }
 
-            d = der * m_kd;
+    auto get_kp() noexcept -> const decltype(m_kp) { return m_kp; }
+    auto set_kp(T kp) -> void {
+        m_kp = kp;
+        bake();
+    }
+
+    auto get_ki() noexcept -> const decltype(m_ki) { return m_ki; }
+    auto set_ki(T ki) -> void {
+        m_ki = ki;
+        bake();
+    }
+
+    auto get_kd() noexcept -> const decltype(m_kd) { return m_kd; }
+    auto set_kd(T kd) -> void { m_kd = kd; }
+
+    // the setters below exist only for the policies that have the state
+
+    auto get_output_min() const -> T {
+        static_assert(Policy::limited, "no output limits in this policy");
+        return this->m_lo;
+    }
+    auto get_output_max() const -> T {
+        static_assert(Policy::limited, "no output limits in this policy");
+        return this->m_hi;
+    }
+    auto set_output_limits(T lo, T hi) -> void {
+        static_assert(Policy::limited, "no output limits in this policy");
+        // bounds given in either order
+        this->m_lo = lo < hi ? lo : hi;
+        this->m_hi = lo < hi ? hi : lo;
+    }
+
+    // back-calculation time constant Tt in seconds, 0 uses Ti = kp / ki
+    // with kp == 0 there is no Ti, back-calculation stays off until Tt > 0 is set
+    auto set_tracking(T tt) -> void {
+        static_assert(Policy::limit == anti_windup::back_calc, "tracking needs anti_windup::back_calc");
+        this->m_tt = tt;
+        bake();
+    }
+
+    // derivative filter time constant Tf in seconds, 0 disables the filtering
+    auto set_d_filter(T tf) -> void {
+        static_assert(Policy::filtered, "no derivative filter in this policy");
+        this->m_tf = tf;
+    }
+    auto set_d_filter(dura_t tf) -> void { set_d_filter(T(tf.v)); }
+
+    // b weights the setpoint in P, c in D (unused with derivative::on_measurement)
+    auto set_weights(T b, T c) -> void {
+        static_assert(Policy::weighted, "no setpoint weights in this policy");
+        this->m_b = b;
+        this->m_c = c;
+    }
+};
+
+using pid_controller     = basic_pid_controller<double>;
+using pid_controller_f   = basic_pid_controller<float>;
+using pid_controller_q16 = basic_pid_controller<fxp::q16_16>;
+
+/*
+ * fixed sample period PID, Ts is baked into the coefficients once
+ * positional:  u[k]  = kp * e[k] + ki*Ts * sum(e) - kd/Ts * (e[k] - e[k-1])
+ * incremental: du[k] = q0 * e[k] + q1 * e[k-1] + q2 * e[k-2]
+ * the derivative sign follows basic_pid_controller::update
+ */
+template <typename T>
+class basic_discrete_pid {
+    public:
+    using value_type = T;
+
+    private:
+    T m_target;
+
+    T m_kp;
+    T m_ki;
+    T m_kd;
+    T m_period;
+
+    // positional coefficients
+    T m_ki_ts;
+    T m_kd_ts;
+
+    // incremental coefficients
+    T m_q0;
+    T m_q1;
+    T m_q2;
+
+    T m_sum;
+    T m_err1;
+    T m_err2;
+
+    bool m_first_sample;
+
+    auto bake() -> void {
+        m_ki_ts = m_ki * m_period;
+        m_kd_ts = m_kd / m_period;
+
+        m_q0 = m_kp + m_ki_ts - m_kd_ts;
+        m_q1 = m_kd_ts + m_kd_ts - m_kp;
+        m_q2 = -m_kd_ts;
+    }
+
+    auto shift(T err) -> void {
+        if (m_first_sample) {
+            m_err1         = err;
+            m_first_sample = false;
         }
+        m_err2 = m_err1;
+        m_err1 = err;
+    }
 
-        m_prev_err     = err;
-        m_prev_time    = now_time;
-        m_first_sample = false;
+    public:
+    basic_discrete_pid(T kp, T ki, T kd, T period) noexcept
+    : m_target(0),
+      m_kp(kp), m_ki(ki), m_kd(kd),
+      m_period(period),
+      m_sum(0),
+      m_err1(0), m_err2(0),
+      m_first_sample(true) {
+        bake();
+    }
+
+    basic_discrete_pid(T kp, T ki, T kd, dura_t period) noexcept
+    : basic_discrete_pid(kp, ki, kd, T(period.v)) {
+    }
+
+    basic_discrete_pid(T kp, T ki, T kd, dura_us_t period) noexcept
+    : basic_discrete_pid(kp, ki, kd, __details::seconds<T>(period)) {
+    }
+
+    ~basic_discrete_pid() noexcept = default;
+
+    // positional form, returns the absolute output
+    auto update(T val) -> T {
+        T err = m_target - val;
+        if (m_first_sample) m_err1 = err;
 
-        double output = p + i + d;
+        m_sum += err;
+        T output = m_kp * err + m_ki_ts * m_sum + m_kd_ts * (m_err1 - err);
+
+        shift(err);
         return output;
     }
 
+    // incremental (velocity) form, returns the output change since the previous sample
+    auto update_delta(T val) -> T {
+        T err = m_target - val;
+        if (m_first_sample) {
+            shift(err);
+            return (m_kp + m_ki_ts) * err;
+        }
+
+        T delta = m_q0 * err + m_q1 * m_err1 + m_q2 * m_err2;
+
+        shift(err);
+        return delta;
+    }
+
     auto reset() -> void {
-        m_int          = 0;
-        m_prev_err     = 0;
+        m_sum          = T(0);
+        m_err1         = T(0);
+        m_err2         = T(0);
         m_first_sample = true;
     }
 
     auto get_target() noexcept -> const decltype(m_target) { return m_target; }
-    auto set_target(double target) -> void { m_target = target; }
+    auto set_target(T target) -> void { m_target = target; }
+
+    auto get_period() noexcept -> const decltype(m_period) { return m_period; }
 
     auto get_kp() noexcept -> const decltype(m_kp) { return m_kp; }
-    auto set_kp(double kp) -> void { m_kp = kp; }
+    auto set_kp(T kp) -> void {
+        m_kp = kp;
+        bake();
+    }
 
     auto get_ki() noexcept -> const decltype(m_ki) { return m_ki; }
-    auto set_ki(double ki) -> void { m_ki = ki; }
+    auto set_ki(T ki) -> void {
+        m_ki = ki;
+        bake();
+    }
 
     auto get_kd() noexcept -> const decltype(m_kd) { return m_kd; }
-    auto set_kd(double kd) -> void { m_kd = kd; }
+    auto set_kd(T kd) -> void {
+        m_kd = kd;
+        bake();
+    }
 };
 
+using discrete_pid     = basic_discrete_pid<double>;
+using discrete_pid_f   = basic_discrete_pid<float>;
+using discrete_pid_q16 = basic_discrete_pid<fxp::q16_16>;
+using discrete_pid_q31 = basic_discrete_pid<fxp::q31>;
+
 } // namespace ctrl
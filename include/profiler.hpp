@@ -0,0 +1,242 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !(defined(__arm__) && (defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__)))
+#include <chrono>
+#endif
+
+namespace prof {
+
+// probe ids used by the firmware, keep prof_names in sync
+enum probe_id : uint8_t {
+    imu_update,
+    button_update,
+    matrix_show,
+    matrix_anim,
+    logger,
+    attitude,
+    probe_count,
+};
+
+inline constexpr const char* prof_names[probe_count] = {
+    "imu.update",
+    "button.update",
+    "matrix.show",
+    "matrix.anim",
+    "logger",
+    "attitude",
+};
+
+/*
+ * free running tick counter
+ * Cortex-M4: DWT->CYCCNT, one tick per core cycle
+ * native:    std::chrono::steady_clock, one tick per nanosecond
+ */
+struct cycle_counter {
+#if defined(__arm__) && (defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__))
+    static constexpr uint32_t ticks_per_us = F_CPU / 1000000UL;
+
+    static auto begin() -> void {
+        volatile uint32_t* demcr    = reinterpret_cast<volatile uint32_t*>(0xE000EDFC);
+        volatile uint32_t* dwt_ctrl = reinterpret_cast<volatile uint32_t*>(0xE0001000);
+        volatile uint32_t* cyccnt   = reinterpret_cast<volatile uint32_t*>(0xE0001004);
+
+        *demcr |= (1UL << 24); // TRCENA
+        *cyccnt = 0;
+        *dwt_ctrl |= 1UL;      // CYCCNTENA
+    }
+
+    static inline auto now() -> uint32_t {
+        return *reinterpret_cast<volatile uint32_t*>(0xE0001004);
+    }
+#else
+    static constexpr uint32_t ticks_per_us = 1000;
+
+    static auto begin() -> void {}
+
+    static inline auto now() -> uint32_t {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+        return static_cast<uint32_t>(ns.count());
+    }
+#endif
+};
+
+/*
+ * log-linear latency histogram, 4 buckets per power of two
+ * values 0..3 are exact, bucket width grows with the value so the relative
+ * error of every percentile is below 25%, anything above the last bucket is
+ * counted there while max keeps the exact value
+ */
+class histogram {
+    public:
+    static constexpr uint8_t sub_bits    = 2;
+    static constexpr uint8_t bucket_size = 80; // up to 2^21 ticks
+
+    private:
+    uint32_t m_count;
+    uint32_t m_min;
+    uint32_t m_max;
+    uint64_t m_sum;
+    uint32_t m_buckets[bucket_size];
+
+    public:
+    histogram() noexcept { reset(); }
+
+    static constexpr auto bucket_of(uint32_t v) -> uint8_t {
+        if (v < (1u << sub_bits)) return static_cast<uint8_t>(v);
+
+        uint32_t msb = 31 - __builtin_clz(v);
+        uint32_t idx = (msb - sub_bits + 1) * (1u << sub_bits) + ((v >> (msb - sub_bits)) & ((1u << sub_bits) - 1));
+        return idx < bucket_size ? static_cast<uint8_t>(idx) : bucket_size - 1;
+    }
+
+    // largest value that falls into bucket idx
+    static constexpr auto bucket_upper(uint8_t idx) -> uint32_t {
+        if (idx < (1u << sub_bits)) return idx;
+
+        uint32_t msb = idx / (1u << sub_bits) + sub_bits - 1;
+        uint32_t sub = idx % (1u << sub_bits);
+        uint64_t lo  = (uint64_t(1) << msb) + (uint64_t(sub) << (msb - sub_bits));
+        uint64_t hi  = lo + (uint64_t(1) << (msb - sub_bits)) - 1;
+        return hi > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(hi);
+    }
+
+    auto record(uint32_t ticks) -> void {
+        m_count += 1;
+        m_sum += ticks;
+        if (ticks < m_min) m_min = ticks;
+        if (ticks > m_max) m_max = ticks;
+        m_buckets[bucket_of(ticks)] += 1;
+    }
+
+    // upper bound of the bucket holding the given percentile, clamped to max
+    auto percentile(uint8_t pct) const -> uint32_t {
+        if (m_count == 0) return 0;
+
+        uint64_t rank = (uint64_t(m_count) * pct + 99) / 100;
+        uint64_t seen = 0;
+        for (uint8_t i = 0; i < bucket_size; i++) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                uint32_t upper = bucket_upper(i);
+                return upper < m_max ? upper : m_max;
+            }
+        }
+        return m_max;
+    }
+
+    auto reset() -> void {
+        m_count = 0;
+        m_min   = UINT32_MAX;
+        m_max   = 0;
+        m_sum   = 0;
+        for (auto& b : m_buckets) b = 0;
+    }
+
+    auto count() const noexcept -> uint32_t { return m_count; }
+    auto min() const noexcept -> uint32_t { return m_count ? m_min : 0; }
+    auto max() const noexcept -> uint32_t { return m_max; }
+    auto mean() const noexcept -> uint32_t { return m_count ? static_cast<uint32_t>(m_sum / m_count) : 0; }
+    auto bucket(uint8_t idx) const noexcept -> uint32_t { return m_buckets[idx]; }
+};
+
+template <size_t Probes = probe_count>
+class profiler {
+    private:
+    histogram m_hist[Probes];
+
+    public:
+    static constexpr auto size() noexcept -> size_t { return Probes; }
+
+    auto record(uint8_t id, uint32_t ticks) -> void {
+        if (id < Probes) m_hist[id].record(ticks);
+    }
+
+    auto get(uint8_t id) const -> const histogram& { return m_hist[id]; }
+
+    auto reset() -> void {
+        for (auto& h : m_hist) h.reset();
+    }
+
+    /*
+     * Out := Arduino Print or anything with print(const char*) / print(unsigned long)
+     * one summary line per probe, then the non-empty buckets as upper_bound:count
+     * values are in ticks, see cycle_counter::ticks_per_us
+     */
+    template <typename Out>
+    auto dump(Out& out, const char* const* names = prof_names) const -> void {
+        out.print("# probe count min mean p99 max (ticks, ");
+        out.print(static_cast<unsigned long>(cycle_counter::ticks_per_us));
+        out.print(" per us)\n");
+
+        for (uint8_t id = 0; id < Probes; id++) {
+            const histogram& h = m_hist[id];
+            out.print(names ? names[id] : "probe");
+            out.print(" ");
+            out.print(static_cast<unsigned long>(h.count()));
+            out.print(" ");
+            out.print(static_cast<unsigned long>(h.min()));
+            out.print(" ");
+            out.print(static_cast<unsigned long>(h.mean()));
+            out.print(" ");
+            out.print(static_cast<unsigned long>(h.percentile(99)));
+            out.print(" ");
+            out.print(static_cast<unsigned long>(h.max()));
+            out.print("\n ");
+            for (uint8_t i = 0; i < histogram::bucket_size; i++) {
+                if (!h.bucket(i)) continue;
+                out.print(" ");
+                out.print(static_cast<unsigned long>(histogram::bucket_upper(i)));
+                out.print(":");
+                out.print(static_cast<unsigned long>(h.bucket(i)));
+            }
+            out.print("\n");
+        }
+    }
+};
+
+inline auto instance() -> profiler<>& {
+    static profiler<> p;
+    return p;
+}
+
+template <typename Profiler>
+class scoped_probe {
+    private:
+    Profiler& m_prof;
+    uint8_t m_id;
+    uint32_t m_start;
+
+    public:
+    scoped_probe(Profiler& prof, uint8_t id) noexcept
+    : m_prof(prof), m_id(id), m_start(cycle_counter::now()) {}
+
+    scoped_probe(const scoped_probe&)            = delete;
+    scoped_probe& operator=(const scoped_probe&) = delete;
+
+    ~scoped_probe() { m_prof.record(m_id, cycle_counter::now() - m_start); }
+};
+
+} // namespace prof
+
+#define PROF_CONCAT_IMPL(a, b) a##b
+#define PROF_CONCAT(a, b) PROF_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILING
+
+#define PROF_BEGIN() ::prof::cycle_counter::begin()
+#define PROF_SCOPE(id) ::prof::scoped_probe<::prof::profiler<>> PROF_CONCAT(_prof_probe_, __LINE__)(::prof::instance(), id)
+#define PROF_DUMP(out) ::prof::instance().dump(out)
+#define PROF_RESET() ::prof::instance().reset()
+
+#else
+
+#define PROF_BEGIN()
+#define PROF_SCOPE(id)
+#define PROF_DUMP(out)
+#define PROF_RESET()
+
+#endif
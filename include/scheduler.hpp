@@ -0,0 +1,143 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "literals.hpp"
+
+namespace sched {
+
+/*
+ * one entry of the static task table
+ * period_us := release period in microseconds
+ * priority  := 0 is the highest, assign by period for rate-monotonic order
+ */
+struct task {
+    const char* name;
+    void (*fn)();
+    uint32_t period_us;
+    uint8_t priority;
+};
+
+struct task_stats {
+    uint32_t runs;
+    uint32_t overruns;      // execution time longer than the period
+    uint32_t missed;        // releases skipped because a run ended after them, late starts included
+    uint32_t max_jitter_us; // start time - release time
+    uint32_t wcet_us;       // worst-case execution time
+    uint32_t last_exec_us;
+};
+
+/*
+ * cooperative rate-monotonic scheduler over a fixed task table
+ * Clock := type with static now() -> uint32_t in microseconds, may wrap,
+ *          release times are literals::time_us_t so the wrap is handled there
+ * dispatch() runs at most one task, always the highest priority ready one,
+ * so a long low priority task can delay the next release of a high priority
+ * task by at most its own execution time and never starves it
+ */
+template <typename Clock, size_t N>
+class scheduler {
+    static_assert(N > 0, "scheduler needs at least one task");
+
+    private:
+    using time_us_t = literals::time_us_t;
+    using dura_us_t = literals::dura_us_t;
+
+    struct entry {
+        task t;
+        time_us_t next_release;
+        task_stats stats;
+    };
+
+    std::array<entry, N> m_tasks;
+
+    static auto now() -> time_us_t { return time_us_t(Clock::now()); }
+
+    public:
+    explicit scheduler(const std::array<task, N>& table) noexcept {
+        for (size_t i = 0; i < N; i++) m_tasks[i] = entry{ table[i], time_us_t(0), {} };
+
+        // stable insertion sort by priority, dispatch scans in this order
+        for (size_t i = 1; i < N; i++) {
+            entry e = m_tasks[i];
+            size_t j = i;
+            for (; j > 0 && m_tasks[j - 1].t.priority > e.t.priority; j--) m_tasks[j] = m_tasks[j - 1];
+            m_tasks[j] = e;
+        }
+    }
+
+    ~scheduler() noexcept = default;
+
+    static constexpr auto size() noexcept -> size_t { return N; }
+
+    // release every task now
+    auto start() -> void {
+        time_us_t t = now();
+        for (auto& e : m_tasks) e.next_release = t;
+    }
+
+    // run the highest priority ready task, returns false when nothing was ready
+    auto dispatch() -> bool {
+        time_us_t start = now();
+
+        for (auto& e : m_tasks) {
+            if (start < e.next_release) continue;
+
+            uint32_t jitter = static_cast<uint32_t>((start - e.next_release).v);
+
+            e.t.fn();
+
+            time_us_t end = now();
+            uint32_t exec = static_cast<uint32_t>((end - start).v);
+
+            auto& s        = e.stats;
+            s.runs         += 1;
+            s.last_exec_us = exec;
+            if (exec > s.wcet_us) s.wcet_us = exec;
+            if (jitter > s.max_jitter_us) s.max_jitter_us = jitter;
+
+            dura_us_t period(static_cast<int32_t>(e.t.period_us));
+            e.next_release += period;
+            if (exec > e.t.period_us) s.overruns += 1;
+            if (end > e.next_release) {
+                // skip the releases that were missed but keep the phase
+                dura_us_t late  = end - e.next_release;
+                int32_t skipped = late / period + 1;
+                s.missed       += static_cast<uint32_t>(skipped);
+                e.next_release += skipped * period;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // microseconds until the next release, 0 when a task is ready
+    auto idle_time() const -> uint32_t {
+        time_us_t t   = now();
+        uint32_t best = UINT32_MAX;
+        for (auto& e : m_tasks) {
+            if (t >= e.next_release) return 0;
+            uint32_t left = static_cast<uint32_t>((e.next_release - t).v);
+            if (left < best) best = left;
+        }
+        return best;
+    }
+
+    auto get_task(size_t idx) const noexcept -> const task& { return m_tasks[idx].t; }
+    auto get_stats(size_t idx) const noexcept -> const task_stats& { return m_tasks[idx].stats; }
+
+    auto find(void (*fn)()) const noexcept -> size_t {
+        for (size_t i = 0; i < N; i++)
+            if (m_tasks[i].t.fn == fn) return i;
+        return N;
+    }
+
+    auto reset_stats() -> void {
+        for (auto& e : m_tasks) e.stats = {};
+    }
+};
+
+} // namespace sched
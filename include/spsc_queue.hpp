@@ -0,0 +1,178 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+namespace spsc {
+
+/*
+ * fixed capacity single-producer / single-consumer queue, the hand-off
+ * between an interrupt handler and loop() (or two threads natively)
+ *
+ * head and tail are free running 32 bit counters, each written by one side
+ * only, so push and pop are wait-free: no retries, no locks, no disabled
+ * interrupts. The producer publishes a slot with a release store of head
+ * after filling it and the consumer frees it with a release store of tail
+ * after reading it, the matching acquire loads order the slot accesses.
+ * On the Cortex-M4 these are plain word loads and stores plus a DMB.
+ *
+ * each side keeps a copy of the other side's counter and only reloads it
+ * when the copy says full / holds fewer values than asked for, which keeps
+ * the shared cache line quiet on multi-core hosts
+ */
+namespace __details {
+#if defined(__arm__)
+// no data cache on the Cortex-M4, padding would only cost RAM
+constexpr size_t line = alignof(uint32_t);
+#else
+constexpr size_t line = 64;
+#endif
+} // namespace __details
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "queue counters must be lock-free");
+
+// contiguous run of slots, valid until the matching pop(n)
+template <typename T>
+struct span {
+    T* data;
+    size_t size;
+
+    auto begin() const -> T* { return data; }
+    auto end() const -> T* { return data + size; }
+    auto empty() const -> bool { return size == 0; }
+    auto operator[](size_t i) const -> T& { return data[i]; }
+};
+
+template <typename T, size_t Capacity>
+class queue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(Capacity <= (size_t(1) << 31), "capacity must fit the 32 bit counters");
+
+    static constexpr uint32_t mask = Capacity - 1;
+
+    private:
+    // 主机上为生产者独占的缓存行，ARM 上不填充
+    alignas(__details::line) std::atomic<uint32_t> m_head; // next slot to write
+    uint32_t m_tail_cache;
+    // 主机上为消费者独占的缓存行，ARM 上不填充
+    alignas(__details::line) std::atomic<uint32_t> m_tail; // next slot to read
+    uint32_t m_head_cache;
+
+    // alignas 不能低于 T 本身的对齐
+    alignas(__details::line > alignof(T) ? __details::line : alignof(T)) T m_slots[Capacity];
+
+    // producer: free slots, reloads tail only when the cached value says full
+    auto free_slots() -> uint32_t {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        uint32_t n    = Capacity - (head - m_tail_cache);
+        if (n == 0) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            n            = Capacity - (head - m_tail_cache);
+        }
+        return n;
+    }
+
+    // consumer: filled slots, reloads head only when the cached value has fewer than want
+    auto filled_slots(size_t want = 1) -> uint32_t {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        uint32_t n    = m_head_cache - tail;
+        if (n < want) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            n            = m_head_cache - tail;
+        }
+        return n;
+    }
+
+    public:
+    queue() noexcept : m_head(0), m_tail_cache(0), m_tail(0), m_head_cache(0) {}
+
+    queue(const queue&)                    = delete;
+    auto operator=(const queue&) -> queue& = delete;
+
+    static constexpr auto capacity() noexcept -> size_t { return Capacity; }
+
+    /* ---- producer ---- */
+
+    // false when full, the value is not queued
+    auto push(const T& v) -> bool {
+        T* slot = reserve();
+        if (!slot) return false;
+        *slot = v;
+        commit();
+        return true;
+    }
+
+    // slot to fill in place, nullptr when full, publish it with commit()
+    auto reserve() -> T* {
+        if (free_slots() == 0) return nullptr;
+        return &m_slots[m_head.load(std::memory_order_relaxed) & mask];
+    }
+
+    auto commit() -> void {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /* ---- consumer ---- */
+
+    // false when empty
+    auto pop(T& v) -> bool {
+        T* slot = front();
+        if (!slot) return false;
+        v = *slot;
+        pop();
+        return true;
+    }
+
+    // oldest value, nullptr when empty, release it with pop()
+    auto front() -> T* {
+        if (filled_slots() == 0) return nullptr;
+        return &m_slots[m_tail.load(std::memory_order_relaxed) & mask];
+    }
+
+    auto pop() -> void { pop(1); }
+
+    // releases the n oldest values, n must not exceed what front_span / size reported
+    auto pop(size_t n) -> void {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + static_cast<uint32_t>(n), std::memory_order_release);
+    }
+
+    // the oldest values up to the end of the buffer, read them in place then pop(n)
+    auto front_span(size_t max = Capacity) -> span<T> {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t run    = Capacity - (tail & mask);
+        if (max > run) max = run;
+        size_t n = filled_slots(max);
+        if (n > max) n = max;
+        return { &m_slots[tail & mask], n };
+    }
+
+    // copies up to max values into dst across the wrap and frees them with one store
+    auto pop_span(T* dst, size_t max) -> size_t {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t n      = filled_slots(max < Capacity ? max : Capacity);
+        if (n > max) n = max;
+
+        size_t first = Capacity - (tail & mask);
+        if (first > n) first = n;
+        const T* src = &m_slots[tail & mask];
+        for (size_t i = 0; i < first; i++) dst[i] = src[i];
+        for (size_t i = first; i < n; i++) dst[i] = m_slots[i - first];
+
+        if (n) pop(n);
+        return n;
+    }
+
+    /* ---- either side, a snapshot that may be stale by the time it is used ---- */
+
+    auto size() const -> size_t {
+        uint32_t tail = m_tail.load(std::memory_order_acquire);
+        uint32_t n    = m_head.load(std::memory_order_acquire) - tail;
+        return n < Capacity ? n : Capacity;
+    }
+
+    auto empty() const -> bool { return size() == 0; }
+};
+
+} // namespace spsc
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * binary sensor trace, streamed over the serial port while recording and
+ * replayed natively, see utils/trace_tool.py for capturing it to a file
+ *
+ * record  := sync:u8 type:u8 dt:u16 payload sum:u8       little endian
+ * sync    := 0xA5
+ * dt      := microseconds since the previous record
+ * sum     := 8 bit sum of type, dt and payload
+ *
+ * type    payload
+ * start   version:u8                      time restarts at 0
+ * stamp   t_us:u32                        time since start, when dt would not fit
+ * imu     x:i16 y:i16 z:i16               a sample the filter stepped on, 1/8192 g
+ * reset   x:i16 y:i16 z:i16               a sample the filter was reset with
+ * state   v:f32 x 10                      filter state when recording starts mid-run
+ * buttons mask:u8                         bit 0 'A', bit 1 'B', bit 2 'C', on change
+ * knob    value:i16 pressed:u8            on change
+ *
+ * sync and sum let the reader skip log text or bytes lost in between
+ */
+namespace trace {
+
+constexpr uint8_t sync    = 0xA5;
+constexpr uint8_t version = 2;
+
+constexpr float acc_lsb = 1.0f / 8192; // ±4 g in an int16
+
+// floats in a state record, see app::motion::save
+constexpr size_t state_values = 10;
+
+enum type : uint8_t {
+    start   = 's',
+    stamp   = 't',
+    imu     = 'i',
+    reset   = 'r',
+    state   = 'm',
+    buttons = 'b',
+    knob    = 'k',
+};
+
+// payload bytes of a record type, 0 when the type is unknown
+constexpr auto payload_size(uint8_t t) -> uint8_t {
+    switch (t) {
+    case start: return 1;
+    case stamp: return 4;
+    case imu:
+    case reset: return 6;
+    case state: return state_values * 4;
+    case buttons: return 1;
+    case knob: return 3;
+    default: return 0;
+    }
+}
+
+constexpr size_t header_size = 4;
+constexpr size_t max_record  = header_size + state_values * 4 + 1;
+
+inline auto to_raw(float g) -> int16_t {
+    float v = g / acc_lsb;
+    v       = v < -32768.0f ? -32768.0f : v > 32767.0f ? 32767.0f : v;
+    return static_cast<int16_t>(v < 0 ? v - 0.5f : v + 0.5f);
+}
+
+inline auto to_g(int16_t raw) -> float {
+    return raw * acc_lsb;
+}
+
+/*
+ * encoder into a byte sink with write(const char*, size_t), a hal::serial on the board
+ * a record is assembled on the stack and written with one call
+ */
+template <typename Sink>
+class writer {
+    private:
+    Sink m_sink;
+    uint32_t m_origin; // time of the start record
+    uint32_t m_last;   // time of the previous record
+    uint8_t m_buttons; // last recorded states, only changes are written
+    int16_t m_knob;
+    bool m_knob_pressed;
+    bool m_knob_valid;
+    bool m_active;
+
+    auto put16(uint8_t* p, uint16_t v) -> void {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    auto put32(uint8_t* p, uint32_t v) -> void {
+        put16(p, static_cast<uint16_t>(v));
+        put16(p + 2, static_cast<uint16_t>(v >> 16));
+    }
+
+    auto emit(uint32_t now_us, uint8_t t, const uint8_t* payload) -> void {
+        uint32_t dt = now_us - m_last;
+        if (dt > 0xFFFF && t != stamp) {
+            uint32_t since = now_us - m_origin;
+            uint8_t abs[4] = { static_cast<uint8_t>(since), static_cast<uint8_t>(since >> 8),
+                               static_cast<uint8_t>(since >> 16), static_cast<uint8_t>(since >> 24) };
+            emit(now_us, stamp, abs);
+            dt = 0;
+        }
+        m_last = now_us;
+
+        uint8_t rec[max_record];
+        uint8_t n = payload_size(t);
+        rec[0]    = sync;
+        rec[1]    = t;
+        put16(rec + 2, t == stamp ? 0 : static_cast<uint16_t>(dt));
+        for (uint8_t i = 0; i < n; i++) rec[header_size + i] = payload[i];
+
+        uint8_t sum = 0;
+        for (uint8_t i = 1; i < header_size + n; i++) sum += rec[i];
+        rec[header_size + n] = sum;
+
+        m_sink.write(reinterpret_cast<const char*>(rec), header_size + n + 1);
+    }
+
+    auto emit_xyz(uint32_t now_us, uint8_t t, float x, float y, float z) -> void {
+        uint8_t p[6];
+        put16(p, static_cast<uint16_t>(to_raw(x)));
+        put16(p + 2, static_cast<uint16_t>(to_raw(y)));
+        put16(p + 4, static_cast<uint16_t>(to_raw(z)));
+        emit(now_us, t, p);
+    }
+
+    public:
+    writer() noexcept
+    : m_origin(0), m_last(0), m_buttons(0), m_knob(0), m_knob_pressed(false), m_knob_valid(false), m_active(false) {}
+
+    // start record at now_us, the first button and knob samples are always written
+    auto begin(uint32_t now_us) -> void {
+        m_active     = true;
+        m_origin     = now_us;
+        m_last       = now_us;
+        m_buttons    = 0xFF;
+        m_knob_valid = false;
+        uint8_t v    = version;
+        emit(now_us, start, &v);
+    }
+
+    auto end() -> void { m_active = false; }
+    auto active() const -> bool { return m_active; }
+
+    auto sample_imu(uint32_t now_us, float x, float y, float z) -> void {
+        if (m_active) emit_xyz(now_us, imu, x, y, z);
+    }
+
+    auto sample_reset(uint32_t now_us, float x, float y, float z) -> void {
+        if (m_active) emit_xyz(now_us, reset, x, y, z);
+    }
+
+    // v holds state_values floats
+    auto sample_state(uint32_t now_us, const float* v) -> void {
+        if (!m_active) return;
+        uint8_t p[state_values * 4];
+        for (size_t i = 0; i < state_values; i++) {
+            uint32_t bits;
+            memcpy(&bits, &v[i], 4);
+            put32(p + 4 * i, bits);
+        }
+        emit(now_us, state, p);
+    }
+
+    auto sample_buttons(uint32_t now_us, uint8_t mask) -> void {
+        if (!m_active || mask == m_buttons) return;
+        m_buttons = mask;
+        emit(now_us, buttons, &mask);
+    }
+
+    auto sample_knob(uint32_t now_us, int16_t value, bool pressed) -> void {
+        if (!m_active || (m_knob_valid && value == m_knob && pressed == m_knob_pressed)) return;
+        m_knob         = value;
+        m_knob_pressed = pressed;
+        m_knob_valid   = true;
+        uint8_t p[3];
+        put16(p, static_cast<uint16_t>(value));
+        p[2] = pressed;
+        emit(now_us, knob, p);
+    }
+
+    auto sink() -> Sink& { return m_sink; }
+};
+
+// one decoded record, time is reconstructed from the dt chain
+struct record {
+    uint8_t type;
+    uint32_t t_us;
+    union {
+        struct {
+            float x, y, z;
+        } acc;
+        float state[state_values];
+        uint8_t buttons;
+        struct {
+            int16_t value;
+            bool pressed;
+        } knob;
+        uint8_t version;
+    };
+};
+
+/*
+ * sequential decoder over a captured byte buffer
+ * bytes that do not form a valid record are skipped one at a time
+ */
+class reader {
+    private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos;
+    uint32_t m_now;
+    uint32_t m_skipped;
+
+    static auto get16(const uint8_t* p) -> uint16_t { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+
+    public:
+    reader(const uint8_t* data, size_t size) noexcept : m_data(data), m_size(size), m_pos(0), m_now(0), m_skipped(0) {}
+
+    // false at the end of the buffer
+    auto next(record& r) -> bool {
+        while (m_pos + header_size < m_size) {
+            const uint8_t* p = m_data + m_pos;
+            uint8_t n        = payload_size(p[1]);
+            if (p[0] != sync || !n || m_pos + header_size + n >= m_size) {
+                m_pos++;
+                m_skipped++;
+                continue;
+            }
+
+            uint8_t sum = 0;
+            for (uint8_t i = 1; i < header_size + n; i++) sum += p[i];
+            if (sum != p[header_size + n]) {
+                m_pos++;
+                m_skipped++;
+                continue;
+            }
+            m_pos += header_size + n + 1;
+
+            const uint8_t* q = p + header_size;
+            r.type           = p[1];
+            switch (p[1]) {
+            case start:
+                m_now     = 0;
+                r.version = q[0];
+                break;
+            case stamp: m_now = get16(q) | uint32_t(get16(q + 2)) << 16; break;
+            case imu:
+            case reset:
+                m_now += get16(p + 2);
+                r.acc.x = to_g(static_cast<int16_t>(get16(q)));
+                r.acc.y = to_g(static_cast<int16_t>(get16(q + 2)));
+                r.acc.z = to_g(static_cast<int16_t>(get16(q + 4)));
+                break;
+            case state:
+                m_now += get16(p + 2);
+                for (size_t i = 0; i < state_values; i++) {
+                    uint32_t bits = get16(q + 4 * i) | uint32_t(get16(q + 4 * i + 2)) << 16;
+                    memcpy(&r.state[i], &bits, 4);
+                }
+                break;
+            case buttons:
+                m_now += get16(p + 2);
+                r.buttons = q[0];
+                break;
+            case knob:
+                m_now += get16(p + 2);
+                r.knob.value   = static_cast<int16_t>(get16(q));
+                r.knob.pressed = q[2] != 0;
+                break;
+            }
+            r.t_us = m_now;
+            return true;
+        }
+        m_skipped += m_size - m_pos;
+        m_pos = m_size;
+        return false;
+    }
+
+    auto rewind() -> void {
+        m_pos     = 0;
+        m_now     = 0;
+        m_skipped = 0;
+    }
+
+    // bytes that were not part of a valid record
+    auto skipped() const -> uint32_t { return m_skipped; }
+};
+
+/*
+ * feed every record of a trace to a handler, as fast as the host allows
+ * Handler := on_imu(const record&), on_reset(const record&), on_state(const record&),
+ *            on_buttons(const record&), on_knob(const record&)
+ * returns the number of records delivered
+ */
+template <typename Handler>
+auto replay(reader& rd, Handler& h) -> uint32_t {
+    uint32_t n = 0;
+    record r;
+    while (rd.next(r)) {
+        switch (r.type) {
+        case imu: h.on_imu(r); break;
+        case reset: h.on_reset(r); break;
+        case state: h.on_state(r); break;
+        case buttons: h.on_buttons(r); break;
+        case knob: h.on_knob(r); break;
+        default: break;
+        }
+        n++;
+    }
+    return n;
+}
+
+} // namespace trace
@@ -0,0 +1,60 @@
+// test/bench.hpp
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+
+#include <unity.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber() {
+    asm volatile("" : : : "memory");
+}
+
+inline auto cycles() -> uint64_t {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct result {
+    double ns_per_op;
+    double cycles_per_op;
+};
+
+// 运行 fn(i) iterations 次并通过 TEST_MESSAGE 输出每次调用的平均耗时
+template <typename F>
+auto run(const char* name, uint32_t iterations, F&& fn) -> result {
+    for (uint32_t i = 0; i < iterations / 16; i++) fn(i); // 预热
+
+    auto     t0 = std::chrono::steady_clock::now();
+    uint64_t c0 = cycles();
+    for (uint32_t i = 0; i < iterations; i++) fn(i);
+    uint64_t c1 = cycles();
+    auto     t1 = std::chrono::steady_clock::now();
+
+    result r;
+    r.ns_per_op     = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    r.cycles_per_op = static_cast<double>(c1 - c0) / iterations;
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%-36s %9.2f ns/op %9.1f cyc/op", name, r.ns_per_op, r.cycles_per_op);
+    TEST_MESSAGE(msg);
+    return r;
+}
+
+} // namespace bench
@@ -0,0 +1,358 @@
+// test/test_app/test_app.cpp
+#include "app.hpp"
+#include "hal_host.hpp"
+#include "scheduler.hpp"
+#include <unity.h>
+
+#include <math.h>
+
+#include <array>
+
+using namespace app;
+using host_app = application<hal::host>;
+
+static host_app* g_app = nullptr;
+
+void setUp(void) {
+    hal::host_clock::set(0);
+}
+
+void tearDown(void) {
+    g_app = nullptr;
+}
+
+// 与 main.cpp 相同的任务表，时钟换成可手动推进的 host_clock
+static auto make_scheduler() -> sched::scheduler<hal::host_clock, 7> {
+    return sched::scheduler<hal::host_clock, 7>({ {
+        { "imu", [] { g_app->imu_task(); }, imu_period_us, 0 },
+        { "wheel", [] { g_app->wheel_task(); }, wheel_period_us, 1 },
+        { "anim", [] { g_app->anim_task(); }, anim_period_us, 2 },
+        { "input", [] { g_app->input_task(); }, input_period_us, 3 },
+        { "display", [] { g_app->display_task(); }, display_period_us, 4 },
+        { "pixel", [] { g_app->pixel_task(); }, pixel_period_us, 5 },
+        { "telemetry", [] { g_app->telemetry_task(); }, telemetry_period_us, 6 },
+    } });
+}
+
+// 以 1 ms 步长推进时间，每步运行所有就绪任务
+template <typename S>
+static auto run_for(S& s, uint32_t ms) -> void {
+    for (uint32_t i = 0; i < ms; i++) {
+        while (s.dispatch()) {
+        }
+        hal::host_clock::advance(1000);
+    }
+}
+
+static auto digits_frame(int32_t val) -> std::array<uint32_t, 3> {
+    uint8_t d[4];
+    led::split_digits(val, 10, d);
+    uint32_t f[led::words] = { 0, 0, 0 };
+    led::draw_digits(f, d[0], d[1], d[2], d[3]);
+    return { f[0], f[1], f[2] };
+}
+
+static auto line_frame(int y) -> std::array<uint32_t, 3> {
+    uint32_t f[led::words] = { 0, 0, 0 };
+    led::hline(f, 0, led::width - 1, y);
+    return { f[0], f[1], f[2] };
+}
+
+void test_boot(void) {
+    host_app a;
+    g_app   = &a;
+    auto s  = make_scheduler();
+    auto& m = a.matrix().device();
+
+    a.begin();
+    s.start();
+    TEST_ASSERT_TRUE(m.begun());
+    TEST_ASSERT_TRUE(a.matrix().animating());
+
+    // 开机动画播放完后恢复空白的后台缓冲
+    run_for(s, 5000);
+    TEST_ASSERT_FALSE(a.matrix().animating());
+    TEST_ASSERT_GREATER_THAN(1, m.frames().size());
+    TEST_ASSERT_EQUAL_HEX32(0, m.last()[0] | m.last()[1] | m.last()[2]);
+    TEST_ASSERT_TRUE(a.state() == WorkState::IDLE);
+}
+
+void test_knob_mode(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'A', true },
+        { 200, 'A', false },
+    };
+    static const hal::host_knob::event knob[] = {
+        { 0, 42, false },
+        { 2000, -5, false },
+        { 3000, 20000, false },
+        { 4000, 123, true },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+    a.knob().play(knob);
+    s.start();
+
+    run_for(s, 150);
+    TEST_ASSERT_TRUE(a.state() == WorkState::SHOW_KNOB);
+    TEST_ASSERT_TRUE(a.matrix().animating());
+
+    // 闪烁结束后显示旋钮数值
+    run_for(s, 1750);
+    TEST_ASSERT_FALSE(a.matrix().animating());
+    TEST_ASSERT_TRUE(digits_frame(42) == a.matrix().device().last());
+
+    run_for(s, 1000);
+    TEST_ASSERT_TRUE(digits_frame(-5) == a.matrix().device().last());
+
+    // 超出范围时旋钮被夹回 9999
+    run_for(s, 1000);
+    TEST_ASSERT_EQUAL_INT16(9999, a.knob().get());
+    TEST_ASSERT_TRUE(digits_frame(9999) == a.matrix().device().last());
+
+    // 按下旋钮归零，显示保持不变
+    size_t n = a.matrix().device().frames().size();
+    run_for(s, 500);
+    TEST_ASSERT_EQUAL_INT16(0, a.knob().get());
+    TEST_ASSERT_EQUAL(n, a.matrix().device().frames().size());
+}
+
+void test_imu_mode(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'B', true },
+        { 200, 'B', false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+
+    // 0.5 s 后沿 y 方向 1.5 g 加速 0.5 s
+    a.imu().source([](uint32_t t_us, float* xyz, void*) {
+        xyz[0] = 0.0f;
+        xyz[1] = t_us >= 500000 && t_us < 1000000 ? 1.5f : 0.0f;
+        xyz[2] = 1.0f;
+    });
+    s.start();
+
+    run_for(s, 400);
+    TEST_ASSERT_TRUE(a.state() == WorkState::SHOW_IMU);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, a.kinematics().pos_y);
+
+    run_for(s, 1600);
+    const motion& k = a.kinematics();
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.2f, k.pos_y);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, k.pos_x);
+
+    // 水平线所在行跟随位置
+    int row = static_cast<int>(k.pos_y * position_scale);
+    TEST_ASSERT_GREATER_THAN(0, row);
+    run_for(s, 100);
+    row = static_cast<int>(a.kinematics().pos_y * position_scale);
+    TEST_ASSERT_TRUE(line_frame(row) == a.matrix().device().last());
+}
+
+// 位置在 (-1, 0) 行之间时向下取整到 -1 行，矩阵外不显示，而不是截断到第 0 行
+void test_imu_row_floor(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'B', true },
+        { 200, 'B', false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+
+    // 沿 -y 方向短暂加速，停在 -1 行与第 0 行之间
+    a.imu().source([](uint32_t t_us, float* xyz, void*) {
+        xyz[0] = 0.0f;
+        xyz[1] = t_us >= 500000 && t_us < 700000 ? -0.5f : 0.0f;
+        xyz[2] = 1.0f;
+    });
+    s.start();
+
+    run_for(s, 2000);
+    float y = a.kinematics().pos_y * position_scale;
+    TEST_ASSERT_TRUE(y > -1.0f && y < 0.0f);
+    run_for(s, 100);
+    auto f  = a.matrix().device().last();
+    TEST_ASSERT_EQUAL_HEX32(0, f[0] | f[1] | f[2]);
+}
+
+// 只在 SHOW_IMU 中打开传感器 FIFO，进入时以第一个新样本重置，不会从积压的旧数据开始
+void test_imu_stream(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'B', true },
+        { 140, 'B', false },
+        { 1000, 'A', true },
+        { 1040, 'A', false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.begin();
+    a.buttons().play(buttons);
+    a.imu().period(imu_period_us);
+
+    // 进入模式之前的读数与之后不同，偏移初值只能来自之后的样本
+    a.imu().source([](uint32_t t_us, float* xyz, void*) {
+        xyz[0] = 0.0f;
+        xyz[1] = t_us < 100000 ? -0.5f : 0.25f;
+        xyz[2] = 1.0f;
+    });
+    s.start();
+
+    run_for(s, 90);
+    TEST_ASSERT_FALSE(a.imu().streaming());
+    TEST_ASSERT_EQUAL_UINT32(0, a.imu().updates());
+
+    run_for(s, 800);
+    TEST_ASSERT_TRUE(a.state() == WorkState::SHOW_IMU);
+    TEST_ASSERT_TRUE(a.imu().streaming());
+    TEST_ASSERT_GREATER_THAN(100, a.imu().updates());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, a.kinematics().pos_y);
+
+    run_for(s, 200);
+    TEST_ASSERT_TRUE(a.state() == WorkState::SHOW_KNOB);
+    TEST_ASSERT_FALSE(a.imu().streaming());
+    uint32_t n = a.imu().updates();
+    run_for(s, 500);
+    TEST_ASSERT_EQUAL_UINT32(n, a.imu().updates());
+}
+
+void test_tilt(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'B', true },
+        { 200, 'B', false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+
+    // 以 0.5 rad/s 低头 1 s 后保持静止，加速度计给出对应的重力方向
+    a.imu().source([](uint32_t t_us, float* v, void*) {
+        float t     = fminf(t_us / 1000000.0f, 1.0f);
+        float pitch = 0.5f * t;
+        v[0]        = -sinf(pitch);
+        v[2]        = cosf(pitch);
+        v[4]        = t_us < 1000000 ? 0.5f : 0.0f;
+    });
+    s.start();
+
+    run_for(s, 500);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.25f, a.tilt().pitch());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, a.tilt().pitch_rate());
+
+    run_for(s, 1500);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, a.tilt().pitch());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, a.tilt().pitch_rate());
+}
+
+void test_wheel_speed(void) {
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    s.start();
+
+    // 左轮每 2 ms 前进一个计数（M 法），右轮每 25 ms 后退一个计数（T 法）
+    for (uint32_t ms = 1; ms <= 1000; ms++) {
+        if (ms % 2 == 0) a.encoders().edge(enc::left, true);
+        if (ms % 25 == 0) a.encoders().edge(enc::right, false);
+        while (s.dispatch()) {
+        }
+        hal::host_clock::advance(1000);
+    }
+    double per_count = wheel_config.per_count.v;
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 500 * per_count, a.wheel_speed(enc::left).v);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, -40 * per_count, a.wheel_speed(enc::right).v);
+
+    // 停转后逐渐衰减，超时后为 0
+    run_for(s, 100);
+    TEST_ASSERT_TRUE(a.wheel_speed(enc::left).v < 0.2 * 500 * per_count);
+    run_for(s, 200);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, a.wheel_speed(enc::left).v);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, a.wheel_speed(enc::right).v);
+}
+
+void test_pixel_mode(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'C', true },
+        { 200, 'C', false },
+    };
+    static const hal::host_knob::event knob[] = {
+        { 0, 500, false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+    a.knob().play(knob);
+    s.start();
+
+    // 亮度被夹到 0..100，四步依次点亮 8 个像素，第五步清空
+    run_for(s, 150 + 4 * pixel_period_us / 1000);
+    TEST_ASSERT_TRUE(a.state() == WorkState::PIXEL_TEST);
+    TEST_ASSERT_EQUAL_INT16(100, a.knob().get());
+    for (int i = 0; i < hal::host_pixels::count; i++) {
+        TEST_ASSERT_EQUAL_UINT8(100, a.pixels().shown(i).brightness);
+    }
+
+    run_for(s, pixel_period_us / 1000);
+    TEST_ASSERT_EQUAL_UINT8(0, a.pixels().shown(0).brightness);
+}
+
+void test_mode_switch(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'A', true },
+        { 140, 'A', false },
+        { 1000, 'B', true },
+        { 1040, 'B', false },
+        { 2000, 'C', true },
+        { 2040, 'C', false },
+        { 3000, 'C', true },
+        { 3040, 'C', false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+    s.start();
+
+    run_for(s, 500);
+    TEST_ASSERT_TRUE(a.state() == WorkState::SHOW_KNOB);
+    run_for(s, 1000);
+    TEST_ASSERT_TRUE(a.state() == WorkState::SHOW_IMU);
+    run_for(s, 1000);
+    TEST_ASSERT_TRUE(a.state() == WorkState::PIXEL_TEST);
+
+    // 再次按下当前模式的按键不会重新闪烁
+    run_for(s, 800);
+    TEST_ASSERT_FALSE(a.matrix().animating());
+    run_for(s, 100);
+    TEST_ASSERT_FALSE(a.matrix().animating());
+    TEST_ASSERT_TRUE(a.state() == WorkState::PIXEL_TEST);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_boot);
+    RUN_TEST(test_knob_mode);
+    RUN_TEST(test_imu_mode);
+    RUN_TEST(test_imu_row_floor);
+    RUN_TEST(test_imu_stream);
+    RUN_TEST(test_tilt);
+    RUN_TEST(test_wheel_speed);
+    RUN_TEST(test_pixel_mode);
+    RUN_TEST(test_mode_switch);
+    return UNITY_END();
+}
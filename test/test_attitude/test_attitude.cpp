@@ -0,0 +1,223 @@
+// test/test_attitude/test_attitude.cpp
+#include "attitude.hpp"
+#include <unity.h>
+
+#include <math.h>
+
+using namespace att;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr float rate_hz = 200.0f;
+static constexpr float dt      = 1.0f / rate_hz;
+static constexpr float pi      = 3.14159265f;
+
+/*
+ * 合成运动：俯仰角 pitch(t)、横滚角 roll(t) 已知，
+ * 由真值生成加速度计与陀螺仪读数，再叠加偏置、噪声与线加速度
+ */
+struct scenario {
+    float pitch_amp  = 0.0f; // rad
+    float pitch_hz   = 0.5f;
+    float pitch_bias = 0.0f; // 静态俯仰角
+    float roll_amp   = 0.0f;
+    float roll_hz    = 0.3f;
+    float gyro_bias  = 0.0f; // rad/s，加在 y 轴
+    float acc_noise  = 0.0f; // g
+    float gyro_noise = 0.0f; // rad/s
+    float bump       = 0.0f; // 每 2 s 一次 0.1 s 的前向加速度 (g)
+
+    uint32_t seed = 12345;
+
+    auto noise(float amp) -> float {
+        seed = seed * 1664525u + 1013904223u;
+        return ((seed >> 8) / 16777216.0f * 2.0f - 1.0f) * amp;
+    }
+
+    auto pitch(float t) const -> float { return pitch_bias + pitch_amp * sinf(2 * pi * pitch_hz * t); }
+    auto pitch_rate(float t) const -> float { return pitch_amp * 2 * pi * pitch_hz * cosf(2 * pi * pitch_hz * t); }
+    auto roll(float t) const -> float { return roll_amp * sinf(2 * pi * roll_hz * t); }
+    auto roll_rate(float t) const -> float { return roll_amp * 2 * pi * roll_hz * cosf(2 * pi * roll_hz * t); }
+
+    auto at(float t) -> sample {
+        float th = pitch(t), ph = roll(t);
+
+        // 世界坐标系的重力方向在机体坐标系中的投影 (ZYX，偏航为 0)
+        sample s;
+        s.ax = -sinf(th) + noise(acc_noise);
+        s.ay = cosf(th) * sinf(ph) + noise(acc_noise);
+        s.az = cosf(th) * cosf(ph) + noise(acc_noise);
+        if (bump > 0.0f && fmodf(t, 2.0f) > 1.0f && fmodf(t, 2.0f) < 1.1f) s.ax += bump;
+
+        // 仅单轴运动时机体角速度即为欧拉角速度
+        s.gx = roll_rate(t) + noise(gyro_noise);
+        s.gy = pitch_rate(t) + gyro_bias + noise(gyro_noise);
+        s.gz = noise(gyro_noise);
+        return s;
+    }
+};
+
+struct error_stats {
+    float rms;
+    float max;
+};
+
+// 运行 seconds 秒，忽略前 settle 秒，统计俯仰角误差
+template <typename Estimator>
+static auto run(Estimator& e, scenario& sc, float seconds, float settle) -> error_stats {
+    double sum = 0;
+    float max  = 0;
+    int n      = 0;
+    int steps  = static_cast<int>(seconds * rate_hz);
+    for (int i = 0; i < steps; i++) {
+        float t = i * dt;
+        e.update(sc.at(t));
+        if (t < settle) continue;
+        float err = e.pitch() - sc.pitch(t + dt);
+        sum += double(err) * err;
+        max = fmaxf(max, fabsf(err));
+        n++;
+    }
+    return { static_cast<float>(sqrt(sum / n)), max };
+}
+
+void test_static_tilt(void) {
+    scenario sc;
+    sc.pitch_bias = 0.3f;
+
+    complementary c(rate_hz, 0.5f);
+    mahony m(rate_hz, 2.0f, 0.1f);
+    kalman k(rate_hz, 0.001f, 0.003f, 0.3f);
+
+    // 第一个样本即对齐到加速度计角度
+    c.update(sc.at(0));
+    m.update(sc.at(0));
+    k.update(sc.at(0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.3f, c.pitch());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.3f, m.pitch());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.3f, k.pitch());
+
+    auto ec = run(c, sc, 5, 0);
+    auto em = run(m, sc, 5, 0);
+    auto ek = run(k, sc, 5, 0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, ec.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, em.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, ek.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, c.pitch_rate());
+}
+
+void test_tracking_with_noise(void) {
+    scenario sc;
+    sc.pitch_amp  = 0.5f;
+    sc.acc_noise  = 0.05f;
+    sc.gyro_noise = 0.02f;
+
+    complementary c(rate_hz, 0.5f);
+    mahony m(rate_hz, 1.0f, 0.0f);
+    kalman k(rate_hz, 0.001f, 0.003f, 0.3f);
+
+    auto ec = run(c, sc, 20, 2);
+    auto em = run(m, sc, 20, 2);
+    auto ek = run(k, sc, 20, 2);
+
+    // 约 1 度以内
+    TEST_ASSERT_LESS_THAN_FLOAT(0.02f, ec.rms);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.02f, em.rms);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.02f, ek.rms);
+
+    // 角速度输出即为陀螺仪读数（减去偏置估计）
+    float t = 20.0f;
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, sc.pitch_rate(t), c.pitch_rate());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, sc.pitch_rate(t), m.pitch_rate());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, sc.pitch_rate(t), k.pitch_rate());
+}
+
+void test_gyro_bias(void) {
+    scenario sc;
+    sc.pitch_amp  = 0.3f;
+    sc.gyro_bias  = 0.05f;
+    sc.acc_noise  = 0.02f;
+    sc.gyro_noise = 0.01f;
+
+    complementary c(rate_hz, 0.5f);
+    mahony m(rate_hz, 1.0f, 0.2f);
+    kalman k(rate_hz, 0.001f, 0.003f, 0.3f);
+
+    auto ec = run(c, sc, 60, 30);
+    auto em = run(m, sc, 60, 30);
+    auto ek = run(k, sc, 60, 30);
+
+    // 互补滤波的稳态误差约为 bias * tau，另外两种估计并扣除偏置
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.05f * 0.5f, ec.rms);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.01f, em.rms);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.01f, ek.rms);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.05f, m.gyro_bias_y());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.05f, k.gyro_bias_y());
+}
+
+void test_linear_acceleration(void) {
+    scenario sc;
+    sc.pitch_amp = 0.2f;
+    sc.bump      = 0.5f;
+
+    // 只用加速度计时 0.5 g 的冲击约为 0.46 rad 的误差
+    sample s = sc.at(1.05f);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.3f, fabsf(accel_pitch(s) - sc.pitch(1.05f)));
+
+    complementary c(rate_hz, 0.5f);
+    mahony m(rate_hz, 1.0f, 0.0f);
+    kalman k(rate_hz, 0.001f, 0.003f, 0.3f);
+
+    auto ec = run(c, sc, 10, 0.5f);
+    auto em = run(m, sc, 10, 0.5f);
+    auto ek = run(k, sc, 10, 0.5f);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.1f, ec.max);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.1f, em.max);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.1f, ek.max);
+}
+
+void test_mahony_roll(void) {
+    scenario sc;
+    sc.roll_amp   = 0.6f;
+    sc.acc_noise  = 0.02f;
+    sc.gyro_noise = 0.01f;
+
+    mahony m(rate_hz, 1.0f, 0.0f);
+    float max = 0;
+    for (int i = 0; i < 10 * rate_hz; i++) {
+        float t = i * dt;
+        m.update(sc.at(t));
+        if (t > 1.0f) max = fmaxf(max, fabsf(m.roll() - sc.roll(t + dt)));
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(0.03f, max);
+    TEST_ASSERT_FLOAT_WITHIN(0.03f, 0.0f, m.pitch());
+}
+
+void test_reset(void) {
+    scenario sc;
+    sc.pitch_bias = -0.4f;
+
+    kalman k(rate_hz, 0.001f, 0.003f, 0.3f);
+    run(k, sc, 1, 0);
+    k.reset();
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, k.pitch());
+
+    sc.pitch_bias = 0.2f;
+    k.update(sc.at(0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.2f, k.pitch());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_static_tilt);
+    RUN_TEST(test_tracking_with_noise);
+    RUN_TEST(test_gyro_bias);
+    RUN_TEST(test_linear_acceleration);
+    RUN_TEST(test_mahony_roll);
+    RUN_TEST(test_reset);
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+// test/test_bench_app/test_bench_app.cpp
+#include "../bench.hpp"
+#include "app.hpp"
+#include "hal_host.hpp"
+#include "scheduler.hpp"
+#include <unity.h>
+
+using namespace app;
+
+void setUp(void) {
+    hal::host_clock::set(0);
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+
+// 只记录最后一帧的后端，用来衡量 LED_Matrix 本身的开销
+class null_matrix : public hal::matrix<null_matrix> {
+    friend class hal::matrix<null_matrix>;
+
+    private:
+    auto begin_impl() -> void {}
+    auto load_impl(const uint32_t* words) -> void { last = words[0] ^ words[1] ^ words[2]; }
+    auto clear_impl() -> void {}
+
+    public:
+    uint32_t last = 0;
+};
+
+void test_bench_matrix(void) {
+    basic_led_matrix<null_matrix> m;
+
+    auto p = bench::run("print(int) changing", iterations, [&](uint32_t i) {
+        m.print(static_cast<int32_t>(i % 10000));
+    });
+    auto s = bench::run("print(int) unchanged", iterations, [&](uint32_t) {
+        m.print(1234);
+    });
+    bench::do_not_optimize(m.device().last);
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, p.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, s.ns_per_op);
+}
+
+static application<hal::host>* g_app = nullptr;
+
+// 旋钮持续转动的 SHOW_IMU / SHOW_KNOB 模式，时间按 1 ms 步长推进
+void test_bench_simulation(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 10, 'B', true },
+        { 30, 'B', false },
+    };
+
+    static application<hal::host> a;
+    g_app = &a;
+    a.buttons().play(buttons);
+    a.imu().source([](uint32_t t_us, float* xyz, void*) {
+        xyz[0] = (t_us >> 10) & 1 ? 0.2f : -0.2f;
+        xyz[1] = (t_us >> 12) & 1 ? 0.1f : -0.1f;
+        xyz[2] = 1.0f;
+    });
+
+    static sched::scheduler<hal::host_clock, 5> s({ {
+        { "imu", [] { g_app->imu_task(); }, imu_period_us, 0 },
+        { "anim", [] { g_app->anim_task(); }, anim_period_us, 1 },
+        { "input", [] { g_app->input_task(); }, input_period_us, 2 },
+        { "display", [] { g_app->display_task(); }, display_period_us, 3 },
+        { "telemetry", [] { g_app->telemetry_task(); }, telemetry_period_us, 4 },
+    } });
+    s.start();
+
+    auto r = bench::run("1 ms of simulated time", 200000, [&](uint32_t) {
+        while (s.dispatch()) {
+        }
+        hal::host_clock::advance(1000);
+    });
+
+    TEST_ASSERT_TRUE(a.state() == WorkState::SHOW_IMU);
+    // 含预热的 1/16，imu 任务每 5 ms 运行一次
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(200000 / (imu_period_us / 1000), s.get_stats(0).runs);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, r.ns_per_op);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_matrix);
+    RUN_TEST(test_bench_simulation);
+    return UNITY_END();
+}
@@ -0,0 +1,49 @@
+// test/test_bench_attitude/test_bench_attitude.cpp
+#include "../bench.hpp"
+#include "attitude.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace att;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+static constexpr float rate_hz       = 200.0f;
+
+// 预先生成样本，避免把 sin() 算进基准
+static sample samples[1024];
+
+/*
+ * 主机的周期数只是参考，预算针对 Cortex-M4F，板上以 prof::attitude 为准
+ * 这里只防止意外的退化，例如误用 double 版本的数学函数
+ */
+template <typename Estimator>
+static auto bench_update(const char* name, Estimator e) -> void {
+    auto r = bench::run(name, iterations, [&](uint32_t i) {
+        e.update(samples[i & 1023]);
+        bench::do_not_optimize(e);
+    });
+    TEST_ASSERT_TRUE(r.cycles_per_op <= Estimator::budget_cycles || r.cycles_per_op == 0.0);
+}
+
+void test_bench_update(void) {
+    for (int i = 0; i < 1024; i++) {
+        float pitch = 0.5f * sinf(i * 0.05f);
+        samples[i]  = sample{ -sinf(pitch), 0.01f, cosf(pitch), 0.002f, 0.025f * cosf(i * 0.05f), -0.001f };
+    }
+
+    bench_update("complementary::update", complementary(rate_hz, 0.5f));
+    bench_update("mahony::update", mahony(rate_hz, 1.0f, 0.1f));
+    bench_update("kalman::update", kalman(rate_hz, 0.001f, 0.003f, 0.3f));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_update);
+    return UNITY_END();
+}
@@ -0,0 +1,80 @@
+// test/test_bench_encoder/test_bench_encoder.cpp
+#include "../bench.hpp"
+#include "encoder.hpp"
+#include "literals.hpp"
+#include <unity.h>
+
+using namespace enc;
+using namespace literals;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 20000000;
+static constexpr config cfg{ travel_per_count(374, 0.065m), 4, 200000 };
+
+// 中断处理函数体：方向由 B 相给出，时间戳由调用者提供
+void test_bench_isr(void) {
+    // 最简单的写法：只计数并记录时间，读取端无法保证两者一致
+    static volatile int32_t count;
+    static volatile uint32_t t_last;
+    auto naive = bench::run("naive count + timestamp", iterations, [&](uint32_t i) {
+        count  = count + ((i & 7) ? 1 : -1);
+        t_last = i;
+    });
+
+    static counter c;
+    auto isr = bench::run("counter::edge", iterations, [&](uint32_t i) {
+        c.edge((i & 7) != 0, i);
+        bench::do_not_optimize(c);
+    });
+
+    auto rd = bench::run("counter::read", iterations, [&](uint32_t) {
+        snapshot s = c.read();
+        bench::do_not_optimize(s);
+    });
+
+    TEST_ASSERT_EQUAL_UINT32(iterations - 1, t_last);
+    TEST_ASSERT_EQUAL_UINT32(iterations - 1, c.read().t_us);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, naive.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, isr.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, rd.ns_per_op);
+}
+
+// 控制周期内的速度估计，两种方法各自的路径
+void test_bench_speed(void) {
+    speed fast(cfg), slow(cfg);
+    snapshot s{ 0, 0, 500, true };
+    fast.update(s, 0);
+    slow.update(s, 0);
+
+    auto m = bench::run("speed::update, M method", iterations, [&](uint32_t i) {
+        s.count += 10;
+        s.t_us += 5000;
+        bench::do_not_optimize(fast.update(s, s.t_us + (i & 255)));
+    });
+
+    snapshot t{ 0, 0, 20000, true };
+    auto tm = bench::run("speed::update, T method", iterations, [&](uint32_t i) {
+        if ((i & 3) == 0) {
+            t.count++;
+            t.t_us += 20000;
+        }
+        bench::do_not_optimize(slow.update(t, t.t_us + (i & 3) * 5000));
+    });
+
+    TEST_ASSERT_TRUE(fast.fast());
+    TEST_ASSERT_FALSE(slow.fast());
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, m.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, tm.ns_per_op);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_isr);
+    RUN_TEST(test_bench_speed);
+    return UNITY_END();
+}
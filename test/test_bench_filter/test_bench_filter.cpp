@@ -0,0 +1,112 @@
+// test/test_bench_filter/test_bench_filter.cpp
+#include "../bench.hpp"
+#include "filter.hpp"
+#include "imu_filter.hpp"
+#include "literals.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace dsp;
+using namespace literals;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+static constexpr frq_t fs            = 200Hz;
+
+// 预先生成 6 轴样本，避免把 sin() 算进基准
+static float samples[1024][6];
+
+static auto fill_samples() -> void {
+    for (int i = 0; i < 1024; i++)
+        for (int c = 0; c < 6; c++) samples[i][c] = sinf(i * 0.05f * (c + 1)) + 0.1f * c;
+}
+
+template <typename Filter, size_t N>
+static auto bench_filter(const char* name, Filter flt) -> bench::result {
+    return bench::run(name, iterations, [&](uint32_t i) {
+        float y[N];
+        flt.step(samples[i & 1023], y);
+        bench::do_not_optimize(y);
+    });
+}
+
+void test_bench_first_order(void) {
+    fill_samples();
+    constexpr auto offset = one_pole::lowpass(0.64Hz, fs);
+    constexpr auto smooth = one_pole::lowpass(38Hz, fs);
+
+    // 原来逐轴手写的高通 + 平滑，状态同样留在内存中
+    struct {
+        float lpf_x, lpf_y, smooth_x, smooth_y;
+    } h{};
+    auto hand = bench::run("hand-written x/y hpf + smoothing", iterations, [&](uint32_t i) {
+        const float* s = samples[i & 1023];
+        h.lpf_x        = 0.98f * h.lpf_x + (1 - 0.98f) * s[0];
+        h.lpf_y        = 0.98f * h.lpf_y + (1 - 0.98f) * s[1];
+        h.smooth_x     = 0.3f * h.smooth_x + (1 - 0.3f) * (s[0] - h.lpf_x);
+        h.smooth_y     = 0.3f * h.smooth_y + (1 - 0.3f) * (s[1] - h.lpf_y);
+        bench::do_not_optimize(h);
+    });
+
+    highpass1<2> hp(offset);
+    lowpass1<2> lp(smooth);
+    auto lib = bench::run("highpass1<2> + lowpass1<2>", iterations, [&](uint32_t i) {
+        float y[2];
+        hp.step(samples[i & 1023], y);
+        lp.step(y, y);
+        bench::do_not_optimize(hp);
+        bench::do_not_optimize(lp);
+    });
+
+    app::motion m{};
+    bench::run("motion::step", iterations, [&](uint32_t i) {
+        m.step(app::default_imu_params, samples[i & 1023][0], samples[i & 1023][1], 0.005f);
+        bench::do_not_optimize(m);
+    });
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, hand.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, lib.ns_per_op);
+}
+
+void test_bench_biquad(void) {
+    fill_samples();
+    constexpr auto lp = biquad_coeffs::lowpass(20Hz, fs);
+    constexpr auto bw = butterworth_lowpass<4>(20Hz, fs);
+
+    biquad<1> x(lp), y(lp), z(lp);
+    auto aos = bench::run("3 x biquad<1>", iterations, [&](uint32_t i) {
+        float o[3];
+        x.step(&samples[i & 1023][0], &o[0]);
+        y.step(&samples[i & 1023][1], &o[1]);
+        z.step(&samples[i & 1023][2], &o[2]);
+        bench::do_not_optimize(o);
+    });
+    auto soa = bench_filter<biquad<3>, 3>("biquad<3>", biquad<3>(lp));
+
+    bench_filter<biquad<1, 2>, 1>("biquad<1, 2> (4th order)", biquad<1, 2>(bw));
+    bench_filter<biquad<3, 2>, 3>("biquad<3, 2> (4th order)", biquad<3, 2>(bw));
+    bench_filter<biquad<6, 2>, 6>("biquad<6, 2> (4th order)", biquad<6, 2>(bw));
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, aos.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, soa.ns_per_op);
+}
+
+void test_bench_moving_average(void) {
+    fill_samples();
+    auto r = bench_filter<moving_average<3, 16>, 3>("moving_average<3, 16>", moving_average<3, 16>());
+    bench_filter<moving_average<6, 64>, 6>("moving_average<6, 64>", moving_average<6, 64>());
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, r.ns_per_op);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_first_order);
+    RUN_TEST(test_bench_biquad);
+    RUN_TEST(test_bench_moving_average);
+    return UNITY_END();
+}
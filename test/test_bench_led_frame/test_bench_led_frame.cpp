@@ -0,0 +1,65 @@
+// test/test_bench_led_frame/test_bench_led_frame.cpp
+#include "../bench.hpp"
+#include "led_frame.hpp"
+#include <unity.h>
+
+using namespace led;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+
+// 与 LED_Matrix::print(int32_t, int) 相同：清空、取位、渲染
+template <typename Draw>
+static auto bench_print(const char* name, int base, Draw draw) -> bench::result {
+    uint32_t f[words] = { 0, 0, 0 };
+    return bench::run(name, iterations, [&](uint32_t i) {
+        uint8_t d[4];
+        f[0] = f[1] = f[2] = 0;
+        split_digits(static_cast<int32_t>(i % 20000) - 999, base, d);
+        draw(f, d[0], d[1], d[2], d[3]);
+        bench::do_not_optimize(f);
+    });
+}
+
+void test_bench_print(void) {
+    auto b10 = bench_print("print(v, 10) bitwise", 10, draw_digits_bitwise);
+    auto w10 = bench_print("print(v, 10) blit", 10, draw_digits);
+    auto b16 = bench_print("print(v, 16) bitwise", 16, draw_digits_bitwise);
+    auto w16 = bench_print("print(v, 16) blit", 16, draw_digits);
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, b10.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, w10.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, b16.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, w16.ns_per_op);
+}
+
+// 只比较渲染部分
+void test_bench_render(void) {
+    uint32_t f[words] = { 0, 0, 0 };
+
+    auto b = bench::run("draw_digits_bitwise", iterations, [&](uint32_t i) {
+        draw_digits_bitwise(f, i & 15, (i >> 4) & 15, (i >> 8) & 15, 16);
+        bench::do_not_optimize(f);
+    });
+    auto w = bench::run("draw_digits", iterations, [&](uint32_t i) {
+        draw_digits(f, i & 15, (i >> 4) & 15, (i >> 8) & 15, 16);
+        bench::do_not_optimize(f);
+    });
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, b.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, w.ns_per_op);
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_print);
+    RUN_TEST(test_bench_render);
+
+    UNITY_END();
+}
@@ -0,0 +1,85 @@
+// test/test_bench_led_raster/test_bench_led_raster.cpp
+#include "../bench.hpp"
+#include "led_raster.hpp"
+#include <unity.h>
+
+using namespace led;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+
+// 原 SHOW_IMU 的画法：12 次 draw_point，每次浮点下标换算
+static auto draw_point(uint32_t* f, float rx, float ry) -> void {
+    set_bit(f, ry * 12 + rx, true);
+}
+
+void test_bench_hline(void) {
+    uint32_t f[words] = { 0, 0, 0 };
+
+    auto p = bench::run("12x draw_point(float)", iterations, [&](uint32_t i) {
+        float y = static_cast<float>(i & 7);
+        f[0] = f[1] = f[2] = 0;
+        for (int x = 0; x < 12; x++) draw_point(f, x, y);
+        bench::do_not_optimize(f);
+    });
+    auto h = bench::run("hline", iterations, [&](uint32_t i) {
+        f[0] = f[1] = f[2] = 0;
+        hline(f, 0, width - 1, i & 7);
+        bench::do_not_optimize(f);
+    });
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, p.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, h.ns_per_op);
+}
+
+void test_bench_shapes(void) {
+    uint32_t f[words] = { 0, 0, 0 };
+
+    auto p = bench::run("8x pixel (column)", iterations, [&](uint32_t i) {
+        for (int y = 0; y < height; y++) pixel(f, i % width, y);
+        bench::do_not_optimize(f);
+    });
+    auto v = bench::run("vline", iterations, [&](uint32_t i) {
+        vline(f, i % width, 0, height - 1);
+        bench::do_not_optimize(f);
+    });
+    auto r = bench::run("rect filled 6x4", iterations, [&](uint32_t i) {
+        rect(f, i & 3, i & 1, (i & 3) + 5, (i & 1) + 3, true);
+        bench::do_not_optimize(f);
+    });
+
+    int32_t values[width];
+    for (int i = 0; i < width; i++) values[i] = i * 9;
+    auto b = bench::run("bar_graph 12 columns", iterations, [&](uint32_t i) {
+        values[i % width] = i & 127;
+        bar_graph(f, values, width, 0, 100);
+        bench::do_not_optimize(f);
+    });
+
+    strip_chart chart(-100, 100);
+    auto s = bench::run("strip_chart push + draw", iterations, [&](uint32_t i) {
+        chart.push(static_cast<int32_t>(i & 255) - 128);
+        chart.draw(f);
+        bench::do_not_optimize(f);
+    });
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, p.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, v.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, r.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, b.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, s.ns_per_op);
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_hline);
+    RUN_TEST(test_bench_shapes);
+
+    UNITY_END();
+}
@@ -0,0 +1,134 @@
+// test/test_bench_log/test_bench_log.cpp
+#include "../bench.hpp"
+#include "log_record.hpp"
+#include <unity.h>
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace logging;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+
+// 只计字符数的输出，近似同步模式下 Stream::print 的逐字符调用
+struct null_out {
+    virtual ~null_out() = default;
+    virtual void write(char c) { n += c != 0; }
+    uint32_t n = 0;
+
+    void write(const char* s, size_t n) {
+        while (n--) write(*s++);
+    }
+    void print(char c) { write(c); }
+    void print(const char* s) {
+        while (*s) write(*s++);
+    }
+    template <typename T>
+    void print(T v) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%g", static_cast<double>(v));
+        print(static_cast<const char*>(buf));
+    }
+};
+
+static const format_info* const fmt = info_of(LOG_COMPILE_FORMAT("Pos: {}, {}; Vel: {}, {}, Acc: {}, {}"));
+static const format_info* const key = info_of(LOG_COMPILE_FORMAT("Press A"));
+
+// 旧实现：运行时逐字符扫描 {} 并递归输出参数
+template <typename Out>
+static void scan_format(Out& out, const char* format) {
+    while (*format) out.print(*format++);
+}
+template <typename Out, typename T, typename... Args>
+static void scan_format(Out& out, const char* format, T value, Args... args) {
+    while (*format) {
+        if (*format == '{' && *(format + 1) == '}') {
+            out.print(value);
+            scan_format(out, format + 2, args...);
+            return;
+        }
+        out.print(*format++);
+    }
+}
+
+// 热路径：编码进环形缓冲区（消费者立即弹出以保持不满）
+void test_bench_deferred(void) {
+    static record_ring<> ring;
+    float v = 0.5f;
+
+    bench::run("deferred LOG, 0 args", iterations, [&](uint32_t i) {
+        record* r = ring.reserve();
+        if (r) {
+            encode(*r, __FILE__, __LINE__, 2, i, key);
+            ring.commit();
+        }
+        ring.pop();
+    });
+
+    bench::run("deferred LOG, 6 float args", iterations, [&](uint32_t i) {
+        record* r = ring.reserve();
+        if (r) {
+            encode(*r, __FILE__, __LINE__, 2, i, fmt, v, v, v, v, v, v);
+            ring.commit();
+        }
+        ring.pop();
+        bench::clobber();
+    });
+
+    TEST_ASSERT_EQUAL_UINT32(0, ring.dropped());
+}
+
+// 对照：同步格式化同一条消息
+void test_bench_synchronous(void) {
+    null_out out;
+    record   r;
+    float    v = 0.5f;
+
+    bench::run("synchronous format, 6 float args", iterations / 10, [&](uint32_t i) {
+        encode(r, __FILE__, __LINE__, 2, i, fmt, v, v, v, v, v, v);
+        format_record(out, r);
+    });
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, out.n);
+}
+
+// 预切分格式串与运行时扫描对比，参数均为整数以突出格式串处理本身
+void test_bench_presplit(void) {
+    null_out   out;
+    const char buffer[] = "Pos: {}, {}; Vel: {}, {}, Acc: {}, {}";
+
+    bench::run("runtime scan + copy, 6 args", iterations / 10, [&](uint32_t i) {
+        char scratch[256];
+        strncpy(scratch, buffer, sizeof(scratch) - 1);
+        scratch[sizeof(scratch) - 1] = '\0';
+        scan_format(out, scratch, 'a', 'b', 'c', 'd', 'e', char(i));
+    });
+
+    const format_info& f = *fmt;
+    bench::run("pre-split segments, 6 args", iterations / 10, [&](uint32_t i) {
+        char args[6] = { 'a', 'b', 'c', 'd', 'e', char(i) };
+        for (uint8_t k = 0; k < f.argc; k++) {
+            out.write(f.str + f.segs[k].off, f.segs[k].len);
+            out.print(args[k]);
+        }
+        out.write(f.str + f.segs[f.argc].off, f.segs[f.argc].len);
+    });
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, out.n);
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_deferred);
+    RUN_TEST(test_bench_synchronous);
+    RUN_TEST(test_bench_presplit);
+
+    UNITY_END();
+}
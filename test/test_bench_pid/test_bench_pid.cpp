@@ -0,0 +1,155 @@
+// test/test_bench_pid/test_bench_pid.cpp
+#include "../bench.hpp"
+#include "pid_controller.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace ctrl;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+
+// 预先生成量测序列，避免把 sin() 算进基准
+static float samples[1024];
+
+template <typename T>
+static auto bench_update(const char* name) -> bench::result {
+    basic_pid_controller<T> pid{ T(2.0), T(0.5), T(0.01) };
+    pid.set_target(T(1.0));
+
+    T t  = T(0);
+    T dt = T(0.005);
+    return bench::run(name, iterations, [&](uint32_t i) {
+        t += dt;
+        T out = pid.update(T(samples[i & 1023]), t);
+        bench::do_not_optimize(out);
+    });
+}
+
+// 时间戳为 micros() 的整数读数
+template <typename T>
+static auto bench_update_ticks(const char* name) -> bench::result {
+    basic_pid_controller<T> pid{ T(2.0), T(0.5), T(0.01) };
+    pid.set_target(T(1.0));
+
+    time_us_t t(UINT32_MAX - iterations * 2500u); // 中途回绕
+    return bench::run(name, iterations, [&](uint32_t i) {
+        t += dura_us_t(5000);
+        T out = pid.update(T(samples[i & 1023]), t);
+        bench::do_not_optimize(out);
+    });
+}
+
+void test_bench_scalar_types(void) {
+    for (int i = 0; i < 1024; i++) samples[i] = 0.8f + 0.5f * sinf(i * 0.05f);
+
+    auto d = bench_update<double>("pid_controller<double>::update");
+    auto f = bench_update<float>("pid_controller<float>::update");
+    auto q = bench_update<fxp::q16_16>("pid_controller<q16_16>::update");
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, d.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, f.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, q.ns_per_op);
+}
+
+// 秒时间戳与整数时间戳对比
+void test_bench_integer_time(void) {
+    for (int i = 0; i < 1024; i++) samples[i] = 0.8f + 0.5f * sinf(i * 0.05f);
+
+    auto f  = bench_update<float>("pid_controller<float>::update(T)");
+    auto ft = bench_update_ticks<float>("pid_controller<float>::update(time_us_t)");
+    auto q  = bench_update<fxp::q16_16>("pid_controller<q16_16>::update(T)");
+    auto qt = bench_update_ticks<fxp::q16_16>("pid_controller<q16_16>::update(time_us_t)");
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, f.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, ft.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, q.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, qt.ns_per_op);
+}
+
+// 限幅、反算抗饱和、量测微分滤波与设定值加权全部启用
+using full_policy = pid_policy<anti_windup::back_calc, derivative::on_measurement, true, true>;
+
+template <typename T, typename Policy>
+static auto bench_policy(const char* name) -> bench::result {
+    basic_pid_controller<T, Policy> pid{ T(2.0), T(0.5), T(0.01) };
+    pid.set_target(T(1.0));
+    if constexpr (Policy::limited) pid.set_output_limits(T(-0.5), T(0.5));
+    if constexpr (Policy::filtered) pid.set_d_filter(T(0.02));
+    if constexpr (Policy::weighted) pid.set_weights(T(0.7), T(0.0));
+
+    T t  = T(0);
+    T dt = T(0.005);
+    return bench::run(name, iterations, [&](uint32_t i) {
+        t += dt;
+        T out = pid.update(T(samples[i & 1023]), t);
+        bench::do_not_optimize(out);
+    });
+}
+
+// 各策略的开销，默认策略与原先相同
+void test_bench_policies(void) {
+    for (int i = 0; i < 1024; i++) samples[i] = 0.8f + 0.5f * sinf(i * 0.05f);
+
+    auto f  = bench_policy<float, pid_policy<>>("pid<float>, default policy");
+    auto fc = bench_policy<float, pid_policy<anti_windup::conditional>>("pid<float>, conditional");
+    auto fb = bench_policy<float, pid_policy<anti_windup::back_calc>>("pid<float>, back_calc");
+    auto ff = bench_policy<float, full_policy>("pid<float>, all options");
+    auto q  = bench_policy<fxp::q16_16, pid_policy<>>("pid<q16_16>, default policy");
+    auto qf = bench_policy<fxp::q16_16, full_policy>("pid<q16_16>, all options");
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, f.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, fc.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, fb.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, ff.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, q.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, qf.ns_per_op);
+}
+
+template <typename T>
+static auto bench_discrete(const char* name, bool incremental) -> bench::result {
+    basic_discrete_pid<T> pid{ T(2.0), T(0.5), T(0.01), T(0.005) };
+    pid.set_target(T(1.0));
+
+    if (incremental) {
+        return bench::run(name, iterations, [&](uint32_t i) {
+            T out = pid.update_delta(T(samples[i & 1023]));
+            bench::do_not_optimize(out);
+        });
+    }
+    return bench::run(name, iterations, [&](uint32_t i) {
+        T out = pid.update(T(samples[i & 1023]));
+        bench::do_not_optimize(out);
+    });
+}
+
+// 固定周期模式与 update(val, time) 对比
+void test_bench_fixed_rate(void) {
+    for (int i = 0; i < 1024; i++) samples[i] = 0.8f + 0.5f * sinf(i * 0.05f);
+
+    auto v = bench_update<float>("pid_controller<float>::update");
+    auto p = bench_discrete<float>("discrete_pid<float>::update", false);
+    auto d = bench_discrete<float>("discrete_pid<float>::update_delta", true);
+    bench_discrete<fxp::q16_16>("discrete_pid<q16_16>::update", false);
+    bench_discrete<fxp::q16_16>("discrete_pid<q16_16>::update_delta", true);
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, v.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, p.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, d.ns_per_op);
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_scalar_types);
+    RUN_TEST(test_bench_integer_time);
+    RUN_TEST(test_bench_fixed_rate);
+    RUN_TEST(test_bench_policies);
+
+    UNITY_END();
+}
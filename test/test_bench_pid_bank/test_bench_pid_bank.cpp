@@ -0,0 +1,74 @@
+// test/test_bench_pid_bank/test_bench_pid_bank.cpp
+#include "../bench.hpp"
+#include "pid_bank.hpp"
+#include "pid_controller.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace ctrl;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t channel_updates = 8000000;
+
+// 同样的通道数分别用 pid_bank 和 N 个 pid_controller 更新，输出每通道耗时
+template <size_t N>
+static void bench_channels() {
+    using T = float;
+
+    basic_pid_bank<T, N>    bank;
+    basic_pid_controller<T> pids[N];
+    std::array<T, N>        in, out;
+
+    for (size_t ch = 0; ch < N; ch++) {
+        bank.set_gains(ch, 2.0f, 0.5f, 0.01f);
+        pids[ch] = basic_pid_controller<T>(2.0f, 0.5f, 0.01f);
+        in[ch]   = 0.1f * ch;
+    }
+
+    char name[64];
+    T    t = 0;
+
+    snprintf(name, sizeof(name), "pid_bank<float, %u>::update", static_cast<unsigned>(N));
+    auto b = bench::run(name, channel_updates / N, [&](uint32_t) {
+        t += 0.005f;
+        bank.update(in, out, t);
+        bench::do_not_optimize(out);
+    });
+
+    t = 0;
+    snprintf(name, sizeof(name), "%u x pid_controller::update", static_cast<unsigned>(N));
+    auto s = bench::run(name, channel_updates / N, [&](uint32_t) {
+        t += 0.005f;
+        for (size_t ch = 0; ch < N; ch++) out[ch] = pids[ch].update(in[ch], t);
+        bench::do_not_optimize(out);
+    });
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "N = %2u: bank %.2f ns/ch, separate %.2f ns/ch", static_cast<unsigned>(N),
+             b.ns_per_op / N, s.ns_per_op / N);
+    TEST_MESSAGE(msg);
+}
+
+void test_bench_throughput(void) {
+    bench_channels<1>();
+    bench_channels<2>();
+    bench_channels<3>();
+    bench_channels<4>();
+    bench_channels<8>();
+    bench_channels<16>();
+    bench_channels<32>();
+    bench_channels<64>();
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_throughput);
+
+    UNITY_END();
+}
@@ -0,0 +1,111 @@
+// test/test_bench_quantity/test_bench_quantity.cpp
+#include "../bench.hpp"
+#include "literals.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace literals;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 2000000;
+
+// 预先生成的速度量测，避免把 sin() 算进基准
+static float samples[1024];
+
+/*
+ * 带量纲的速度环 PID 一步：误差 m/s，积分 m，微分 m/s^2
+ * 增益带倒数量纲，输出为无量纲的占空比
+ */
+template <typename Rep>
+struct speed_pid {
+    using val  = Quantity<0, 1, -1, Rep>;
+    using leng = Quantity<0, 1, 0, Rep>;
+    using dura = Quantity<0, 0, 1, Rep>;
+    using acc  = Quantity<0, 1, -2, Rep>;
+    using out  = Quantity<0, 0, 0, Rep>;
+
+    Quantity<0, -1, 1, Rep> kp{ 2.0 };
+    Quantity<0, -1, 0, Rep> ki{ 0.5 };
+    Quantity<0, -1, 2, Rep> kd{ 0.01 };
+    val target{ 1.0 };
+    dura dt{ 0.005 };
+
+    leng integ{ 0.0 };
+    val prev{ 0.0 };
+
+    auto update(val measured) -> out {
+        val err = target - measured;
+        integ   = integ + err * dt;
+        acc der = (err - prev) / dt;
+        prev    = err;
+        return kp * err + ki * integ + kd * der;
+    }
+};
+
+template <typename Rep>
+static auto bench_quantity(const char* name) -> bench::result {
+    using val = typename speed_pid<Rep>::val;
+    speed_pid<Rep> pid;
+    return bench::run(name, iterations, [&](uint32_t i) {
+        auto u = pid.update(val(samples[i & 1023]));
+        bench::do_not_optimize(u);
+    });
+}
+
+// 同样的计算，不带量纲的 float，作为下限
+static auto bench_plain_float() -> bench::result {
+    float kp = 2.0f, ki = 0.5f, kd = 0.01f, target = 1.0f, dt = 0.005f;
+    float integ = 0.0f, prev = 0.0f;
+    return bench::run("plain float", iterations, [&](uint32_t i) {
+        float err = target - samples[i & 1023];
+        integ     = integ + err * dt;
+        float der = (err - prev) / dt;
+        prev      = err;
+        float u   = kp * err + ki * integ + kd * der;
+        bench::do_not_optimize(u);
+    });
+}
+
+void test_bench_representations(void) {
+    for (int i = 0; i < 1024; i++) samples[i] = 0.8f + 0.5f * sinf(i * 0.05f);
+
+    auto d = bench_quantity<double>("Quantity<double>");
+    auto f = bench_quantity<float>("Quantity<float>");
+    auto q = bench_quantity<fxp::q16_16>("Quantity<q16_16>");
+    auto p = bench_plain_float();
+
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, d.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, f.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, q.ns_per_op);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(0.0, p.ns_per_op);
+}
+
+// 三种表示的输出一致，q16 的误差来自 5 ms 的量化
+void test_representations_agree(void) {
+    for (int i = 0; i < 1024; i++) samples[i] = 0.8f + 0.5f * sinf(i * 0.05f);
+
+    speed_pid<double> d;
+    speed_pid<float> f;
+    speed_pid<fxp::q16_16> q;
+    for (int i = 0; i < 200; i++) {
+        double ud = d.update(val_t(samples[i])).v;
+        double uf = f.update(f32::val_t(samples[i])).v;
+        double uq = static_cast<double>(q.update(q16::val_t(samples[i])).v);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-4, ud, uf);
+        TEST_ASSERT_DOUBLE_WITHIN(2e-2, ud, uq);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_representations);
+    RUN_TEST(test_representations_agree);
+
+    UNITY_END();
+}
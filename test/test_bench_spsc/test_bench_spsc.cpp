@@ -0,0 +1,160 @@
+// test/test_bench_spsc/test_bench_spsc.cpp
+#include "../bench.hpp"
+#include "spsc_queue.hpp"
+#include <unity.h>
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace spsc;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t iterations = 10000000;
+static constexpr uint32_t transfers  = 4000000;
+
+// 单线程：一次写入紧接一次读取，即中断与 loop() 交替时的开销
+void test_bench_single_thread(void) {
+    static queue<uint32_t, 256> q;
+    auto one = bench::run("push + pop", iterations, [&](uint32_t i) {
+        q.push(i);
+        uint32_t v = 0;
+        q.pop(v);
+        bench::do_not_optimize(v);
+    });
+
+    uint32_t batch[16];
+    auto span16 = bench::run("16 x push + pop_span(16)", iterations / 16, [&](uint32_t i) {
+        for (uint32_t k = 0; k < 16; k++) q.push(i + k);
+        q.pop_span(batch, 16);
+        bench::do_not_optimize(batch);
+    });
+    span16.ns_per_op /= 16;
+
+    std::mutex m;
+    std::deque<uint32_t> d;
+    auto locked = bench::run("mutex + std::deque push + pop", iterations, [&](uint32_t i) {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            d.push_back(i);
+        }
+        std::lock_guard<std::mutex> lock(m);
+        uint32_t v = d.front();
+        d.pop_front();
+        bench::do_not_optimize(v);
+    });
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "pop_span per item: %.2f ns", span16.ns_per_op);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(one.ns_per_op < locked.ns_per_op);
+}
+
+// 一端等待另一端时先让出，仍等不到再睡眠，单核主机上 yield() 不一定切换到对方线程
+static auto backoff(uint32_t& misses) -> void {
+    if (++misses < 64) std::this_thread::yield();
+    else std::this_thread::sleep_for(std::chrono::microseconds(1));
+}
+
+/*
+ * 两个线程之间的吞吐量，返回每秒传递的元素数（百万）
+ * consume 返回本次取出的元素个数
+ */
+template <typename Push, typename Consume>
+static auto throughput(const char* name, Push push, Consume consume) -> double {
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        uint32_t misses = 0;
+        for (uint32_t i = 0; i < transfers;) {
+            if (push(i)) {
+                i++;
+                misses = 0;
+            } else {
+                backoff(misses);
+            }
+        }
+    });
+    uint64_t sum    = 0;
+    uint32_t misses = 0;
+    for (uint32_t got = 0; got < transfers;) {
+        uint32_t n = consume(sum);
+        if (n == 0) backoff(misses);
+        else misses = 0;
+        got += n;
+    }
+    producer.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    // 0 + 1 + ... + (transfers - 1)
+    TEST_ASSERT_TRUE(sum == uint64_t(transfers) * (transfers - 1) / 2);
+
+    double mps = transfers / std::chrono::duration<double, std::micro>(t1 - t0).count();
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%-36s %9.1f M items/s", name, mps);
+    TEST_MESSAGE(msg);
+    return mps;
+}
+
+void test_bench_two_threads(void) {
+    static queue<uint32_t, 1024> q;
+
+    double pop = throughput(
+        "spsc pop", [](uint32_t i) { return q.push(i); },
+        [](uint64_t& sum) -> uint32_t {
+            uint32_t v;
+            if (!q.pop(v)) return 0;
+            sum += v;
+            return 1;
+        });
+
+    throughput(
+        "spsc pop_span(64)", [](uint32_t i) { return q.push(i); },
+        [](uint64_t& sum) -> uint32_t {
+            uint32_t v[64];
+            size_t n = q.pop_span(v, 64);
+            for (size_t i = 0; i < n; i++) sum += v[i];
+            return static_cast<uint32_t>(n);
+        });
+
+    throughput(
+        "spsc front_span", [](uint32_t i) { return q.push(i); },
+        [](uint64_t& sum) -> uint32_t {
+            span<uint32_t> s = q.front_span();
+            for (uint32_t v : s) sum += v;
+            q.pop(s.size);
+            return static_cast<uint32_t>(s.size);
+        });
+
+    static std::mutex m;
+    static std::deque<uint32_t> d;
+    throughput(
+        "mutex + std::deque",
+        [](uint32_t i) {
+            std::lock_guard<std::mutex> lock(m);
+            if (d.size() >= 1024) return false;
+            d.push_back(i);
+            return true;
+        },
+        [](uint64_t& sum) -> uint32_t {
+            std::lock_guard<std::mutex> lock(m);
+            if (d.empty()) return 0;
+            sum += d.front();
+            d.pop_front();
+            return 1;
+        });
+
+    TEST_ASSERT_TRUE(pop > 0.0);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_single_thread);
+    RUN_TEST(test_bench_two_threads);
+    return UNITY_END();
+}
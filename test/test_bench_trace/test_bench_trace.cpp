@@ -0,0 +1,147 @@
+// test/test_bench_trace/test_bench_trace.cpp
+#include "../bench.hpp"
+#include "app.hpp"
+#include "hal_host.hpp"
+#include "imu_filter.hpp"
+#include "trace.hpp"
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr float dt = app::imu_dt;
+
+/*
+ * IMU_TRACE=<file> 时回放 utils/trace_tool.py capture 录下的数据，
+ * 否则生成 60 s 的合成数据：偏移 + 噪声 + 每 5 s 一次来回移动
+ */
+static auto load_trace() -> std::vector<uint8_t> {
+    std::vector<uint8_t> data;
+    if (const char* path = getenv("IMU_TRACE")) {
+        if (FILE* fp = fopen(path, "rb")) {
+            uint8_t buf[4096];
+            size_t n;
+            while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) data.insert(data.end(), buf, buf + n);
+            fclose(fp);
+            TEST_MESSAGE(path);
+            return data;
+        }
+    }
+
+    trace::writer<hal::host_serial> w;
+    uint32_t seed = 1;
+    auto noise    = [&seed]() -> float {
+        seed = seed * 1664525u + 1013904223u;
+        return ((seed >> 9) & 0xFF) / 255.0f * 0.02f - 0.01f;
+    };
+
+    w.begin(0);
+    w.sample_reset(0, 0.03f, -0.02f, 1.0f);
+    for (uint32_t i = 1; i <= 12000; i++) {
+        uint32_t t   = i * app::imu_period_us;
+        float phase  = (t % 5000000) / 1000000.0f;
+        float motion = phase < 0.5f ? 0.3f : phase < 1.0f ? -0.3f : 0.0f;
+        w.sample_imu(t, 0.03f + noise(), -0.02f + motion + noise(), 1.0f + noise());
+    }
+    const std::string& s = w.sink().output();
+    data.assign(s.begin(), s.end());
+    return data;
+}
+
+// 每次运行结束位置离原点越近越好，移动期间的位移越大越好
+static auto score(const std::vector<uint8_t>& data, const app::imu_params& p) -> float {
+    trace::reader rd(data.data(), data.size());
+    app::imu_replay rp(p, dt);
+    float peak = 0.0f;
+    trace::record r;
+    while (rd.next(r)) {
+        if (r.type == trace::reset) rp.on_reset(r);
+        else if (r.type == trace::state) rp.on_state(r);
+        else if (r.type == trace::imu) {
+            rp.on_imu(r);
+            peak = fmaxf(peak, fabsf(rp.state.pos_y));
+        }
+    }
+    return peak - fabsf(rp.state.pos_y) * 4.0f;
+}
+
+void test_bench_replay(void) {
+    auto data = load_trace();
+    trace::reader rd(data.data(), data.size());
+    app::imu_replay rp(app::default_imu_params, dt);
+    uint32_t records = trace::replay(rd, rp);
+    TEST_ASSERT_GREATER_THAN(0, rp.steps);
+
+    auto r = bench::run("replay whole trace", 200, [&](uint32_t) {
+        rd.rewind();
+        app::imu_replay h(app::default_imu_params, dt);
+        trace::replay(rd, h);
+        bench::do_not_optimize(h.state);
+    });
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%lu records, %.1f ns/record, %.0fx real time", static_cast<unsigned long>(records),
+             r.ns_per_op / records, rp.steps * dt * 1e9 / r.ns_per_op);
+    TEST_MESSAGE(msg);
+}
+
+// 4 x 4 x 4 x 4 组参数，输出得分最高的一组，两个滤波器按截止频率 (Hz) 扫描
+void test_parameter_sweep(void) {
+    auto data = load_trace();
+
+    const double offset_hz[]    = { 1.6, 0.64, 0.32, 0.16 };
+    const double smoothing_hz[] = { 90.0, 38.0, 16.0, 7.0 };
+    const float deadzone[]  = { 0.005f, 0.01f, 0.02f, 0.04f };
+    const float decay[]     = { 0.95f, 0.98f, 0.99f, 0.995f };
+
+    app::imu_params best  = app::default_imu_params;
+    double best_offset    = 0.64;
+    double best_smoothing = 38.0;
+    float best_score      = score(data, best);
+    float base_score      = best_score;
+    uint32_t runs         = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (double o : offset_hz)
+        for (double s : smoothing_hz)
+            for (float d : deadzone)
+                for (float m : decay) {
+                    app::imu_params p = app::default_imu_params;
+                    p.offset          = dsp::one_pole::lowpass(literals::frq_t(o), app::imu_rate);
+                    p.smoothing       = dsp::one_pole::lowpass(literals::frq_t(s), app::imu_rate);
+                    p.deadzone        = d;
+                    p.decay_moving    = m;
+                    float sc          = score(data, p);
+                    if (sc > best_score) {
+                        best_score     = sc;
+                        best           = p;
+                        best_offset    = o;
+                        best_smoothing = s;
+                    }
+                    runs++;
+                }
+    auto t1 = std::chrono::steady_clock::now();
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "%lu runs in %.1f ms, best offset %.2f Hz smooth %.0f Hz deadzone %.3f decay %.3f (%.3f vs %.3f)",
+             static_cast<unsigned long>(runs), std::chrono::duration<double, std::milli>(t1 - t0).count(), best_offset,
+             best_smoothing, best.deadzone, best.decay_moving, best_score, base_score);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(best_score >= base_score);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_replay);
+    RUN_TEST(test_parameter_sweep);
+    return UNITY_END();
+}
@@ -0,0 +1,120 @@
+// test/test_cascade/test_cascade.cpp
+#include "cascade.hpp"
+#include "pid_controller.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace ctrl;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 记录调用次数的控制器，输出 = 目标 + 1
+struct counting_controller {
+    using value_type = double;
+
+    double target  = 0;
+    int    calls   = 0;
+    double last_in = 0;
+
+    auto update(double val) -> double {
+        calls++;
+        last_in = val;
+        return target + 1;
+    }
+    auto reset() -> void { calls = 0; }
+    auto get_target() -> double { return target; }
+    auto set_target(double t) -> void { target = t; }
+};
+
+// 外环 50 Hz、内环 200 Hz 时的调用次数
+void test_decimation(void) {
+    cascade<stage<counting_controller, 4>, stage<counting_controller, 1>> c{ {}, {} };
+
+    for (int k = 0; k < 100; k++) c.update(0.0, 0.0);
+
+    TEST_ASSERT_EQUAL_INT(25, c.get<0>().calls);
+    TEST_ASSERT_EQUAL_INT(100, c.get<1>().calls);
+}
+
+// 外环输出作为内环目标
+void test_chaining(void) {
+    cascade<stage<counting_controller, 2>, stage<counting_controller, 1>> c{ {}, {} };
+    c.set_target(3.0);
+
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, c.update(1.0, 2.0)); // 外环输出 4，内环输出 5
+    TEST_ASSERT_EQUAL_DOUBLE(4.0, c.get_output<0>());
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, c.get<1>().last_in);
+}
+
+void test_three_stages(void) {
+    cascade<stage<counting_controller, 8>, stage<counting_controller, 4>, stage<counting_controller, 1>> c{ {}, {}, {} };
+    c.set_target(0.0);
+
+    for (int k = 0; k < 64; k++) c.update(0.0, 0.0, 0.0);
+
+    TEST_ASSERT_EQUAL_INT(8, c.get<0>().calls);
+    TEST_ASSERT_EQUAL_INT(16, c.get<1>().calls);
+    TEST_ASSERT_EQUAL_INT(64, c.get<2>().calls);
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, c.update(0.0, 0.0, 0.0));
+}
+
+/*
+ * 被控对象：带阻尼的质量块  m * a = u - c * v
+ * 外环位置 P (50 Hz) 输出速度目标，内环速度 PI (200 Hz) 输出力
+ */
+struct mass_plant {
+    double m = 0.5, c = 0.2;
+    double x = 0, v = 0;
+
+    auto step(double u, double dt) -> void {
+        double a = (u - c * v) / m;
+        v += a * dt;
+        x += v * dt;
+    }
+};
+
+void test_position_velocity_cascade(void) {
+    constexpr double base = 0.005;
+
+    cascade<stage<discrete_pid, 4>, stage<discrete_pid, 1>> c{
+        discrete_pid(3.0, 0.0, 0.0, base * 4),
+        discrete_pid(4.0, 8.0, 0.0, base),
+    };
+    c.set_target(1.0);
+
+    mass_plant plant;
+    for (int k = 0; k < 2000; k++) {
+        double u = c.update(plant.x, plant.v);
+        plant.step(u, base);
+    }
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, 1.0, plant.x);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, 0.0, plant.v);
+}
+
+void test_reset(void) {
+    cascade<stage<counting_controller, 4>, stage<counting_controller, 1>> c{ {}, {} };
+
+    c.update(0.0, 0.0);
+    c.update(0.0, 0.0);
+    c.reset();
+    c.update(0.0, 0.0);
+
+    TEST_ASSERT_EQUAL_INT(1, c.get<0>().calls); // 复位后外环立即运行
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_decimation);
+    RUN_TEST(test_chaining);
+    RUN_TEST(test_three_stages);
+    RUN_TEST(test_position_velocity_cascade);
+    RUN_TEST(test_reset);
+
+    UNITY_END();
+}
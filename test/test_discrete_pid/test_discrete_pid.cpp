@@ -0,0 +1,107 @@
+// test/test_discrete_pid/test_discrete_pid.cpp
+#include "pid_controller.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace ctrl;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_constructor(void) {
+    discrete_pid pid(1.0, 0.5, 0.2, 5ms);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, pid.get_kp());
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, pid.get_ki());
+    TEST_ASSERT_EQUAL_DOUBLE(0.2, pid.get_kd());
+    TEST_ASSERT_EQUAL_DOUBLE(0.005, pid.get_period());
+}
+
+// 测试位置式输出
+void test_positional(void) {
+    discrete_pid pid(1.0, 0.1, 0.5, 10ms);
+    pid.set_target(100.0);
+
+    // error = 50, P = 50, I = 0.1 * 0.01 * 50 = 0.05, D = 0
+    TEST_ASSERT_EQUAL_DOUBLE(50.05, pid.update(50.0));
+
+    // error = 40, P = 40, I = 0.001 * 90 = 0.09, D = 0.5 / 0.01 * (50 - 40) = 500
+    TEST_ASSERT_EQUAL_DOUBLE(540.09, pid.update(60.0));
+}
+
+// 增量式输出累加后应与位置式一致
+void test_incremental_matches_positional(void) {
+    discrete_pid pos(2.0, 0.5, 0.05, 5ms);
+    discrete_pid inc(2.0, 0.5, 0.05, 5ms);
+    pos.set_target(1.0);
+    inc.set_target(1.0);
+
+    double acc = 0;
+    for (int k = 0; k < 500; k++) {
+        double y = 0.3 * sin(k * 0.07) + 0.01 * k;
+        acc += inc.update_delta(y);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, pos.update(y), acc);
+    }
+}
+
+// 固定周期下与 update(val, time) 的结果一致
+void test_matches_variable_dt(void) {
+    pid_controller ref(2.0, 0.5, 0.05);
+    discrete_pid   pid(2.0, 0.5, 0.05, 5ms);
+    ref.set_target(1.0);
+    pid.set_target(1.0);
+
+    // 首个采样误差为 0，两种形式的首拍积分约定不影响结果
+    for (int k = 0; k < 500; k++) {
+        double y = (k == 0) ? 1.0 : 1.0 - 0.4 * cos(k * 0.05);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, ref.update(y, k * 0.005), pid.update(y));
+    }
+}
+
+void test_set_gain_rebakes(void) {
+    discrete_pid pid(1.0, 0.0, 0.0, 10ms);
+    pid.set_target(10.0);
+    pid.set_ki(1.0);
+
+    TEST_ASSERT_EQUAL_DOUBLE(5.0 + 0.05, pid.update(5.0));
+}
+
+void test_reset(void) {
+    discrete_pid pid(1.0, 0.1, 0.5, 10ms);
+    pid.set_target(100.0);
+
+    pid.update(50.0);
+    pid.update(60.0);
+    pid.reset();
+
+    TEST_ASSERT_EQUAL_DOUBLE(50.05, pid.update(50.0));
+}
+
+// Q31 用于归一化信号，系数与误差累加和都必须落在 [-1, 1)
+void test_q31_normalised(void) {
+    using fxp::q31;
+    discrete_pid_q31 pid(q31(0.5), q31(0.5), q31(0.0), q31(0.01));
+    discrete_pid     ref(0.5, 0.5, 0.0, 10ms);
+
+    for (int k = 0; k < 200; k++) {
+        double y = 0.02 * sin(k * 0.1);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-6, ref.update(y), static_cast<double>(pid.update(q31(y))));
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_constructor);
+    RUN_TEST(test_positional);
+    RUN_TEST(test_incremental_matches_positional);
+    RUN_TEST(test_matches_variable_dt);
+    RUN_TEST(test_set_gain_rebakes);
+    RUN_TEST(test_reset);
+    RUN_TEST(test_q31_normalised);
+
+    UNITY_END();
+}
@@ -0,0 +1,213 @@
+// test/test_encoder/test_encoder.cpp
+#include "encoder.hpp"
+#include "literals.hpp"
+#include <unity.h>
+
+#include <math.h>
+
+#include <thread>
+
+using namespace enc;
+using namespace literals;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr config cfg{ travel_per_count(100, 0.1m), 4, 200000 };
+static const double per_count = cfg.per_count.v;
+
+/*
+ * 合成的边沿序列：以 counts_per_s 匀速转动，下一个沿在 next_us，
+ * 每个沿的时间带有 +-jitter us 的抖动，run() 送出 to 之前的沿
+ */
+struct edge_stream {
+    double counts_per_s;
+    bool forward;
+    double next_us;
+    uint32_t jitter;
+    uint32_t seed = 1;
+
+    auto run(counter& c, uint32_t to) -> void {
+        while (next_us < to) {
+            uint32_t t = static_cast<uint32_t>(next_us);
+            if (jitter) {
+                seed = seed * 1664525u + 1013904223u;
+                t += (seed >> 8) % (2 * jitter + 1) - jitter;
+            }
+            c.edge(forward, t);
+            next_us += 1e6 / counts_per_s;
+        }
+    }
+};
+
+// 每 period_us 更新一次，返回最后一次估计
+static auto drive(counter& c, speed& v, edge_stream& e, uint32_t& now, uint32_t duration_us,
+                  uint32_t period_us = 5000) -> double {
+    for (uint32_t end = now + duration_us; now < end;) {
+        e.run(c, now + period_us);
+        now += period_us;
+        v.update(c.read(), now);
+    }
+    return v.value().v;
+}
+
+void test_counter(void) {
+    counter c;
+    snapshot s = c.read();
+    TEST_ASSERT_EQUAL_INT32(0, s.count);
+    TEST_ASSERT_EQUAL_UINT32(0, s.period_us);
+
+    c.edge(true, 1000);
+    c.edge(true, 1500);
+    s = c.read();
+    TEST_ASSERT_EQUAL_INT32(2, s.count);
+    TEST_ASSERT_EQUAL_UINT32(1500, s.t_us);
+    TEST_ASSERT_EQUAL_UINT32(500, s.period_us);
+    TEST_ASSERT_TRUE(s.forward);
+
+    // 换向时周期无效
+    c.edge(false, 2500);
+    s = c.read();
+    TEST_ASSERT_EQUAL_INT32(1, s.count);
+    TEST_ASSERT_EQUAL_UINT32(0, s.period_us);
+    TEST_ASSERT_FALSE(s.forward);
+    c.edge(false, 3700);
+    TEST_ASSERT_EQUAL_UINT32(1200, c.read().period_us);
+
+    // 跨越 32 位时间回绕
+    c.edge(false, 0xFFFFFF00u);
+    c.edge(false, 0x00000100u);
+    TEST_ASSERT_EQUAL_UINT32(0x200, c.read().period_us);
+}
+
+void test_m_method(void) {
+    // 2000 counts/s，每 5 ms 约 10 个计数，沿的时间有 +-20 us 抖动
+    counter c;
+    speed v(cfg);
+    edge_stream e{ 2000.0, true, 1000.0, 20 };
+    uint32_t now = 0;
+    drive(c, v, e, now, 20000);
+    TEST_ASSERT_TRUE(v.fast());
+
+    // 按沿计时：误差只来自抖动，而不是固定窗口的 +-1 计数（10%）
+    double worst = 0;
+    for (int i = 0; i < 200; i++) {
+        double err = fabs(drive(c, v, e, now, 5000) / (2000 * per_count) - 1);
+        if (err > worst) worst = err;
+    }
+    TEST_ASSERT_TRUE(worst < 0.01);
+
+    // 反转
+    e.forward = false;
+    drive(c, v, e, now, 20000);
+    TEST_ASSERT_FLOAT_WITHIN(0.01 * 2000 * per_count, -2000 * per_count, v.value().v);
+}
+
+void test_t_method(void) {
+    // 50 counts/s：每 20 ms 一个计数，5 ms 窗口内的计数只有 0 或 1
+    counter c;
+    speed v(cfg);
+    edge_stream e{ 50.0, true, 1000.0, 0 };
+    uint32_t now = 0;
+    drive(c, v, e, now, 100000);
+    TEST_ASSERT_FALSE(v.fast());
+
+    // 每次更新都有估计，且不随窗口内是否有沿而跳变
+    for (int i = 0; i < 40; i++) {
+        double got = drive(c, v, e, now, 5000);
+        TEST_ASSERT_FLOAT_WITHIN(1e-9, 50 * per_count, got);
+    }
+
+    e.counts_per_s = 20.0;
+    e.forward      = false;
+    drive(c, v, e, now, 300000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, -20 * per_count, v.value().v);
+}
+
+void test_switch_hysteresis(void) {
+    // 5 ms 更新，fast_counts = 4：800 counts/s 切到 M 法，低于 400 counts/s 才回到 T 法
+    counter c;
+    speed v(cfg);
+    edge_stream e{ 300.0, true, 1000.0, 0 };
+    uint32_t now = 0;
+    drive(c, v, e, now, 100000);
+    TEST_ASSERT_FALSE(v.fast());
+
+    e.counts_per_s = 1000.0;
+    drive(c, v, e, now, 50000);
+    TEST_ASSERT_TRUE(v.fast());
+
+    // 处在滞回区间内时保持 M 法，不会逐次切换
+    e.counts_per_s = 600.0;
+    drive(c, v, e, now, 5000); // 跨越变速的一次
+    TEST_ASSERT_TRUE(v.fast());
+    for (int i = 0; i < 40; i++) {
+        drive(c, v, e, now, 5000);
+        TEST_ASSERT_TRUE(v.fast());
+        TEST_ASSERT_FLOAT_WITHIN(0.01 * 600 * per_count, 600 * per_count, v.value().v);
+    }
+
+    e.counts_per_s = 300.0;
+    drive(c, v, e, now, 50000);
+    TEST_ASSERT_FALSE(v.fast());
+    TEST_ASSERT_FLOAT_WITHIN(0.01 * 300 * per_count, 300 * per_count, v.value().v);
+}
+
+void test_stop(void) {
+    counter c;
+    speed v(cfg);
+    edge_stream e{ 100.0, true, 1000.0, 0 };
+    uint32_t now = 0;
+    drive(c, v, e, now, 200000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 100 * per_count, v.value().v);
+
+    // 不再有沿：估计不超过 1 个计数 / 距上个沿的时间，单调减小，超时后为 0
+    uint32_t last_edge = c.read().t_us;
+    double prev        = v.value().v;
+    for (now += 5000; now - last_edge < cfg.timeout_us; now += 5000) {
+        double got = v.update(c.read(), now).v;
+        TEST_ASSERT_TRUE(got <= prev);
+        TEST_ASSERT_TRUE(got <= per_count * 1e6 / (now - last_edge) + 1e-12);
+        prev = got;
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, v.update(c.read(), now).v);
+
+    // 快照之后的沿不会被当作超时
+    c.edge(true, now + 10000);
+    c.edge(true, now + 20000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 100 * per_count, v.update(c.read(), now + 19990).v);
+}
+
+void test_concurrent_read(void) {
+    // 另一线程代替中断写入，快照中计数与时间始终属于同一个沿
+    static counter c;
+    static constexpr int32_t edges = 1000000;
+    std::thread isr([] {
+        for (int32_t i = 1; i <= edges; i++) c.edge(true, static_cast<uint32_t>(i) * 7);
+    });
+
+    uint32_t torn = 0;
+    for (;;) {
+        snapshot s = c.read();
+        if (s.t_us != static_cast<uint32_t>(s.count) * 7) torn++;
+        if (s.count > 1 && s.period_us != 7) torn++;
+        if (s.count == edges) break;
+        std::this_thread::yield();
+    }
+    isr.join();
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_counter);
+    RUN_TEST(test_m_method);
+    RUN_TEST(test_t_method);
+    RUN_TEST(test_switch_hysteresis);
+    RUN_TEST(test_stop);
+    RUN_TEST(test_concurrent_read);
+    return UNITY_END();
+}
@@ -0,0 +1,218 @@
+// test/test_filter/test_filter.cpp
+#include "filter.hpp"
+#include "literals.hpp"
+#include <unity.h>
+
+#include <math.h>
+
+using namespace dsp;
+using namespace literals;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr frq_t fs = 200Hz;
+
+// 系数在编译期计算
+static constexpr auto lp20  = biquad_coeffs::lowpass(20Hz, fs);
+static constexpr auto hp5   = biquad_coeffs::highpass(5Hz, fs);
+static constexpr auto bw4   = butterworth_lowpass<4>(10Hz, fs);
+static constexpr auto pole1 = one_pole::lowpass(1Hz, rate(5ms));
+static_assert(lp20.b0 > 0.0f && lp20.b0 == lp20.b2 && lp20.b1 == 2 * lp20.b0, "lowpass numerator is (1, 2, 1)");
+static_assert(pole1.a > 0.0f && pole1.a < 0.05f, "one pole coefficient");
+
+/*
+ * 以 f 的正弦驱动通道 ch，丢弃前 settle 个样本后在整数个周期上
+ * 与 sin / cos 做相关，得到输出幅值（输入幅值为 1）
+ */
+template <typename Filter, size_t N>
+static auto measure(Filter& flt, double f, size_t ch = 0) -> double {
+    const int settle = 4000;
+    const int cycles = static_cast<int>(fs.v);
+    const int len    = cycles * 20; // f 取 0.05 Hz 的整数倍时为整数个周期
+
+    double si = 0, co = 0;
+    for (int n = 0; n < settle + len; n++) {
+        double ph = 2 * pi * f * n / fs.v;
+        float x[N] = {};
+        float y[N];
+        x[ch] = static_cast<float>(sin(ph));
+        flt.step(x, y);
+        if (n < settle) continue;
+        si += y[ch] * sin(ph);
+        co += y[ch] * cos(ph);
+    }
+    return 2.0 / len * sqrt(si * si + co * co);
+}
+
+void test_design_matches_libm(void) {
+    // 编译期的 sin / cos / exp 与 libm 一致
+    double w = 2 * pi * 20 / 200.0, c = cos(w), alpha = sin(w) / (2 * biquad_coeffs::butterworth_q);
+    TEST_ASSERT_FLOAT_WITHIN(1e-7f, static_cast<float>((1 - c) / 2 / (1 + alpha)), lp20.b0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-7f, static_cast<float>(-2 * c / (1 + alpha)), lp20.a1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-7f, static_cast<float>((1 - alpha) / (1 + alpha)), lp20.a2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9f, static_cast<float>(1 - exp(-2 * pi / 200.0)), pole1.a);
+
+    // 时间常数与截止频率两种写法等价
+    auto tau = one_pole::lowpass(dura_t(1 / (2 * pi)), 5ms);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9f, pole1.a, tau.a);
+}
+
+void test_one_pole_response(void) {
+    lowpass1<1> lp(pole1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 1.0, gain(pole1, 0Hz, fs));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, M_SQRT1_2, gain(pole1, 1Hz, fs));
+
+    for (double f : { 0.2, 1.0, 5.0, 20.0 }) {
+        lp.reset();
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, gain(pole1, frq_t(f), fs), (measure<lowpass1<1>, 1>(lp, f)));
+    }
+
+    // 高通为原始值减去低通，低频被去除
+    highpass1<1> hp(pole1);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, 0.98, (measure<highpass1<1>, 1>(hp, 20.0)));
+    hp.reset();
+    TEST_ASSERT_TRUE((measure<highpass1<1>, 1>(hp, 0.1)) < 0.15);
+}
+
+void test_biquad_response(void) {
+    // 巴特沃斯 Q 下截止频率处为 -3 dB，直流增益 1，奈奎斯特处为 0
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 1.0, gain(lp20, 0Hz, fs));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, M_SQRT1_2, gain(lp20, 20Hz, fs));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.0, gain(lp20, 100Hz, fs));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, M_SQRT1_2, gain(hp5, 5Hz, fs));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 1.0, gain(hp5, 100Hz, fs));
+
+    biquad<1> lp(lp20);
+    biquad<1> hp(hp5);
+    for (double f : { 1.0, 10.0, 20.0, 40.0, 80.0 }) {
+        lp.reset();
+        hp.reset();
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, gain(lp20, frq_t(f), fs), (measure<biquad<1>, 1>(lp, f)));
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, gain(hp5, frq_t(f), fs), (measure<biquad<1>, 1>(hp, f)));
+    }
+}
+
+void test_butterworth_cascade(void) {
+    // 4 阶：-3 dB 于截止频率，此后每倍频程约 -24 dB
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, M_SQRT1_2, gain(bw4, 10Hz, fs));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 1.0, gain(bw4, 0Hz, fs));
+    double g20 = gain(bw4, 20Hz, fs);
+    TEST_ASSERT_TRUE(g20 < 0.065 && g20 > 0.04);
+
+    biquad<1, 2> bw(bw4);
+    for (double f : { 2.0, 10.0, 20.0, 40.0 }) {
+        bw.reset();
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, gain(bw4, frq_t(f), fs), (measure<biquad<1, 2>, 1>(bw, f)));
+    }
+
+    // 通带单调
+    double prev = gain(bw4, 0Hz, fs);
+    for (int f = 1; f < 100; f++) {
+        double g = gain(bw4, frq_t(f), fs);
+        TEST_ASSERT_TRUE(g <= prev + 1e-9);
+        prev = g;
+    }
+
+    auto hp = butterworth_highpass<2>(10Hz, fs);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, M_SQRT1_2, gain(hp, 10Hz, fs));
+}
+
+void test_notch(void) {
+    constexpr auto n50 = biquad_coeffs::notch(50Hz, fs, 5.0);
+    biquad<1> flt(n50);
+    TEST_ASSERT_TRUE((measure<biquad<1>, 1>(flt, 50.0)) < 1e-3);
+    flt.reset();
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1.0, (measure<biquad<1>, 1>(flt, 10.0)));
+}
+
+void test_channels_independent(void) {
+    // 3 通道一次滤波与三个单通道滤波逐位相同
+    biquad<3, 2> soa(bw4);
+    biquad<1, 2> x(bw4), y(bw4), z(bw4);
+    for (int n = 0; n < 1000; n++) {
+        float in[3] = { sinf(n * 0.1f), n % 7 == 0 ? 1.0f : 0.0f, 0.5f };
+        float out[3], ox, oy, oz;
+        soa.step(in, out);
+        x.step(&in[0], &ox);
+        y.step(&in[1], &oy);
+        z.step(&in[2], &oz);
+        TEST_ASSERT_TRUE(out[0] == ox && out[1] == oy && out[2] == oz);
+    }
+
+    // 只激励一个通道时其它通道保持为 0
+    biquad<6> six(lp20);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, gain(lp20, 10Hz, fs), (measure<biquad<6>, 6>(six, 10.0, 4)));
+    float zero[6] = {}, out[6];
+    six.step(zero, out);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, out[0]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, out[5]);
+}
+
+void test_reset_steady_state(void) {
+    // 以常数输入复位后没有瞬态
+    biquad<2, 2> bw(bw4);
+    const float x[2] = { 1.0f, -0.25f };
+    float y[2];
+    bw.reset(x);
+    for (int n = 0; n < 50; n++) {
+        bw.step(x, y);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, y[0]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, -0.25f, y[1]);
+    }
+
+    lowpass1<2> lp(pole1);
+    lp.reset(x);
+    lp.step(x, y);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, y[0]);
+    TEST_ASSERT_EQUAL_FLOAT(-0.25f, y[1]);
+}
+
+void test_moving_average(void) {
+    moving_average<2, 8> ma;
+    float y[2];
+
+    // 窗口长度整数倍的频率被完全滤除
+    TEST_ASSERT_TRUE((measure<moving_average<2, 8>, 2>(ma, 25.0)) < 1e-6);
+    ma.reset();
+    double w = 2 * pi * 5.0 / fs.v;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, fabs(sin(8 * w / 2) / (8 * sin(w / 2))), (measure<moving_average<2, 8>, 2>(ma, 5.0)));
+
+    // 长时间运行后仍等于窗口内的精确均值
+    ma.reset();
+    uint32_t seed = 7;
+    float hist[8] = {};
+    for (int n = 0; n < 1000003; n++) {
+        seed        = seed * 1664525u + 1013904223u;
+        float v     = 1000.0f + (seed >> 8) / 16777216.0f;
+        hist[n % 8] = v;
+        float x[2]  = { v, -v };
+        ma.step(x, y);
+    }
+    double exact = 0;
+    for (float v : hist) exact += v;
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, static_cast<float>(exact / 8), y[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, static_cast<float>(-exact / 8), y[1]);
+
+    const float c[2] = { 3.0f, 4.0f };
+    ma.reset(c);
+    ma.step(c, y);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, y[0]);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, y[1]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_design_matches_libm);
+    RUN_TEST(test_one_pole_response);
+    RUN_TEST(test_biquad_response);
+    RUN_TEST(test_butterworth_cascade);
+    RUN_TEST(test_notch);
+    RUN_TEST(test_channels_independent);
+    RUN_TEST(test_reset_steady_state);
+    RUN_TEST(test_moving_average);
+    return UNITY_END();
+}
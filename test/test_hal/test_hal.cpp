@@ -0,0 +1,220 @@
+// test/test_hal/test_hal.cpp
+#include "hal_host.hpp"
+#include "led_frame.hpp"
+#include <unity.h>
+
+#include <string>
+
+using namespace hal;
+
+void setUp(void) {
+    host_clock::set(0);
+}
+
+void tearDown(void) {
+}
+
+// 通过 CRTP 基类调用，与目标板上的代码路径相同
+template <typename D>
+static auto load_through(matrix<D>& m, const uint32_t* words) -> void {
+    m.load(words);
+}
+
+void test_clock(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, host_clock::micros());
+    host_clock::advance(1500);
+    TEST_ASSERT_EQUAL_UINT32(1500, host_clock::now());
+    TEST_ASSERT_EQUAL_UINT32(1, host_clock::millis());
+
+    // micros 与硬件一样在 32 位处回绕，millis 独立计算
+    host_clock::set(uint64_t(1) << 32);
+    TEST_ASSERT_EQUAL_UINT32(0, host_clock::micros());
+    TEST_ASSERT_EQUAL_UINT32(4294967, host_clock::millis());
+}
+
+void test_matrix_record(void) {
+    host_matrix m;
+    m.begin();
+    TEST_ASSERT_TRUE(m.begun());
+
+    uint32_t f[led::words] = { 0x80000000, 0, 0x00000001 };
+    host_clock::advance(250);
+    load_through(m, f);
+    m.clear();
+
+    TEST_ASSERT_EQUAL(2, m.frames().size());
+    TEST_ASSERT_EQUAL_UINT32(250, m.frames()[0].t_us);
+    TEST_ASSERT_EQUAL_HEX32(0x80000000, m.frames()[0].words[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x00000001, m.frames()[0].words[2]);
+    TEST_ASSERT_EQUAL_HEX32(0, m.last()[0] | m.last()[1] | m.last()[2]);
+}
+
+void test_pbm(void) {
+    // 左上角与右下角各一个像素
+    uint32_t f[led::words] = { 0, 0, 0 };
+    led::set_bit(f, 0, true);
+    led::set_bit(f, 95, true);
+
+    std::string img = host_matrix::to_pbm({ f[0], f[1], f[2] });
+    std::string ref = "P1\n12 8\n"
+                      "1 0 0 0 0 0 0 0 0 0 0 0\n"
+                      "0 0 0 0 0 0 0 0 0 0 0 0\n"
+                      "0 0 0 0 0 0 0 0 0 0 0 0\n"
+                      "0 0 0 0 0 0 0 0 0 0 0 0\n"
+                      "0 0 0 0 0 0 0 0 0 0 0 0\n"
+                      "0 0 0 0 0 0 0 0 0 0 0 0\n"
+                      "0 0 0 0 0 0 0 0 0 0 0 0\n"
+                      "0 0 0 0 0 0 0 0 0 0 0 1\n";
+    TEST_ASSERT_EQUAL_STRING(ref.c_str(), img.c_str());
+
+    host_matrix m;
+    TEST_ASSERT_FALSE(m.save_pbm("/nonexistent/frame_", 0));
+}
+
+void test_buttons_script(void) {
+    static const host_buttons::event events[] = {
+        { 10, 'A', true },
+        { 20, 'A', false },
+        { 20, 'C', true },
+    };
+    host_buttons b;
+    b.play(events);
+
+    // 只有 update() 之后状态才变化
+    host_clock::set(15000);
+    TEST_ASSERT_FALSE(b.pressed('A'));
+    TEST_ASSERT_TRUE(b.update());
+    TEST_ASSERT_TRUE(b.pressed('A'));
+    TEST_ASSERT_FALSE(b.update());
+
+    host_clock::set(30000);
+    TEST_ASSERT_TRUE(b.update());
+    TEST_ASSERT_FALSE(b.pressed('A'));
+    TEST_ASSERT_TRUE(b.pressed('C'));
+    TEST_ASSERT_FALSE(b.pressed('X'));
+}
+
+void test_knob_script(void) {
+    static const host_knob::event events[] = {
+        { 0, 5, false },
+        { 100, 7, true },
+    };
+    host_knob k;
+    k.play(events);
+
+    TEST_ASSERT_EQUAL_INT16(5, k.get());
+    k.set(3);
+    TEST_ASSERT_EQUAL_INT16(3, k.get());
+    TEST_ASSERT_FALSE(k.pressed());
+
+    host_clock::set(100000);
+    TEST_ASSERT_TRUE(k.pressed());
+    TEST_ASSERT_EQUAL_INT16(7, k.get());
+}
+
+void test_imu_source(void) {
+    host_imu m;
+    TEST_ASSERT_TRUE(m.update());
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, m.z());
+
+    // 加速度随时间线性变化
+    m.source([](uint32_t t_us, float* xyz, void*) {
+        xyz[0] = t_us * 1e-6f;
+        xyz[1] = -1.0f;
+        xyz[2] = 0.0f;
+    });
+    host_clock::set(500000);
+    m.update();
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, m.x());
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, m.y());
+    TEST_ASSERT_EQUAL_UINT32(2, m.updates());
+
+    // 时间未前进时没有新样本
+    TEST_ASSERT_FALSE(m.update());
+    TEST_ASSERT_EQUAL_UINT32(2, m.updates());
+}
+
+// 关闭期间没有样本，重新打开后从当前时间开始
+void test_imu_stream(void) {
+    host_imu m;
+    m.period(5000);
+    host_clock::set(1000);
+    TEST_ASSERT_TRUE(m.update());
+    m.stream(false);
+    TEST_ASSERT_FALSE(m.streaming());
+
+    host_clock::set(100000);
+    TEST_ASSERT_FALSE(m.update());
+    m.stream(true);
+    TEST_ASSERT_TRUE(m.update());
+    TEST_ASSERT_EQUAL_UINT32(100000, m.t_us());
+    TEST_ASSERT_FALSE(m.update());
+    TEST_ASSERT_EQUAL_UINT32(2, m.updates());
+}
+
+void test_imu_period(void) {
+    // 设置周期后样本落在固定网格上，落后时逐个补齐，与 FIFO 的行为一致
+    host_imu m;
+    m.period(5000);
+    m.source([](uint32_t t_us, float* v, void*) { v[0] = static_cast<float>(t_us); });
+    host_clock::set(1000);
+    TEST_ASSERT_TRUE(m.update());
+    TEST_ASSERT_EQUAL_UINT32(1000, m.last_us());
+
+    host_clock::set(4000);
+    TEST_ASSERT_FALSE(m.update());
+
+    host_clock::set(17000);
+    int n = 0;
+    while (m.update()) n++;
+    TEST_ASSERT_EQUAL(3, n);
+    TEST_ASSERT_EQUAL_UINT32(16000, m.last_us());
+    TEST_ASSERT_EQUAL_FLOAT(16000.0f, m.x());
+}
+
+void test_pixels(void) {
+    host_pixels p;
+    p.set(2, color{ 1, 2, 3 }, 50);
+    p.set(8, color{ 9, 9, 9 }, 9);
+    TEST_ASSERT_EQUAL_UINT8(0, p.shown(2).brightness);
+
+    p.show();
+    TEST_ASSERT_EQUAL_UINT8(50, p.shown(2).brightness);
+    TEST_ASSERT_EQUAL_UINT8(3, p.shown(2).c.b);
+
+    p.clear();
+    p.show();
+    TEST_ASSERT_EQUAL_UINT8(0, p.shown(2).brightness);
+    TEST_ASSERT_EQUAL_UINT32(2, p.shows());
+}
+
+void test_serial(void) {
+    host_serial s;
+    s.feed("l2");
+    TEST_ASSERT_EQUAL(2, s.available());
+    TEST_ASSERT_EQUAL('l', s.read());
+    TEST_ASSERT_EQUAL('2', s.read());
+    TEST_ASSERT_EQUAL(-1, s.read());
+
+    s.print("runs ");
+    s.print(0ul);
+    s.print(' ');
+    s.print(4294967295ul);
+    s.println("");
+    TEST_ASSERT_EQUAL_STRING("runs 0 4294967295\n", s.output().c_str());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clock);
+    RUN_TEST(test_matrix_record);
+    RUN_TEST(test_pbm);
+    RUN_TEST(test_buttons_script);
+    RUN_TEST(test_knob_script);
+    RUN_TEST(test_imu_source);
+    RUN_TEST(test_imu_period);
+    RUN_TEST(test_imu_stream);
+    RUN_TEST(test_pixels);
+    RUN_TEST(test_serial);
+    return UNITY_END();
+}
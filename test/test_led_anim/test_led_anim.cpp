@@ -0,0 +1,164 @@
+// test/test_led_anim/test_led_anim.cpp
+#include "led_anim.hpp"
+#include <unity.h>
+
+using namespace led;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static const anim_frame frames[] = {
+    { { 1, 0, 0 }, 100 },
+    { { 2, 0, 0 }, 50 },
+    { { 3, 0, 0 }, 200 },
+};
+
+static const sequence three{ frames, 3, 0, nullptr, nullptr };
+
+void test_once(void) {
+    player p;
+    uint32_t f[words] = { 0, 0, 0 };
+
+    TEST_ASSERT_EQUAL(player::idle, p.tick(0, f));
+    TEST_ASSERT_TRUE(p.play(three));
+
+    // 第一帧立即输出，之后按各帧时长切换
+    TEST_ASSERT_EQUAL(player::frame, p.tick(1000, f));
+    TEST_ASSERT_EQUAL_HEX32(1, f[0]);
+    TEST_ASSERT_EQUAL(player::hold, p.tick(1099, f));
+    TEST_ASSERT_EQUAL(player::frame, p.tick(1100, f));
+    TEST_ASSERT_EQUAL_HEX32(2, f[0]);
+    TEST_ASSERT_EQUAL(player::hold, p.tick(1149, f));
+    TEST_ASSERT_EQUAL(player::frame, p.tick(1150, f));
+    TEST_ASSERT_EQUAL_HEX32(3, f[0]);
+    TEST_ASSERT_EQUAL(player::hold, p.tick(1349, f));
+    TEST_ASSERT_EQUAL(player::done, p.tick(1350, f));
+    TEST_ASSERT_FALSE(p.active());
+    TEST_ASSERT_EQUAL(player::idle, p.tick(1400, f));
+}
+
+void test_loop(void) {
+    player p;
+    uint32_t f[words] = { 0, 0, 0 };
+
+    p.play(three, play_mode::loop);
+    uint32_t seen = 0;
+    for (uint32_t t = 0; t < 3500; t++) {
+        if (p.tick(t, f) == player::frame) seen++;
+    }
+    // 周期 350 ms，每周期三帧
+    TEST_ASSERT_EQUAL_UINT32(30, seen);
+    TEST_ASSERT_TRUE(p.active());
+
+    p.stop();
+    TEST_ASSERT_EQUAL(player::idle, p.tick(3500, f));
+}
+
+void test_late_tick(void) {
+    player p;
+    uint32_t f[words] = { 0, 0, 0 };
+
+    p.play(three, play_mode::loop);
+    p.tick(0, f);
+
+    // 晚了很久也只前进一帧，并从当前时刻重新计时
+    TEST_ASSERT_EQUAL(player::frame, p.tick(10000, f));
+    TEST_ASSERT_EQUAL_HEX32(2, f[0]);
+    TEST_ASSERT_EQUAL(player::hold, p.tick(10049, f));
+    TEST_ASSERT_EQUAL(player::frame, p.tick(10050, f));
+    TEST_ASSERT_EQUAL_HEX32(3, f[0]);
+
+    // 稍晚时保持相位
+    TEST_ASSERT_EQUAL(player::frame, p.tick(10260, f));
+    TEST_ASSERT_EQUAL_HEX32(1, f[0]);
+    TEST_ASSERT_EQUAL(player::hold, p.tick(10349, f));
+    TEST_ASSERT_EQUAL(player::frame, p.tick(10350, f));
+}
+
+void test_preempt(void) {
+    player p;
+    uint32_t f[words] = { 0, 0, 0 };
+
+    sequence flash{ nullptr, 2, 10, render_flash, nullptr };
+
+    p.play(three, play_mode::loop, 5);
+    p.tick(0, f);
+    p.tick(100, f);
+    TEST_ASSERT_EQUAL_HEX32(2, f[0]);
+
+    // 低优先级被拒绝
+    TEST_ASSERT_FALSE(p.play(flash, play_mode::once, 4));
+
+    // 高优先级的单次动画打断循环动画
+    TEST_ASSERT_TRUE(p.play(flash, play_mode::once, 9));
+    TEST_ASSERT_EQUAL(player::frame, p.tick(110, f));
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, f[2]);
+    TEST_ASSERT_EQUAL(player::frame, p.tick(120, f));
+    TEST_ASSERT_EQUAL_HEX32(0, f[2]);
+
+    // 结束后恢复被打断的循环动画
+    TEST_ASSERT_EQUAL(player::frame, p.tick(130, f));
+    TEST_ASSERT_EQUAL_HEX32(2, f[0]);
+    TEST_ASSERT_EQUAL_UINT8(5, p.priority());
+    TEST_ASSERT_EQUAL(player::frame, p.tick(180, f));
+    TEST_ASSERT_EQUAL_HEX32(3, f[0]);
+
+    // 空序列无效
+    sequence empty{ nullptr, 0, 10, render_flash, nullptr };
+    TEST_ASSERT_FALSE(p.play(empty, play_mode::once, 255));
+}
+
+void test_blink(void) {
+    uint32_t f[words] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+    uint8_t g         = 8;
+
+    render_blink(f, 0, &g);
+    uint32_t ref[words] = { 0, 0, 0 };
+    draw_glyph(ref, 8, 4, 1);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(ref, f, words);
+
+    render_blink(f, 1, &g);
+    TEST_ASSERT_EQUAL_HEX32(0, f[0] | f[1] | f[2]);
+}
+
+void test_scroll(void) {
+    const uint8_t text[] = { 1, 2 };
+    scroll_text t{ text, 2 };
+    TEST_ASSERT_EQUAL_UINT16(20, t.steps());
+
+    uint32_t f[words];
+
+    // 第 0 步在屏幕右侧之外
+    render_scroll(f, 0, &t);
+    TEST_ASSERT_EQUAL_HEX32(0, f[0] | f[1] | f[2]);
+
+    // 第 12 步两个字形分别在第 0 列和第 4 列
+    uint32_t ref[words] = { 0, 0, 0 };
+    draw_glyph(ref, 1, 0, 1);
+    draw_glyph(ref, 2, 4, 1);
+    render_scroll(f, 12, &t);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(ref, f, words);
+
+    // 部分移出左边缘时被裁剪，不会写到上一行
+    ref[0] = ref[1] = ref[2] = 0;
+    draw_glyph(ref, 2, 0, 1);
+    render_scroll(f, 16, &t);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(ref, f, words);
+
+    render_scroll(f, t.steps() - 1, &t);
+    TEST_ASSERT_EQUAL_HEX32(0, f[0] | f[1] | f[2]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_once);
+    RUN_TEST(test_loop);
+    RUN_TEST(test_late_tick);
+    RUN_TEST(test_preempt);
+    RUN_TEST(test_blink);
+    RUN_TEST(test_scroll);
+    return UNITY_END();
+}
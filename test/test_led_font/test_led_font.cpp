@@ -0,0 +1,136 @@
+// test/test_led_font/test_led_font.cpp
+#include "led_frame.hpp"
+#include <unity.h>
+
+#include <string.h>
+
+using namespace led;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 原来手写的 0b 字面量字体
+static const uint8_t legacy_3x5[17][5] = {
+    { 0b111, 0b101, 0b101, 0b101, 0b111 }, { 0b010, 0b110, 0b010, 0b010, 0b111 }, { 0b111, 0b001, 0b111, 0b100, 0b111 },
+    { 0b111, 0b001, 0b111, 0b001, 0b111 }, { 0b101, 0b101, 0b111, 0b001, 0b001 }, { 0b111, 0b100, 0b111, 0b001, 0b111 },
+    { 0b111, 0b100, 0b111, 0b101, 0b111 }, { 0b111, 0b001, 0b001, 0b001, 0b001 }, { 0b111, 0b101, 0b111, 0b101, 0b111 },
+    { 0b111, 0b101, 0b111, 0b001, 0b111 }, { 0b010, 0b101, 0b111, 0b101, 0b101 }, { 0b110, 0b101, 0b110, 0b101, 0b110 },
+    { 0b111, 0b100, 0b100, 0b100, 0b111 }, { 0b110, 0b001, 0b001, 0b001, 0b110 }, { 0b111, 0b100, 0b111, 0b100, 0b111 },
+    { 0b111, 0b100, 0b111, 0b100, 0b100 }, { 0b000, 0b000, 0b111, 0b000, 0b000 },
+};
+
+// 原 utils/frame_gen.py 中 6x8 字体的 0 和 A
+static const uint8_t legacy_6x8_0[8] = { 0b011110, 0b100001, 0b100011, 0b100101, 0b101001, 0b110001, 0b100001, 0b011110 };
+static const uint8_t legacy_6x8_A[8] = { 0b001100, 0b010010, 0b100001, 0b100001, 0b111111, 0b100001, 0b100001, 0b100001 };
+
+void test_legacy_fonts(void) {
+    const char* chars = "0123456789ABCDEF-";
+    for (int g = 0; g < 17; g++) {
+        const font_glyph* fg = font_3x5.find(chars[g]);
+        TEST_ASSERT_NOT_NULL(fg);
+        TEST_ASSERT_EQUAL_UINT8(3, fg->width);
+        for (int r = 0; r < 5; r++) TEST_ASSERT_EQUAL_HEX16(legacy_3x5[g][r] << 9, fg->rows[r]);
+    }
+
+    for (int r = 0; r < 8; r++) {
+        TEST_ASSERT_EQUAL_HEX16(legacy_6x8_0[r] << 6, font_6x8.find('0')->rows[r]);
+        TEST_ASSERT_EQUAL_HEX16(legacy_6x8_A[r] << 6, font_6x8.find('A')->rows[r]);
+    }
+}
+
+void test_compile(void) {
+    static constexpr const char* art[] = {
+        "#."
+        ".#",
+        "###"
+        "..#",
+    };
+    static constexpr auto t = compile_font("ab", art, 2, 2);
+    constexpr font f = t.view();
+
+    static_assert(t.glyphs[0].width == 2, "width from literal length");
+    static_assert(t.glyphs[1].width == 3, "proportional widths");
+    static_assert(t.glyphs[1].rows[1] == 0b001 << 9, "rows are frame aligned");
+
+    TEST_ASSERT_EQUAL_HEX16(0b10 << 10, f.find('a')->rows[0]);
+    TEST_ASSERT_EQUAL_HEX16(0b01 << 10, f.find('a')->rows[1]);
+    TEST_ASSERT_NULL(f.find('c'));
+    TEST_ASSERT_NULL(f.find(static_cast<char>(0xC8)));
+
+    TEST_ASSERT_EQUAL_INT(2 + 2 + 3, text_width(f, "ab"));
+    TEST_ASSERT_EQUAL_INT(7, text_width(f, "acb")); // 缺失字符不占位
+    TEST_ASSERT_EQUAL_INT(0, text_width(f, ""));
+    TEST_ASSERT_EQUAL_INT(5, text_width(font_prop, "M"));
+    TEST_ASSERT_EQUAL_INT(1 + 1 + 3, text_width(font_prop, "I0"));
+}
+
+// 逐像素的参照实现
+static auto draw_text_bitwise(uint32_t* f, const font& fnt, const char* s, int x, int y) -> void {
+    for (; *s; s++) {
+        const font_glyph* g = fnt.find(*s);
+        if (!g) continue;
+        for (int r = 0; r < fnt.height; r++)
+            for (int c = 0; c < g->width; c++) {
+                if (!((g->rows[r] >> (font_row_bits - 1 - c)) & 1)) continue;
+                if (x + c < 0 || x + c >= width || y + r < 0 || y + r >= height) continue;
+                set_bit(f, (y + r) * width + x + c, true);
+            }
+        x += g->width + fnt.spacing;
+    }
+}
+
+void test_draw_text(void) {
+    const font* fonts[] = { &font_3x5, &font_6x8, &font_prop };
+    const char* texts[] = { "0", "-12", "ABCDEF", "HELLO WORLD!", "8:8.", "F00D" };
+
+    for (const font* fnt : fonts) {
+        for (const char* text : texts) {
+            for (int y = -9; y <= 9; y++) {
+                for (int x = -30; x <= 13; x++) {
+                    uint32_t a[words] = { 0x01020304, 0, 0x80000001 };
+                    uint32_t b[words] = { 0x01020304, 0, 0x80000001 };
+                    draw_text_bitwise(a, *fnt, text, x, y);
+                    int end = draw_text(b, *fnt, text, x, y);
+                    TEST_ASSERT_EQUAL_HEX32_ARRAY(a, b, words);
+                    TEST_ASSERT_EQUAL_INT(x + text_width(*fnt, text) + (text_width(*fnt, text) ? fnt->spacing : 0), end);
+                }
+            }
+        }
+    }
+}
+
+void test_draw_matches_digits(void) {
+    // 3x5 字体画出的四位数与数字槽位引擎一致
+    uint8_t d[4] = { 1, 10, 16, 7 };
+    uint32_t a[words] = { 0, 0, 0 };
+    uint32_t b[words] = { 0, 0, 0 };
+    draw_digits(a, d[0], d[1], d[2], d[3]);
+
+    font packed = font_3x5;
+    TEST_ASSERT_EQUAL_UINT8(1, packed.spacing);
+    packed.spacing = 0;
+    draw_text(b, packed, "1A-7", 0, 0);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(a, b, words);
+}
+
+void test_format_int(void) {
+    char buf[34];
+    TEST_ASSERT_EQUAL_STRING("0", format_int(0, 10, buf));
+    TEST_ASSERT_EQUAL_STRING("-42", format_int(-42, 10, buf));
+    TEST_ASSERT_EQUAL_STRING("FF", format_int(255, 16, buf));
+    TEST_ASSERT_EQUAL_STRING("-80000000", format_int(INT32_MIN, 16, buf));
+    TEST_ASSERT_EQUAL_STRING("1111", format_int(15, 1, buf)); // 进制被限制到 2..16
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_legacy_fonts);
+    RUN_TEST(test_compile);
+    RUN_TEST(test_draw_text);
+    RUN_TEST(test_draw_matches_digits);
+    RUN_TEST(test_format_int);
+    return UNITY_END();
+}
@@ -0,0 +1,148 @@
+// test/test_led_frame/test_led_frame.cpp
+#include "led_frame.hpp"
+#include <unity.h>
+
+#include <string.h>
+
+using namespace led;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 原 LED_Matrix::print(int32_t, int) 的取位逻辑，作为对照
+static auto split_reference(int32_t val, int base, uint8_t* d) -> void {
+    base = base < 2 ? 2 : base > 16 ? 16 : base;
+
+    int32_t max_positive = base * base * base * base - 1;
+    int32_t min_negative = -(base * base * base - 1);
+
+    val = val < min_negative ? min_negative : val > max_positive ? max_positive : val;
+
+    if (val < 0) {
+        d[0] = 16;
+        val  = -val;
+
+        d[3] = val % base;
+        val /= base;
+        d[2] = val % base;
+        val /= base;
+        d[1] = val % base;
+    } else {
+        d[3] = val % base;
+        val /= base;
+        d[2] = val % base;
+        val /= base;
+        d[1] = val % base;
+        val /= base;
+        d[0] = val % base;
+    }
+}
+
+void test_set_bit(void) {
+    uint32_t f[words] = { 0, 0, 0 };
+
+    set_bit(f, 0, true);
+    set_bit(f, 33, true);
+    set_bit(f, 95, true);
+    TEST_ASSERT_EQUAL_HEX32(0x80000000, f[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x40000000, f[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x00000001, f[2]);
+
+    // 可以清除
+    set_bit(f, 33, false);
+    TEST_ASSERT_EQUAL_HEX32(0, f[1]);
+
+    // 越界忽略
+    set_bit(f, -1, true);
+    set_bit(f, 96, true);
+    TEST_ASSERT_EQUAL_HEX32(0x80000000, f[0]);
+    TEST_ASSERT_EQUAL_HEX32(0, f[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x00000001, f[2]);
+}
+
+void test_masks(void) {
+    // 每个槽位 15 个像素，互不重叠，只占前 5 行
+    uint32_t seen[words] = { 0, 0, 0 };
+    for (int s = 0; s < slot_count; s++) {
+        int n = 0;
+        for (int w = 0; w < words; w++) {
+            n += __builtin_popcount(box_masks[s][w]);
+            TEST_ASSERT_EQUAL_HEX32(0, seen[w] & box_masks[s][w]);
+            seen[w] |= box_masks[s][w];
+
+            for (size_t g = 0; g < glyph_count; g++) {
+                TEST_ASSERT_EQUAL_HEX32(0, glyph_masks[s][g][w] & ~box_masks[s][w]);
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(glyph_width * glyph_height, n);
+    }
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, seen[0]);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFF0, seen[1]);
+    TEST_ASSERT_EQUAL_HEX32(0, seen[2]);
+}
+
+// 所有进制下的所有可显示数值（含两端越界）与逐位渲染结果一致
+void test_exhaustive(void) {
+    for (int base = 2; base <= 16; base++) {
+        int32_t max_positive = base * base * base * base - 1;
+        int32_t min_negative = -(base * base * base - 1);
+
+        for (int32_t v = min_negative - 3; v <= max_positive + 3; v++) {
+            uint8_t ref[4], dig[4];
+            split_reference(v, base, ref);
+            split_digits(v, base, dig);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, dig, 4);
+
+            uint32_t a[words] = { 0, 0, 0 };
+            uint32_t b[words] = { 0, 0, 0 };
+            draw_digits_bitwise(a, ref[0], ref[1], ref[2], ref[3]);
+            draw_digits(b, dig[0], dig[1], dig[2], dig[3]);
+            if (memcmp(a, b, sizeof(a)) != 0) {
+                TEST_ASSERT_EQUAL_HEX32_ARRAY(a, b, words);
+            }
+        }
+    }
+}
+
+// 在已有内容上绘制：字形区域被覆盖，其余像素保持不变
+void test_overdraw(void) {
+    uint32_t seed = 12345;
+    for (int i = 0; i < 10000; i++) {
+        uint32_t a[words];
+        for (auto& w : a) {
+            seed = seed * 1664525u + 1013904223u;
+            w    = seed;
+        }
+        uint32_t b[words] = { a[0], a[1], a[2] };
+
+        uint8_t g[4];
+        for (auto& d : g) {
+            seed = seed * 1664525u + 1013904223u;
+            d    = (seed >> 16) % glyph_count;
+        }
+
+        draw_digits_bitwise(a, g[0], g[1], g[2], g[3]);
+        draw_digits(b, g[0], g[1], g[2], g[3]);
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(a, b, words);
+    }
+
+    // 全亮背景上画 8888，第 1 行为 101101101101，后三行不变
+    uint32_t f[words] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+    draw_digits(f, 8, 8, 8, 8);
+    TEST_ASSERT_EQUAL_HEX32(0xFFF, f[0] >> 20);
+    TEST_ASSERT_EQUAL_HEX32(0xB6D, (f[0] >> 8) & 0xFFF);
+    TEST_ASSERT_EQUAL_HEX32(0xF, f[1] & 0xF);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, f[2]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_set_bit);
+    RUN_TEST(test_masks);
+    RUN_TEST(test_exhaustive);
+    RUN_TEST(test_overdraw);
+    return UNITY_END();
+}
@@ -0,0 +1,199 @@
+// test/test_led_pack/test_led_pack.cpp
+#include "led_assets.hpp"
+#include "led_pack.hpp"
+#include <unity.h>
+
+#include <string.h>
+
+#include <vector>
+
+using namespace led;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+struct source_frame {
+    uint32_t w[words];
+    uint16_t duration_ms;
+};
+
+static auto pack_all(const std::vector<source_frame>& frames) -> std::vector<uint8_t> {
+    std::vector<uint8_t> blob{ static_cast<uint8_t>(frames.size()) };
+    uint32_t prev[words] = { 0, 0, 0 };
+    for (auto& f : frames) {
+        uint8_t buf[pack::max_frame_size];
+        size_t n = pack_frame(prev, f.w, f.duration_ms, buf);
+        TEST_ASSERT_TRUE(n <= pack::max_frame_size);
+        blob.insert(blob.end(), buf, buf + n);
+        memcpy(prev, f.w, sizeof(prev));
+    }
+    return blob;
+}
+
+static auto check_round_trip(const std::vector<source_frame>& frames) -> void {
+    auto blob = pack_all(frames);
+
+    // 逐帧解码
+    uint32_t cur[words] = { 0, 0, 0 };
+    const uint8_t* p    = blob.data() + 1;
+    for (auto& f : frames) {
+        uint16_t dur = 0;
+        p            = unpack_frame(p, blob.data() + blob.size(), cur, &dur);
+        TEST_ASSERT_NOT_NULL(p);
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(f.w, cur, words);
+        TEST_ASSERT_EQUAL_UINT16((f.duration_ms > 2550 ? 2550 : f.duration_ms / 10 * 10), dur); // 10 ms 单位，最长 2.55 s
+    }
+    TEST_ASSERT_EQUAL_PTR(blob.data() + blob.size(), p);
+
+    // 通过 packed_anim 顺序和倒序访问
+    packed_anim anim(blob.data(), blob.size());
+    TEST_ASSERT_EQUAL_UINT16(frames.size(), anim.count());
+    for (uint16_t i = 0; i < frames.size(); i++) {
+        const uint32_t* f = anim.seek(i);
+        TEST_ASSERT_NOT_NULL(f);
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(frames[i].w, f, words);
+    }
+    for (uint16_t i = frames.size(); i-- > 0;) {
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(frames[i].w, anim.seek(i), words);
+    }
+    TEST_ASSERT_NULL(anim.seek(frames.size()));
+}
+
+void test_round_trip_random(void) {
+    uint32_t seed = 2024;
+    auto next     = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed;
+    };
+
+    for (int round = 0; round < 200; round++) {
+        std::vector<source_frame> frames(1 + next() % 40);
+        uint32_t cur[words] = { 0, 0, 0 };
+        for (auto& f : frames) {
+            // 混合小改动、整字节重复和完全随机的帧
+            switch (next() % 4) {
+            case 0: break;
+            case 1: set_bit(cur, next() % 96, next() & 1); break;
+            case 2: cur[next() % 3] ^= 0xFFFFFFFF; break;
+            default:
+                for (auto& w : cur) w = next();
+                break;
+            }
+            memcpy(f.w, cur, sizeof(cur));
+            f.duration_ms = next() % 3000;
+        }
+        check_round_trip(frames);
+    }
+}
+
+void test_small_deltas(void) {
+    // 相同的帧只占 2 字节，单像素变化占 4 字节
+    std::vector<source_frame> frames = {
+        { { 0x12345678, 0x9ABCDEF0, 0x0F0F0F0F }, 100 },
+        { { 0x12345678, 0x9ABCDEF0, 0x0F0F0F0F }, 100 },
+        { { 0x12345678, 0x9ABCDEF1, 0x0F0F0F0F }, 100 },
+        { { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF }, 100 },
+        { { 0, 0, 0 }, 100 },
+    };
+    check_round_trip(frames);
+
+    auto blob = pack_all(frames);
+    uint8_t buf[pack::max_frame_size];
+    TEST_ASSERT_EQUAL(2, pack_frame(frames[0].w, frames[1].w, 100, buf));
+    TEST_ASSERT_EQUAL(5, pack_frame(frames[1].w, frames[2].w, 100, buf)); // 跳过、字面、跳过
+    TEST_ASSERT_EQUAL(3, pack_frame(frames[4].w, frames[3].w, 100, buf)); // 一个重复 token
+}
+
+// python 打包器生成的数据：逐帧解码后用 C++ 编码器重新打包，结果逐字节一致
+void test_asset(void) {
+    packed_anim anim(assets::boot);
+    TEST_ASSERT_TRUE(anim.count() > 0);
+
+    std::vector<uint8_t> repacked{ static_cast<uint8_t>(anim.count()) };
+    uint32_t prev[words] = { 0, 0, 0 };
+    for (uint16_t i = 0; i < anim.count(); i++) {
+        const uint32_t* f = anim.seek(i);
+        TEST_ASSERT_NOT_NULL(f);
+
+        uint8_t buf[pack::max_frame_size];
+        size_t n = pack_frame(prev, f, anim.duration(), buf);
+        repacked.insert(repacked.end(), buf, buf + n);
+        memcpy(prev, f, sizeof(prev));
+    }
+    TEST_ASSERT_EQUAL(sizeof(assets::boot), repacked.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(assets::boot, repacked.data(), repacked.size());
+
+    // 最后一帧全灭
+    TEST_ASSERT_EQUAL_HEX32(0, prev[0] | prev[1] | prev[2]);
+}
+
+void test_malformed(void) {
+    uint32_t f[words] = { 0, 0, 0 };
+
+    const uint8_t overrun[]  = { 1, 10, 0x0C };             // 跳过 13 字节
+    const uint8_t bad_kind[] = { 1, 10, 0xC0 };             // 未定义的 token
+    const uint8_t ok[]       = { 1, 10, 0x41, 0xAA, 0x09 }; // 2 字节 0xAA，跳过其余 10 字节
+
+    TEST_ASSERT_NULL(unpack_frame(overrun + 1, overrun + sizeof(overrun), f, nullptr));
+    TEST_ASSERT_NULL(unpack_frame(bad_kind + 1, bad_kind + sizeof(bad_kind), f, nullptr));
+
+    uint16_t dur = 0;
+    TEST_ASSERT_EQUAL_PTR(ok + sizeof(ok), unpack_frame(ok + 1, ok + sizeof(ok), f, &dur));
+    TEST_ASSERT_EQUAL_UINT16(100, dur);
+    TEST_ASSERT_EQUAL_HEX32(0xAAAA0000, f[0]);
+
+    // 截断的数据不越过末尾：在每个位置截断都返回 nullptr
+    for (size_t n = 1; n < sizeof(ok); n++) {
+        uint32_t g[words] = { 0, 0, 0 };
+        TEST_ASSERT_NULL(unpack_frame(ok + 1, ok + n, g, nullptr));
+    }
+    const uint8_t literal[] = { 1, 10, 0x8B, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }; // 少一个字面字节
+    TEST_ASSERT_NULL(unpack_frame(literal + 1, literal + sizeof(literal), f, nullptr));
+
+    packed_anim anim(overrun);
+    TEST_ASSERT_NULL(anim.seek(0));
+
+    // 帧数声明为 2，数据只有 1 帧
+    const uint8_t short_blob[] = { 2, 10, 0x0B };
+    packed_anim cut(short_blob);
+    TEST_ASSERT_NOT_NULL(cut.seek(0));
+    TEST_ASSERT_NULL(cut.seek(1));
+    TEST_ASSERT_EQUAL_UINT16(0, packed_anim(short_blob, 0).count());
+}
+
+void test_sequence(void) {
+    packed_anim anim(assets::boot);
+    sequence seq = anim.seq();
+    player p;
+    uint32_t f[words];
+
+    p.play(seq);
+    TEST_ASSERT_EQUAL(player::frame, p.tick(0, f));
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(anim.seek(0), f, words);
+
+    // 每帧按各自的时长推进
+    uint32_t t = 0;
+    uint16_t n = 1;
+    for (; n < anim.count(); n++) {
+        anim.seek(n - 1);
+        t += anim.duration();
+        TEST_ASSERT_EQUAL(player::hold, p.tick(t - 1, f));
+        TEST_ASSERT_EQUAL(player::frame, p.tick(t, f));
+        uint32_t expect[words];
+        memcpy(expect, anim.seek(n), sizeof(expect));
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(expect, f, words);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_random);
+    RUN_TEST(test_small_deltas);
+    RUN_TEST(test_asset);
+    RUN_TEST(test_malformed);
+    RUN_TEST(test_sequence);
+    return UNITY_END();
+}
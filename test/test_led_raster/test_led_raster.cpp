@@ -0,0 +1,151 @@
+// test/test_led_raster/test_led_raster.cpp
+#include "led_raster.hpp"
+#include <unity.h>
+
+#include <utility>
+
+using namespace led;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 逐像素参照实现
+static auto ref_pixel(uint32_t* f, int x, int y) -> void {
+    if (x >= 0 && x < width && y >= 0 && y < height) set_bit(f, y * width + x, true);
+}
+
+static auto ref_rect(uint32_t* f, int x0, int y0, int x1, int y1, bool filled) -> void {
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+            if (filled || x == x0 || x == x1 || y == y0 || y == y1) ref_pixel(f, x, y);
+}
+
+static auto lit(const uint32_t* f, int x, int y) -> bool {
+    int idx = y * width + x;
+    return (f[idx / 32] >> (31 - idx % 32)) & 1;
+}
+
+void test_bit_range(void) {
+    for (int a = 0; a <= 96; a++) {
+        for (int b = a; b <= 96; b++) {
+            mask m = __details::bit_range(a, b);
+            for (int i = 0; i < 96; i++) {
+                bool in = (m[i / 32] >> (31 - i % 32)) & 1;
+                TEST_ASSERT_EQUAL(i >= a && i < b, in);
+            }
+        }
+    }
+}
+
+void test_lines(void) {
+    for (int y = -2; y < height + 2; y++) {
+        for (int a = -3; a < width + 3; a++) {
+            for (int b = -3; b < width + 3; b++) {
+                uint32_t r[words] = { 0x00100000, 0, 1 };
+                uint32_t f[words] = { 0x00100000, 0, 1 };
+                ref_rect(r, a, y, b, y, true);
+                hline(f, a, b, y);
+                TEST_ASSERT_EQUAL_HEX32_ARRAY(r, f, words);
+            }
+        }
+    }
+    for (int x = -2; x < width + 2; x++) {
+        for (int a = -3; a < height + 3; a++) {
+            for (int b = -3; b < height + 3; b++) {
+                uint32_t r[words] = { 0, 0x80000000, 0 };
+                uint32_t f[words] = { 0, 0x80000000, 0 };
+                ref_rect(r, x, a, x, b, true);
+                vline(f, x, a, b);
+                TEST_ASSERT_EQUAL_HEX32_ARRAY(r, f, words);
+            }
+        }
+    }
+}
+
+void test_rects(void) {
+    for (int x0 = -2; x0 < width + 2; x0 += 1)
+        for (int x1 = -2; x1 < width + 2; x1 += 3)
+            for (int y0 = -2; y0 < height + 2; y0++)
+                for (int y1 = -2; y1 < height + 2; y1 += 2)
+                    for (int filled = 0; filled < 2; filled++) {
+                        uint32_t r[words] = { 0, 0, 0 };
+                        uint32_t f[words] = { 0, 0, 0 };
+                        ref_rect(r, x0, y0, x1, y1, filled);
+                        rect(f, x0, y0, x1, y1, filled);
+                        TEST_ASSERT_EQUAL_HEX32_ARRAY(r, f, words);
+                    }
+}
+
+void test_pixel(void) {
+    uint32_t f[words] = { 0, 0, 0 };
+    pixel(f, -1, 0);
+    pixel(f, 12, 0); // 不会写到下一行
+    pixel(f, 0, 8);
+    TEST_ASSERT_EQUAL_HEX32(0, f[0] | f[1] | f[2]);
+
+    pixel(f, 11, 7);
+    TEST_ASSERT_EQUAL_HEX32(1, f[2]);
+    pixel(f, 11, 7, false);
+    TEST_ASSERT_EQUAL_HEX32(0, f[2]);
+}
+
+void test_bars(void) {
+    TEST_ASSERT_EQUAL_INT(0, scale(-5, 0, 100, 8));
+    TEST_ASSERT_EQUAL_INT(4, scale(50, 0, 100, 8));
+    TEST_ASSERT_EQUAL_INT(8, scale(100, 0, 100, 8));
+    TEST_ASSERT_EQUAL_INT(8, scale(1000, 0, 100, 8));
+    TEST_ASSERT_EQUAL_INT(0, scale(5, 10, 10, 8));
+
+    int32_t values[width] = { 0, 12, 25, 37, 50, 62, 75, 87, 100, 200, -1, 50 };
+    uint32_t f[words]     = { 0, 0, 0 };
+    bar_graph(f, values, width, 0, 100);
+    for (int x = 0; x < width; x++) {
+        int n = scale(values[x], 0, 100, height);
+        for (int y = 0; y < height; y++) TEST_ASSERT_EQUAL(y >= height - n, lit(f, x, y));
+    }
+
+    uint32_t h[words] = { 0, 0, 0 };
+    bar_h(h, 3, 50, 0, 100);
+    for (int x = 0; x < width; x++) TEST_ASSERT_EQUAL(x < 6, lit(h, x, 3));
+}
+
+void test_strip_chart(void) {
+    strip_chart chart(0, 70);
+    uint32_t f[words] = { 0, 0, 0 };
+
+    // 空图表不画任何东西
+    chart.draw(f);
+    TEST_ASSERT_EQUAL_HEX32(0, f[0] | f[1] | f[2]);
+
+    // 最新的样本在最右列
+    for (int i = 0; i < 20; i++) chart.push(i * 10);
+    chart.draw(f);
+    for (int x = 0; x < width; x++) {
+        int v   = (20 - width + x) * 10;
+        int row = height - 1 - scale(v, 0, 70, height - 1);
+        for (int y = 0; y < height; y++) TEST_ASSERT_EQUAL(y == row, lit(f, x, y));
+    }
+
+    uint32_t b[words] = { 0, 0, 0 };
+    chart.clear();
+    chart.push(35);
+    chart.draw(b, strip_chart::bars);
+    for (int y = 0; y < height; y++) TEST_ASSERT_EQUAL(y >= 3, lit(b, width - 1, y));
+    for (int y = 0; y < height; y++) TEST_ASSERT_FALSE(lit(b, width - 2, y));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bit_range);
+    RUN_TEST(test_lines);
+    RUN_TEST(test_rects);
+    RUN_TEST(test_pixel);
+    RUN_TEST(test_bars);
+    RUN_TEST(test_strip_chart);
+    return UNITY_END();
+}
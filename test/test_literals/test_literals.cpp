@@ -0,0 +1,130 @@
+// test/test_literals/test_literals.cpp
+#include "literals.hpp"
+#include <unity.h>
+
+#include <type_traits>
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 默认仍是 double，原有写法不变
+void test_default_double(void) {
+    using namespace literals;
+    static_assert(std::is_same<val_t::rep, double>::value, "默认 double");
+    static_assert(std::is_same<decltype(1m / 2s), val_t>::value, "量纲推导");
+
+    constexpr val_t v = 1.5m / 500ms;
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, v.v);
+    TEST_ASSERT_EQUAL_DOUBLE(0.000002, (2us).v);
+    TEST_ASSERT_EQUAL_DOUBLE(1500.0, (1.5km).v);
+    TEST_ASSERT_TRUE(1m > 999mm);
+}
+
+// 字面量命名空间决定表示
+void test_literal_namespaces(void) {
+    {
+        using namespace literals::f32;
+        static_assert(std::is_same<decltype(0.1m), leng_t>::value, "f32 字面量");
+        static_assert(std::is_same<decltype(0.1m)::rep, float>::value, "float");
+        constexpr val_t v = 0.1m / 20ms;
+        TEST_ASSERT_EQUAL_FLOAT(5.0f, v.v);
+        // 标量不改变表示
+        static_assert(std::is_same<decltype(v * 2.0), val_t>::value, "标量不提升");
+    }
+    {
+        using namespace literals::q16;
+        static_assert(std::is_same<decltype(0.1m)::rep, fxp::q16_16>::value, "q16");
+        constexpr dura_t dt = 5ms;
+        TEST_ASSERT_EQUAL_INT32(328, dt.v.raw); // 0.005 * 65536 = 327.68
+        val_t v = 0.1m / 0.5s;
+        TEST_ASSERT_FLOAT_WITHIN(2e-5f, 0.2f, static_cast<float>(v.v));
+        TEST_ASSERT_TRUE(1m > 999mm);
+    }
+}
+
+// 外层已有 using namespace literals 时，内层再用 using namespace literals::f32 会使后缀二义，
+// 改用 using 声明逐个引入，遮蔽外层的同名后缀
+namespace mixed_scope {
+
+using namespace literals;
+
+static void check() {
+    using literals::f32::operator""m;
+    using literals::f32::operator""s;
+    static_assert(std::is_same<decltype(1.5m / 2s), f32::val_t>::value, "using 声明优先");
+    static_assert(std::is_same<decltype(5ms), dura_t>::value, "其余后缀仍来自外层");
+    TEST_ASSERT_EQUAL_FLOAT(0.75f, (1.5m / 2s).v);
+}
+
+} // namespace mixed_scope
+
+void test_mixed_scope(void) {
+    mixed_scope::check();
+}
+
+// 混合表示在编译期选定结果类型
+void test_mixed_rep(void) {
+    using namespace literals;
+    using fxp::q16_16;
+    using fxp::q31;
+
+    static_assert(std::is_same<common_rep_t<float, double>, double>::value, "");
+    static_assert(std::is_same<common_rep_t<float, float>, float>::value, "");
+    static_assert(std::is_same<common_rep_t<q16_16, float>, float>::value, "");
+    static_assert(std::is_same<common_rep_t<int, q16_16>, q16_16>::value, "");
+    static_assert(std::is_same<common_rep_t<q16_16, q16_16>, q16_16>::value, "");
+
+    f32::leng_t a(0.5f);
+    q16::dura_t b(0.25);
+    auto v = a / b;
+    static_assert(std::is_same<decltype(v), f32::val_t>::value, "定点与 float 得到 float");
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, v.v);
+
+    auto w = a + leng_t(0.25);
+    static_assert(std::is_same<decltype(w), leng_t>::value, "float 与 double 得到 double");
+    TEST_ASSERT_EQUAL_DOUBLE(0.75, w.v);
+    TEST_ASSERT_TRUE(a < leng_t(0.75));
+}
+
+void test_quantity_cast(void) {
+    using namespace literals;
+    using fxp::q16_16;
+    using fxp::q31;
+
+    constexpr auto f = quantity_cast<float>(12.5m);
+    static_assert(std::is_same<decltype(f)::rep, float>::value, "");
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, f.v);
+
+    auto q = quantity_cast<q16_16>(f);
+    TEST_ASSERT_EQUAL_INT32(12 * 65536 + 32768, q.v.raw);
+    TEST_ASSERT_EQUAL_DOUBLE(12.5, quantity_cast<double>(q).v);
+
+    // 定点格式之间按位移转换，超出范围时饱和
+    auto small = quantity_cast<q31>(Quantity<0, 0, 0, q16_16>(0.25));
+    TEST_ASSERT_EQUAL_INT32(1 << 29, small.v.raw);
+    TEST_ASSERT_EQUAL_INT32(16384, quantity_cast<q16_16>(small).v.raw);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, quantity_cast<q31>(q).v.raw);
+}
+
+// 整数时间可由任意表示的时长常量得到
+void test_tick_from_rep(void) {
+    using namespace literals;
+    constexpr dura_us_t a(f32::dura_t(0.005f));
+    constexpr dura_us_t b(5ms);
+    TEST_ASSERT_EQUAL_INT32(b.v, a.v);
+    TEST_ASSERT_INT32_WITHIN(16, 5000, dura_us_t(q16::dura_t(0.005)).v); // lsb 约 15 us
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_default_double);
+    RUN_TEST(test_literal_namespaces);
+    RUN_TEST(test_mixed_scope);
+    RUN_TEST(test_mixed_rep);
+    RUN_TEST(test_quantity_cast);
+    RUN_TEST(test_tick_from_rep);
+    return UNITY_END();
+}
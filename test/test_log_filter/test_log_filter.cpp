@@ -0,0 +1,105 @@
+// test/test_log_filter/test_log_filter.cpp
+#include "log_filter.hpp"
+#include <unity.h>
+
+using namespace logging;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_level_table(void) {
+    level_table levels(1);
+
+    // 初始时所有模块同级
+    for (uint8_t m = 0; m < module_count; m++) {
+        TEST_ASSERT_EQUAL_UINT8(1, levels.get(m));
+        TEST_ASSERT_FALSE(levels.enabled(m, 0));
+        TEST_ASSERT_TRUE(levels.enabled(m, 1));
+        TEST_ASSERT_TRUE(levels.enabled(m, 5));
+    }
+
+    // 单独调整一个模块不影响其他模块
+    levels.set(imu, 0);
+    levels.set(pixel, 6);
+    TEST_ASSERT_TRUE(levels.enabled(imu, 0));
+    TEST_ASSERT_FALSE(levels.enabled(core, 0));
+    TEST_ASSERT_FALSE(levels.enabled(pixel, 5));
+    TEST_ASSERT_TRUE(levels.enabled(display, 2));
+
+    // 越界模块被忽略
+    levels.set(module_count, 0);
+    TEST_ASSERT_EQUAL_UINT8(1, levels.get(core));
+
+    levels.set_all(3);
+    for (uint8_t m = 0; m < module_count; m++) TEST_ASSERT_EQUAL_UINT8(3, levels.get(m));
+}
+
+void test_every_ms(void) {
+    every_ms every(100);
+    uint32_t passed = 0;
+
+    // 第一次立即通过，之后每 100 ms 一次
+    for (uint32_t t = 0; t < 1000; t++) {
+        if (every.ready(t)) {
+            TEST_ASSERT_EQUAL_UINT32(passed * 100, t);
+            passed++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, passed);
+}
+
+void test_every_ms_wrap(void) {
+    every_ms every(100);
+    uint32_t passed = 0;
+
+    // 跨越 32 位回绕
+    uint32_t start = UINT32_MAX - 250;
+    for (uint32_t i = 0; i < 500; i++) {
+        if (every.ready(start + i)) passed++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, passed);
+}
+
+void test_every_ms_sparse(void) {
+    every_ms every(10);
+
+    // 上电后的第一次调用也会通过
+    TEST_ASSERT_TRUE(every.ready(5));
+
+    // 调用间隔超过周期时每次都通过
+    TEST_ASSERT_TRUE(every.ready(50));
+    TEST_ASSERT_FALSE(every.ready(55));
+    TEST_ASSERT_TRUE(every.ready(60));
+}
+
+void test_every_n(void) {
+    every_n every;
+    uint32_t passed = 0;
+
+    for (uint32_t i = 0; i < 100; i++) {
+        if (every.ready(10)) {
+            TEST_ASSERT_EQUAL_UINT32(0, i % 10);
+            passed++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, passed);
+
+    // n 为 0 或 1 时每次都通过
+    every_n always;
+    TEST_ASSERT_TRUE(always.ready(1));
+    TEST_ASSERT_TRUE(always.ready(1));
+    TEST_ASSERT_TRUE(always.ready(0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_level_table);
+    RUN_TEST(test_every_ms);
+    RUN_TEST(test_every_ms_wrap);
+    RUN_TEST(test_every_ms_sparse);
+    RUN_TEST(test_every_n);
+    return UNITY_END();
+}
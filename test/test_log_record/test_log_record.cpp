@@ -0,0 +1,157 @@
+// test/test_log_record/test_log_record.cpp
+#include "log_record.hpp"
+#include <unity.h>
+
+#include <stdio.h>
+#include <string>
+
+using namespace logging;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 模拟 Arduino Print 的输出
+struct string_out {
+    std::string s;
+    auto write(const char* v, size_t n) -> void { s.append(v, n); }
+    auto print(char v) -> void { s += v; }
+    auto print(const char* v) -> void { s += v; }
+    auto print(int v) -> void { s += std::to_string(v); }
+    auto print(long v) -> void { s += std::to_string(v); }
+    auto print(unsigned long v) -> void { s += std::to_string(v); }
+    auto print(long long v) -> void { s += std::to_string(v); }
+    auto print(unsigned long long v) -> void { s += std::to_string(v); }
+    auto print(double v) -> void {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.2f", v); // 与 Arduino Print 默认两位小数一致
+        s += buf;
+    }
+};
+
+template <typename S, typename... Args>
+static auto round_trip(compiled_format<S>, Args... args) -> std::string {
+    record r;
+    encode(r, "file.cpp", 42, 2, 1234, &compiled_format<S>::info, args...);
+    string_out out;
+    format_record(out, r);
+    return out.s;
+}
+
+#define ROUND_TRIP(format, ...) round_trip(LOG_COMPILE_FORMAT(format), ##__VA_ARGS__)
+
+// 编译期切分格式串
+void test_split_format(void) {
+    const format_info& f = *info_of(LOG_COMPILE_FORMAT(""));
+    static_assert(count_placeholders("a {} b {}{}") == 3, "");
+    static_assert(count_placeholders("{") == 0, "");
+
+    constexpr auto segs = split_format<4>("a {} b {}{}");
+    static_assert(segs[0].off == 0 && segs[0].len == 2, "");
+    static_assert(segs[1].off == 4 && segs[1].len == 3, "");
+    static_assert(segs[2].off == 9 && segs[2].len == 0, "");
+    static_assert(segs[3].off == 11 && segs[3].len == 0, "");
+
+    TEST_ASSERT_EQUAL_UINT8(0, f.argc);
+    TEST_ASSERT_EQUAL_UINT16(0, f.segs[0].len);
+}
+
+void test_round_trip_types(void) {
+    enum class mode : uint8_t { a = 7 };
+
+    TEST_ASSERT_EQUAL_STRING("no args", ROUND_TRIP("no args").c_str());
+    TEST_ASSERT_EQUAL_STRING("i=-5 u=7 c=x b=1", ROUND_TRIP("i={} u={} c={} b={}", -5, 7u, 'x', true).c_str());
+    TEST_ASSERT_EQUAL_STRING("f=1.50 d=-2.25", ROUND_TRIP("f={} d={}", 1.5f, -2.25).c_str());
+    TEST_ASSERT_EQUAL_STRING("big=-9000000000 s=hello", ROUND_TRIP("big={} s={}", -9000000000LL, "hello").c_str());
+    TEST_ASSERT_EQUAL_STRING("m=7 h=65535", ROUND_TRIP("m={} h={}", mode::a, uint16_t(65535)).c_str());
+}
+
+void test_record_fields(void) {
+    record r;
+    encode(r, "file.cpp", 42, 3, 1234, info_of(LOG_COMPILE_FORMAT("{}")), 1.0f);
+
+    TEST_ASSERT_EQUAL_STRING("file.cpp", r.file);
+    TEST_ASSERT_EQUAL_UINT16(42, r.line);
+    TEST_ASSERT_EQUAL_UINT8(3, r.level);
+    TEST_ASSERT_EQUAL_UINT32(1234, r.timestamp_us);
+    TEST_ASSERT_EQUAL_UINT8(1, r.argc);
+    TEST_ASSERT_EQUAL_UINT8(4, r.size);
+}
+
+// 六个 float 参数（SHOW_IMU 的调试输出）可以放进一条记录
+void test_six_floats_fit(void) {
+    auto s = ROUND_TRIP("Pos: {}, {}; Vel: {}, {}, Acc: {}, {}", 1.f, 2.f, 3.f, 4.f, 5.f, 6.f);
+    TEST_ASSERT_EQUAL_STRING("Pos: 1.00, 2.00; Vel: 3.00, 4.00, Acc: 5.00, 6.00", s.c_str());
+}
+
+// 超出容量的参数被截断并显示为 {?}
+void test_truncation(void) {
+    auto s = ROUND_TRIP("{} {} {} {} {}", 1.0, 2.0, 3.0, 4.0, 5.0);
+    TEST_ASSERT_EQUAL_STRING("1.00 2.00 3.00 4.00 {?}", s.c_str());
+}
+
+// 中间的参数放不下时停止编码，后面较小的参数不会错位到前面的占位符
+void test_truncation_in_middle(void) {
+    auto s = ROUND_TRIP("{} {} {} {} {} {}", 1, 2.0, 3.0, 4.0, 5.0, 6);
+    TEST_ASSERT_EQUAL_STRING("1 2.00 3.00 4.00 {?} {?}", s.c_str());
+
+    static_assert(payload_of<int, double, double, double>() == 28, "");
+    static_assert(payload_of<float, float, float, float, float, float>() <= record::max_payload, "");
+}
+
+void test_ring_fifo(void) {
+    record_ring<4> ring;
+    TEST_ASSERT_NULL(ring.front());
+
+    for (int i = 0; i < 3; i++) {
+        record* r = ring.reserve();
+        TEST_ASSERT_NOT_NULL(r);
+        encode(*r, "f", i, 0, 0, info_of(LOG_COMPILE_FORMAT("{}")), i);
+        ring.commit();
+    }
+    TEST_ASSERT_EQUAL(3, ring.size());
+
+    for (int i = 0; i < 3; i++) {
+        const record* r = ring.front();
+        TEST_ASSERT_NOT_NULL(r);
+        TEST_ASSERT_EQUAL_UINT16(i, r->line);
+        ring.pop();
+    }
+    TEST_ASSERT_NULL(ring.front());
+}
+
+// 满时丢弃并计数，不阻塞
+void test_ring_overflow_counted(void) {
+    record_ring<4> ring;
+
+    int accepted = 0;
+    for (int i = 0; i < 10; i++) {
+        record* r = ring.reserve();
+        if (!r) continue;
+        encode(*r, "f", i, 0, 0, info_of(LOG_COMPILE_FORMAT("x")));
+        ring.commit();
+        accepted++;
+    }
+
+    TEST_ASSERT_EQUAL_INT(4, accepted);
+    TEST_ASSERT_EQUAL_UINT32(6, ring.dropped());
+    TEST_ASSERT_EQUAL_UINT32(6, ring.take_dropped());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.dropped());
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_split_format);
+    RUN_TEST(test_round_trip_types);
+    RUN_TEST(test_record_fields);
+    RUN_TEST(test_six_floats_fit);
+    RUN_TEST(test_truncation);
+    RUN_TEST(test_truncation_in_middle);
+    RUN_TEST(test_ring_fifo);
+    RUN_TEST(test_ring_overflow_counted);
+
+    UNITY_END();
+}
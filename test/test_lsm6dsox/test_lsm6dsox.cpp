@@ -0,0 +1,344 @@
+// test/test_lsm6dsox/test_lsm6dsox.cpp
+#include "lsm6dsox.hpp"
+#include <unity.h>
+
+#include <stdio.h>
+
+#include <array>
+#include <deque>
+#include <vector>
+
+using namespace lsm6;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/*
+ * LSM6DSOX 的寄存器模型，接口与 TwoWire 相同
+ * 读 0x78..0x7E 时每 7 个字节取走 FIFO 中的一个字，地址回到 0x78
+ * Wire 缓冲区为 32 字节，超过时 requestFrom 返回 0
+ */
+class fake_bus {
+    public:
+    static constexpr size_t wire_buffer = 32;
+
+    uint8_t regs[128] = {};
+    std::deque<std::array<uint8_t, word_bytes>> fifo;
+    bool overrun      = false;
+    uint32_t clock    = 100000;
+    uint32_t requests = 0;
+    uint32_t bytes    = 0; // 总线上的字节数，含地址与寄存器
+    uint32_t starts   = 0;
+
+    fake_bus() { regs[reg::who_am_i] = chip_id; }
+
+    auto push(uint8_t tag, int16_t x, int16_t y, int16_t z) -> void {
+        std::array<uint8_t, word_bytes> w;
+        w[0]         = static_cast<uint8_t>(tag << 3);
+        int16_t v[3] = { x, y, z };
+        for (int i = 0; i < 3; i++) {
+            w[1 + 2 * i] = static_cast<uint8_t>(v[i] & 0xFF);
+            w[2 + 2 * i] = static_cast<uint8_t>((v[i] >> 8) & 0xFF);
+        }
+        fifo.push_back(w);
+    }
+    auto push_pair(int16_t a, int16_t g) -> void {
+        push(tag_gyro, g, static_cast<int16_t>(g + 1), static_cast<int16_t>(g + 2));
+        push(tag_accel, a, static_cast<int16_t>(a + 1), static_cast<int16_t>(a + 2));
+    }
+
+    // TwoWire
+    auto setClock(uint32_t hz) -> void { clock = hz; }
+    auto beginTransmission(uint8_t addr) -> void {
+        m_addr = addr;
+        m_tx.clear();
+    }
+    auto write(uint8_t b) -> size_t {
+        m_tx.push_back(b);
+        return 1;
+    }
+    auto endTransmission(bool = true) -> uint8_t {
+        starts++;
+        bytes += 1 + static_cast<uint32_t>(m_tx.size());
+        if (m_addr != address || m_tx.empty()) return 2; // 地址无应答
+        m_ptr = m_tx[0];
+        for (size_t i = 1; i < m_tx.size(); i++) {
+            if (m_ptr == reg::fifo_ctrl4 && m_tx[i] == fifo_bypass) fifo.clear(); // bypass 模式清空 FIFO
+            regs[m_ptr++] = m_tx[i];
+        }
+        return 0;
+    }
+    auto requestFrom(uint8_t addr, size_t n, bool = true) -> size_t {
+        starts++;
+        requests++;
+        bytes += 1 + static_cast<uint32_t>(n);
+        if (addr != address || n > wire_buffer) return 0;
+        m_rx.clear();
+        m_pos = 0;
+        for (size_t i = 0; i < n; i++) m_rx.push_back(next());
+        return n;
+    }
+    auto read() -> int { return m_pos < m_rx.size() ? m_rx[m_pos++] : -1; }
+
+    private:
+    uint8_t m_addr = 0;
+    uint8_t m_ptr  = 0;
+    std::vector<uint8_t> m_tx;
+    std::vector<uint8_t> m_rx;
+    size_t m_pos = 0;
+
+    auto next() -> uint8_t {
+        uint8_t r = m_ptr;
+        if (r >= reg::fifo_data_tag && r < reg::fifo_data_tag + word_bytes) {
+            uint8_t b = fifo.empty() ? 0 : fifo.front()[r - reg::fifo_data_tag];
+            m_ptr++;
+            if (m_ptr == reg::fifo_data_tag + word_bytes) {
+                if (!fifo.empty()) fifo.pop_front();
+                m_ptr = reg::fifo_data_tag;
+            }
+            return b;
+        }
+        m_ptr++;
+        if (r == reg::fifo_status1) return static_cast<uint8_t>(fifo.size() & 0xFF);
+        if (r == reg::fifo_status2) {
+            uint8_t v = static_cast<uint8_t>(((fifo.size() >> 8) & 0x03) | (overrun ? status_overrun : 0));
+            overrun   = false;
+            return v;
+        }
+        return regs[r];
+    }
+};
+
+// 记录所有输出的样本
+struct collector {
+    std::vector<sample> out;
+    auto push(const sample& s) -> void { out.push_back(s); }
+};
+
+void test_begin(void) {
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    TEST_ASSERT_TRUE(f.begin());
+    TEST_ASSERT_EQUAL_UINT32(400000, bus.clock);
+    TEST_ASSERT_EQUAL_HEX8(0x44, bus.regs[reg::ctrl3_c]);
+    TEST_ASSERT_EQUAL_HEX8(0x58, bus.regs[reg::ctrl1_xl]);
+    TEST_ASSERT_EQUAL_HEX8(0x54, bus.regs[reg::ctrl2_g]);
+    TEST_ASSERT_EQUAL_HEX8(0x55, bus.regs[reg::fifo_ctrl3]);
+    TEST_ASSERT_EQUAL_HEX8(0x06, bus.regs[reg::fifo_ctrl4]);
+
+    // 芯片型号不对或地址无应答
+    fake_bus other;
+    other.regs[reg::who_am_i] = 0x69;
+    fifo<fake_bus> g(other);
+    TEST_ASSERT_FALSE(g.begin());
+    fifo<fake_bus> h(bus, 0x6B);
+    TEST_ASSERT_FALSE(h.begin());
+}
+
+void test_burst_read(void) {
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    collector c;
+
+    for (int i = 0; i < 10; i++) bus.push_pair(static_cast<int16_t>(8197 * (i + 1) / 10), static_cast<int16_t>(-100 * i));
+    uint32_t before = bus.requests;
+    TEST_ASSERT_EQUAL(10, f.read(c, 100000));
+    TEST_ASSERT_TRUE(bus.fifo.empty());
+
+    // 1 次读状态 + 20 个字按每次 4 个读出
+    TEST_ASSERT_EQUAL_UINT32(1 + 5, bus.requests - before);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, c.out[i].seq);
+        TEST_ASSERT_EQUAL_INT16(static_cast<int16_t>(-100 * static_cast<int>(i)), c.out[i].gyro[0]);
+        TEST_ASSERT_EQUAL_INT16(static_cast<int16_t>(-100 * static_cast<int>(i) + 2), c.out[i].gyro[2]);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.0f, c.out[9].ax());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -900 * gyro_lsb, c.out[9].gx());
+
+    // FIFO 为空时只读状态，不会重复输出旧样本
+    before = bus.requests;
+    TEST_ASSERT_EQUAL(0, f.read(c, 105000));
+    TEST_ASSERT_EQUAL_UINT32(1, bus.requests - before);
+    TEST_ASSERT_EQUAL(10, c.out.size());
+}
+
+void test_split_pair(void) {
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    collector c;
+
+    // 一对数据跨两次读取
+    bus.push_pair(100, 200);
+    bus.push(tag_gyro, 1, 2, 3);
+    TEST_ASSERT_EQUAL(1, f.read(c, 10000));
+    bus.push(tag_accel, 4, 5, 6);
+    bus.push(7, 0, 0, 0); // 其它标签被忽略
+    TEST_ASSERT_EQUAL(1, f.read(c, 15000));
+    TEST_ASSERT_EQUAL_INT16(1, c.out[1].gyro[0]);
+    TEST_ASSERT_EQUAL_INT16(6, c.out[1].acc[2]);
+    TEST_ASSERT_EQUAL_UINT32(1, c.out[1].seq);
+}
+
+/*
+ * 传感器时钟与 MCU 相差 drift，MCU 以 3..9 ms 的不规则间隔读取，从接近 32 位回绕处开始
+ * 时间戳严格递增，与真实采样时刻的误差不超过一个周期
+ * 返回相邻样本的最大间隔
+ */
+static auto run_timestamps(double drift) -> uint32_t {
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    collector c;
+
+    const double period = 1e6 / rate_hz / drift;
+    const uint32_t base = 0xFFFFFFFFu - 2000000u;
+    std::vector<double> truth;
+    double next_sample = 1000.0;
+    uint32_t now       = 1000;
+    uint32_t seed      = 3;
+
+    while (now < 10000000) {
+        seed = seed * 1664525u + 1013904223u;
+        now += 3000 + (seed >> 8) % 6000;
+        while (next_sample <= now) {
+            bus.push_pair(1, 1);
+            truth.push_back(next_sample);
+            next_sample += period;
+        }
+        f.read(c, base + now);
+    }
+
+    TEST_ASSERT_EQUAL(truth.size(), c.out.size());
+    uint32_t max_step = 0;
+    for (size_t i = 0; i < c.out.size(); i++) {
+        double err = static_cast<double>(static_cast<int32_t>(c.out[i].t_us - base)) - truth[i];
+        TEST_ASSERT_TRUE(err > -period - 2 && err < period + 2);
+        if (i == 0) continue;
+        uint32_t step = c.out[i].t_us - c.out[i - 1].t_us;
+        TEST_ASSERT_TRUE(step > 0 && step < 2 * period);
+        if (step > max_step) max_step = step;
+    }
+    return max_step;
+}
+
+void test_timestamps(void) {
+    // 传感器偏快时批次被压缩，间隔不超过一个周期（允许 2 us 的取整）
+    TEST_ASSERT_TRUE(run_timestamps(1.003) <= 1000000 / rate_hz + 2);
+    run_timestamps(1.0);
+    // 偏慢时偶尔向前跳
+    run_timestamps(0.997);
+}
+
+void test_overrun(void) {
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    collector c;
+
+    bus.push_pair(1, 1);
+    f.read(c, 10000);
+
+    // 溢出：丢弃半组数据，时间戳重新以当前时间对齐
+    bus.push(tag_gyro, 9, 9, 9);
+    f.read(c, 15000);
+    bus.overrun = true;
+    bus.push_pair(2, 2);
+    bus.push_pair(3, 3);
+    TEST_ASSERT_EQUAL(2, f.read(c, 900000));
+    TEST_ASSERT_EQUAL_UINT32(1, f.overruns());
+    TEST_ASSERT_EQUAL_INT16(2, c.out[1].gyro[0]);
+    TEST_ASSERT_EQUAL_UINT32(900000, c.out[2].t_us);
+    TEST_ASSERT_EQUAL_UINT32(900000 - 1000000 / rate_hz, c.out[1].t_us);
+}
+
+// 关闭时 FIFO 不再累积，重新打开后的第一批样本以读取时间重新对齐
+void test_stream(void) {
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    collector c;
+    TEST_ASSERT_TRUE(f.begin());
+
+    bus.push_pair(1, 1);
+    bus.push(tag_gyro, 9, 9, 9); // 半组
+    TEST_ASSERT_EQUAL(1, f.read(c, 10000));
+
+    TEST_ASSERT_TRUE(f.stream(false));
+    TEST_ASSERT_EQUAL_HEX8(fifo_bypass, bus.regs[reg::fifo_ctrl4]);
+    TEST_ASSERT_TRUE(bus.fifo.empty());
+    TEST_ASSERT_EQUAL(0, f.read(c, 500000));
+
+    TEST_ASSERT_TRUE(f.stream(true));
+    TEST_ASSERT_EQUAL_HEX8(fifo_continuous, bus.regs[reg::fifo_ctrl4]);
+    bus.push_pair(2, 2);
+    bus.push_pair(3, 3);
+    TEST_ASSERT_EQUAL(2, f.read(c, 900000));
+    // 上次的半组已丢弃，不会和新数据拼成一对
+    TEST_ASSERT_EQUAL_INT16(2, c.out[1].gyro[0]);
+    TEST_ASSERT_EQUAL_INT16(2, c.out[1].acc[0]);
+    TEST_ASSERT_EQUAL_UINT32(900000, c.out[2].t_us);
+}
+
+void test_queue(void) {
+    queue<4> q;
+    sample s{};
+    TEST_ASSERT_FALSE(q.pop(s));
+
+    // 满时丢弃最旧的样本
+    for (uint32_t i = 0; i < 6; i++) {
+        s.seq = i;
+        q.push(s);
+    }
+    TEST_ASSERT_EQUAL(4, q.size());
+    TEST_ASSERT_EQUAL_UINT32(2, q.dropped());
+    for (uint32_t i = 2; i < 6; i++) {
+        TEST_ASSERT_TRUE(q.pop(s));
+        TEST_ASSERT_EQUAL_UINT32(i, s.seq);
+    }
+    TEST_ASSERT_TRUE(q.empty());
+
+    q.push(s);
+    q.clear();
+    TEST_ASSERT_FALSE(q.pop(s));
+
+    // 直接作为 fifo::read 的输出
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    for (int i = 0; i < 3; i++) bus.push_pair(1, 1);
+    TEST_ASSERT_EQUAL(3, f.read(q, 5000));
+    TEST_ASSERT_EQUAL(3, q.size());
+}
+
+// 按 9 位 / 字节估算总线时间：原来每次 100 kHz 下分别读加速度计与陀螺仪，现在 400 kHz 下批量读取 FIFO
+void test_bus_time(void) {
+    fake_bus bus;
+    fifo<fake_bus> f(bus);
+    collector c;
+    for (int i = 0; i < 2; i++) bus.push_pair(1, 1);
+
+    uint32_t bytes0 = bus.bytes;
+    f.read(c, 10000);
+    double fifo_us = (bus.bytes - bytes0) * 9 * 1e6 / bus_clock / 2;
+
+    // 寄存器读：地址 + 寄存器 + 地址 + 6 字节，两次
+    double reg_us = 2 * (3 + 6) * 9 * 1e6 / 100000;
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "bus time per sample: %.0f us (registers, 100 kHz) vs %.0f us (FIFO, 400 kHz)", reg_us, fifo_us);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(fifo_us * 3 < reg_us);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_begin);
+    RUN_TEST(test_burst_read);
+    RUN_TEST(test_split_pair);
+    RUN_TEST(test_timestamps);
+    RUN_TEST(test_overrun);
+    RUN_TEST(test_stream);
+    RUN_TEST(test_queue);
+    RUN_TEST(test_bus_time);
+    return UNITY_END();
+}
@@ -0,0 +1,107 @@
+// test/test_pid_bank/test_pid_bank.cpp
+#include "pid_bank.hpp"
+#include "pid_controller.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace ctrl;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_default_constructor(void) {
+    pid_bank<3> bank;
+
+    TEST_ASSERT_EQUAL(3, bank.size());
+    for (size_t ch = 0; ch < 3; ch++) {
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, bank.get_target(ch));
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, bank.get_kp(ch));
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, bank.get_ki(ch));
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, bank.get_kd(ch));
+    }
+}
+
+// 与 N 个独立的 pid_controller 逐拍比较
+template <typename T, size_t N>
+static void check_matches_independent(double tol) {
+    basic_pid_bank<T, N>    bank;
+    basic_pid_controller<T> pids[N];
+
+    for (size_t ch = 0; ch < N; ch++) {
+        double kp = 0.5 + 0.1 * ch, ki = 0.2 + 0.05 * ch, kd = 0.01 * ch;
+        bank.set_gains(ch, T(kp), T(ki), T(kd));
+        bank.set_target(ch, T(1.0 - 0.1 * ch));
+        pids[ch] = basic_pid_controller<T>(T(kp), T(ki), T(kd));
+        pids[ch].set_target(T(1.0 - 0.1 * ch));
+    }
+
+    std::array<T, N> in, out;
+    for (int k = 0; k < 400; k++) {
+        T t = T(k * 0.005);
+        for (size_t ch = 0; ch < N; ch++) in[ch] = T(0.5 * sin(k * 0.03 + ch));
+
+        bank.update(in, out, t);
+        for (size_t ch = 0; ch < N; ch++) {
+            double ref = static_cast<double>(pids[ch].update(in[ch], t));
+            TEST_ASSERT_DOUBLE_WITHIN(tol * fmax(1.0, fabs(ref)), ref, static_cast<double>(out[ch]));
+        }
+    }
+}
+
+void test_matches_independent_double(void) {
+    check_matches_independent<double, 1>(1e-12);
+    check_matches_independent<double, 3>(1e-12);
+    check_matches_independent<double, 17>(1e-12);
+}
+
+void test_matches_independent_float(void) {
+    check_matches_independent<float, 3>(1e-5);
+    check_matches_independent<float, 8>(1e-5);
+}
+
+void test_same_timestamp(void) {
+    pid_bank<2> bank;
+    bank.set_gains(0, 1.0, 0.0, 0.5);
+    bank.set_gains(1, 2.0, 0.0, 0.5);
+    bank.set_target(0, 100.0);
+    bank.set_target(1, 100.0);
+
+    std::array<double, 2> in{ 50.0, 50.0 }, out;
+    bank.update(in, out, 1.0);
+    in = { 60.0, 60.0 };
+    bank.update(in, out, 1.0);
+
+    TEST_ASSERT_EQUAL_DOUBLE(40.0, out[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(80.0, out[1]);
+}
+
+void test_reset(void) {
+    pid_bank<2> bank;
+    bank.set_gains(0, 1.0, 0.1, 0.5);
+    bank.set_target(0, 100.0);
+
+    std::array<double, 2> in{ 50.0, 0.0 }, out;
+    bank.update(in, out, 0s);
+    in[0] = 60.0;
+    bank.update(in, out, 1s);
+    bank.reset();
+
+    in[0] = 50.0;
+    bank.update(in, out, 2s);
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, out[0]);
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_default_constructor);
+    RUN_TEST(test_matches_independent_double);
+    RUN_TEST(test_matches_independent_float);
+    RUN_TEST(test_same_timestamp);
+    RUN_TEST(test_reset);
+
+    UNITY_END();
+}
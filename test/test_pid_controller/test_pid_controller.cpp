@@ -0,0 +1,470 @@
+// test/test_pid_controller/test_pid_controller.cpp
+#include "pid_controller.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace ctrl;
+
+void setUp(void) {
+    // 每个测试前执行
+}
+
+void tearDown(void) {
+    // 每个测试后执行
+}
+
+// 测试构造函数
+void test_default_constructor(void) {
+    pid_controller pid;
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, pid.get_target());
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, pid.get_kp());
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, pid.get_ki());
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, pid.get_kd());
+}
+
+void test_parameterized_constructor(void) {
+    pid_controller pid(1.0, 0.5, 0.2);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, pid.get_kp());
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, pid.get_ki());
+    TEST_ASSERT_EQUAL_DOUBLE(0.2, pid.get_kd());
+}
+
+// 测试 setter/getter
+void test_set_get_target(void) {
+    pid_controller pid;
+    pid.set_target(100.0);
+
+    TEST_ASSERT_EQUAL_DOUBLE(100.0, pid.get_target());
+}
+
+void test_set_get_gains(void) {
+    pid_controller pid;
+
+    pid.set_kp(2.0);
+    pid.set_ki(1.5);
+    pid.set_kd(0.8);
+
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, pid.get_kp());
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, pid.get_ki());
+    TEST_ASSERT_EQUAL_DOUBLE(0.8, pid.get_kd());
+}
+
+// 测试纯 P 控制器
+void test_p_controller_only(void) {
+    pid_controller pid(1.0, 0.0, 0.0);
+    pid.set_target(100.0);
+
+    // 第一次更新
+    double output = pid.update(50.0, dura_t{ 1000 }); // error = 50
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, output);           // P = 50 * 1.0 = 50
+
+    // 第二次更新
+    output = pid.update(75.0, dura_t{ 2000 }); // error = 25
+    TEST_ASSERT_EQUAL_DOUBLE(25.0, output);    // P = 25 * 1.0 = 25
+}
+
+// 测试 PI 控制器
+void test_pi_controller(void) {
+    pid_controller pid(1.0, 0.1, 0.0);
+    pid.set_target(100.0);
+
+    // 第一次更新 (dt = 0 因为是第一次采样)
+    double output = pid.update(50.0, dura_t{ 0 });
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, output); // P = 50, I = 0
+
+    // 第二次更新 (dt = 1000)
+    output = pid.update(60.0, dura_t{ 1000 });
+    // error = 40, P = 40
+    // integral = 50*0 + 40*1000 = 40000
+    // I = 40000 * 0.1 = 4000
+    // output = 40 + 4000 = 4040
+    TEST_ASSERT_EQUAL_DOUBLE(4040.0, output);
+}
+
+// 测试 PD 控制器
+void test_pd_controller(void) {
+    pid_controller pid(1.0, 0.0, 0.5);
+    pid.set_target(100.0);
+
+    // 第一次更新
+    double output = pid.update(50.0, dura_t{ 0 });
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, output); // P = 50, D = 0 (第一次采样)
+
+    // 第二次更新
+    output = pid.update(70.0, dura_t{ 1000 });
+    // error = 30, P = 30
+    // derivative = -(30 - 50) / 1000 = 20 / 1000 = 0.02
+    // D = 0.02 * 0.5 = 0.01
+    // output = 30 + 0.01 = 30.01
+    TEST_ASSERT_EQUAL_DOUBLE(30.01, output);
+}
+
+// 测试完整的 PID 控制器
+void test_full_pid_controller(void) {
+    pid_controller pid(1.0, 0.01, 0.5);
+    pid.set_target(100.0);
+
+    // 第一次更新
+    double output1 = pid.update(50.0, dura_t{ 0 });
+    // error = 50, P = 50, I = 0, D = 0
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, output1);
+
+    // 第二次更新
+    double output2 = pid.update(60.0, dura_t{ 1000 });
+    // error = 40
+    // P = 40
+    // integral = 0 + 40*1000 = 40000, I = 40000 * 0.01 = 400
+    // derivative = -(40-50)/1000 = 0.01, D = 0.01 * 0.5 = 0.005
+    // output = 40 + 400 + 0.005 = 440.005
+    TEST_ASSERT_EQUAL_DOUBLE(440.005, output2);
+}
+
+// 测试 reset 功能
+void test_reset(void) {
+    pid_controller pid(1.0, 0.1, 0.5);
+    pid.set_target(100.0);
+
+    // 运行几次更新
+    pid.update(50.0, dura_t{ 0 });
+    pid.update(60.0, dura_t{ 1000 });
+    pid.update(70.0, dura_t{ 2000 });
+
+    // 重置
+    pid.reset();
+
+    // 重置后的第一次更新应该像初始状态
+    double output = pid.update(50.0, dura_t{ 3000 });
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, output); // 应该只有 P 分量
+}
+
+// 测试零误差情况
+void test_zero_error(void) {
+    pid_controller pid(1.0, 0.1, 0.5);
+    pid.set_target(100.0);
+
+    pid.update(100.0, dura_t{ 0 });
+    double output = pid.update(100.0, dura_t{ 1000 });
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, output);
+}
+
+// 测试负误差
+void test_negative_error(void) {
+    pid_controller pid(1.0, 0.0, 0.0);
+    pid.set_target(50.0);
+
+    double output = pid.update(75.0, dura_t{ 0 });
+    TEST_ASSERT_EQUAL_DOUBLE(-25.0, output); // error = 50 - 75 = -25
+}
+
+// 测试积分累积
+void test_integral_accumulation(void) {
+    pid_controller pid(0.0, 1.0, 0.0);
+    pid.set_target(100.0);
+
+    pid.update(50.0, dura_t{ 0 });
+
+    // 持续的误差应该累积
+    double output1 = pid.update(50.0, dura_t{ 100 });
+    double output2 = pid.update(50.0, dura_t{ 200 });
+
+    TEST_ASSERT_GREATER_THAN(output1, output2); // 积分应该增加
+}
+
+// 测试重复时间戳不会除零
+void test_same_timestamp(void) {
+    pid_controller pid(1.0, 0.1, 0.5);
+    pid.set_target(100.0);
+
+    pid.update(50.0, dura_t{ 1000 });
+    double output = pid.update(60.0, dura_t{ 1000 });
+
+    TEST_ASSERT_EQUAL_DOUBLE(40.0, output); // dt = 0，只有 P 分量
+}
+
+// 整数时间：点相减得到有符号间隔，跨越 32 位回绕仍然正确
+void test_tick_arithmetic(void) {
+    constexpr dura_us_t period(5ms);
+    static_assert(period.v == 5000, "dura_t 常量在编译期取整为微秒");
+    static_assert(dura_us_t(0.0000026s).v == 3, "四舍五入");
+
+    time_us_t a(UINT32_MAX - 1999);
+    time_us_t b = a + period;
+    TEST_ASSERT_EQUAL_UINT32(3000, b.v);
+    TEST_ASSERT_EQUAL_INT32(5000, (b - a).v);
+    TEST_ASSERT_EQUAL_INT32(-5000, (a - b).v);
+    TEST_ASSERT_TRUE(a < b);
+    TEST_ASSERT_TRUE(b >= a);
+    TEST_ASSERT_TRUE(b - period == a);
+    TEST_ASSERT_EQUAL_INT32(3, (3 * period + dura_us_t(1)) / period);
+    TEST_ASSERT_EQUAL_DOUBLE(0.005, period.to_dura().v);
+    TEST_ASSERT_EQUAL_FLOAT(0.005f, period.seconds());
+}
+
+// 整数时间戳与秒时间戳得到同样的输出
+void test_integer_timestamps(void) {
+    pid_controller by_seconds(2.0, 0.5, 0.01);
+    pid_controller by_ticks(2.0, 0.5, 0.01);
+    by_seconds.set_target(1.0);
+    by_ticks.set_target(1.0);
+
+    double x = 0.0;
+    for (uint32_t k = 0; k < 50; k++) {
+        double expect = by_seconds.update(x, 0.005 * k);
+        double got    = by_ticks.update(x, time_us_t(5000 * k));
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, expect, got);
+        x += 0.02;
+    }
+}
+
+// micros() 回绕时 dt 不会变成负值或约 4295 s
+void test_integer_timestamps_wrap(void) {
+    pid_controller a(1.0, 1.0, 0.01);
+    pid_controller b(1.0, 1.0, 0.01);
+    a.set_target(1.0);
+    b.set_target(1.0);
+
+    time_us_t ta(1000000);
+    time_us_t tb(UINT32_MAX - 12000);
+    const dura_us_t dt(5000);
+    double x = 0.0;
+    for (int k = 0; k < 10; k++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, a.update(x, ta), b.update(x, tb));
+        ta += dt;
+        tb += dt;
+        x  += 0.1;
+    }
+    TEST_ASSERT_TRUE(tb.v < 100000); // 确实跨越了回绕
+}
+
+// 定点控制器的整数时间换算不经过 double
+void test_integer_timestamps_q16(void) {
+    pid_controller ref(1.0, 4.0, 0.0);
+    pid_controller_q16 q(fxp::q16_16(1.0), fxp::q16_16(4.0), fxp::q16_16(0.0));
+    ref.set_target(1.0);
+    q.set_target(fxp::q16_16(1.0));
+
+    for (uint32_t k = 0; k < 20; k++) {
+        double expect = ref.update(0.25, time_us_t(10000 * k));
+        double got    = static_cast<double>(q.update(fxp::q16_16(0.25), time_us_t(10000 * k)));
+        TEST_ASSERT_DOUBLE_WITHIN(1e-3, expect, got);
+    }
+}
+
+// 未启用的功能不占空间
+void test_policy_footprint(void) {
+    using on_measurement = basic_pid_controller<double, pid_policy<anti_windup::none, derivative::on_measurement>>;
+    using limited        = basic_pid_controller<double, pid_policy<anti_windup::conditional>>;
+    using filtered       = basic_pid_controller<double, pid_policy<anti_windup::none, derivative::on_error, true>>;
+
+    TEST_ASSERT_EQUAL(sizeof(pid_controller), sizeof(on_measurement));
+    TEST_ASSERT_EQUAL(sizeof(pid_controller) + 2 * sizeof(double), sizeof(limited));
+    TEST_ASSERT_EQUAL(sizeof(pid_controller) + 2 * sizeof(double), sizeof(filtered));
+}
+
+void test_output_limits(void) {
+    basic_pid_controller<double, pid_policy<anti_windup::clamp>> pid(2.0, 0.0, 0.0);
+    pid.set_output_limits(-1.0, 1.0);
+    pid.set_target(10.0);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, pid.update(0.0, 0.0));
+    TEST_ASSERT_EQUAL_DOUBLE(-1.0, pid.update(20.0, 0.01));
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, pid.update(9.75, 0.02));
+    TEST_ASSERT_EQUAL_DOUBLE(-1.0, pid.get_output_min());
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, pid.get_output_max());
+
+    // 上下限顺序颠倒时交换
+    pid.set_output_limits(1.0, -1.0);
+    TEST_ASSERT_EQUAL_DOUBLE(-1.0, pid.get_output_min());
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, pid.get_output_max());
+}
+
+/*
+ * 一阶对象 tau * y' = u - y，输出限幅 [-1, 1]，目标 0.8 接近上限
+ * 起步时长时间饱和，返回超调量
+ */
+template <typename Pid>
+static auto windup_overshoot(Pid& pid, double* settle_time = nullptr) -> double {
+    const double tau = 0.5, dt = 0.01, target = 0.8;
+    pid.set_output_limits(-1.0, 1.0);
+    pid.set_target(target);
+
+    double y = 0.0, peak = 0.0;
+    for (int k = 0; k < 1000; k++) {
+        double u = pid.update(y, k * dt);
+        y += (u - y) * dt / tau;
+        if (y > peak) peak = y;
+        if (settle_time && fabs(y - target) > 0.02 * target) *settle_time = k * dt;
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, target, y);
+    return peak - target;
+}
+
+// 抗积分饱和：超调与调节时间都小于只限幅的情况
+void test_anti_windup_recovery(void) {
+    basic_pid_controller<double, pid_policy<anti_windup::clamp>> clamp(2.0, 6.0, 0.0);
+    basic_pid_controller<double, pid_policy<anti_windup::conditional>> cond(2.0, 6.0, 0.0);
+    basic_pid_controller<double, pid_policy<anti_windup::back_calc>> back(2.0, 6.0, 0.0);
+
+    double t_clamp = 0, t_cond = 0, t_back = 0;
+    double o_clamp = windup_overshoot(clamp, &t_clamp);
+    double o_cond  = windup_overshoot(cond, &t_cond);
+    double o_back  = windup_overshoot(back, &t_back);
+
+    TEST_ASSERT_TRUE(o_clamp > 0.05);
+    TEST_ASSERT_TRUE(o_cond < o_clamp / 2);
+    TEST_ASSERT_TRUE(o_back < o_clamp / 2);
+    TEST_ASSERT_TRUE(t_cond < t_clamp);
+    TEST_ASSERT_TRUE(t_back < t_clamp);
+}
+
+// 条件积分：饱和且误差继续推向限幅时积分保持不变，误差反向后立即离开限幅
+void test_conditional_integration(void) {
+    basic_pid_controller<double, pid_policy<anti_windup::conditional>> pid(1.0, 1.0, 0.0);
+    pid.set_output_limits(-1.0, 1.0);
+    pid.set_target(5.0);
+
+    for (int k = 0; k <= 100; k++) TEST_ASSERT_EQUAL_DOUBLE(1.0, pid.update(0.0, k * 0.01));
+
+    // 积分没有累积，误差为 -0.5 时输出立即为 -0.5 左右
+    double u = pid.update(5.5, 1.01);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, -0.5, u);
+}
+
+// 反算：饱和时积分被拉回，未限幅的输出停在限幅附近
+void test_back_calculation(void) {
+    basic_pid_controller<double, pid_policy<anti_windup::back_calc>> pid(1.0, 1.0, 0.0);
+    pid.set_output_limits(-1.0, 1.0);
+    pid.set_tracking(0.05);
+    pid.set_target(0.5);
+
+    // 误差 0.5，P = 0.5，积分只需要 0.5 就饱和
+    double u = 0.0;
+    for (int k = 0; k <= 1000; k++) u = pid.update(0.0, k * 0.01);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, u);
+
+    // 稳态：e * dt + kb * dt * (1 - u) = 0，kb = 1 / (ki * Tt) = 20，u = 1 + 0.5 / 20
+    // u 中已含本次的 e * dt，积分项比 u - P 少 0.005
+    double i_term = pid.update(0.5, 10.01); // 误差为 0 时输出就是积分项
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.0 + 0.5 / 20 - 0.5 - 0.5 * 0.01, i_term);
+}
+
+// 微分作用于量测：目标阶跃不产生微分冲击，目标不变时与作用于误差一致
+// D = -kd * d(err)/dt，kd < 0 时抑制量测的变化
+void test_derivative_on_measurement(void) {
+    basic_pid_controller<double, pid_policy<anti_windup::none, derivative::on_measurement>> meas(1.0, 0.0, -0.1);
+    pid_controller err(1.0, 0.0, -0.1);
+
+    // 量测上升，阻尼的微分项使输出低于纯 P
+    meas.update(0.0, 0.0);
+    TEST_ASSERT_TRUE(meas.update(0.1, 0.01) < -0.1);
+    meas.reset();
+
+    double y[] = { 0.0, 0.1, 0.25, 0.3, 0.28 };
+    for (int k = 0; k < 5; k++) {
+        TEST_ASSERT_EQUAL_DOUBLE(err.update(y[k], k * 0.01), meas.update(y[k], k * 0.01));
+    }
+
+    err.set_target(1.0);
+    meas.set_target(1.0);
+    double kick = err.update(0.28, 0.05);
+    double none = meas.update(0.28, 0.05);
+    TEST_ASSERT_EQUAL_DOUBLE(0.72, none); // 只有 P
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.72 + 0.1 * 1.0 / 0.01, kick);
+}
+
+// 一阶微分滤波：量测阶跃时微分项按 dt / (Tf + dt) 逐步衰减，噪声被压低
+void test_derivative_filter(void) {
+    using filtered = basic_pid_controller<double, pid_policy<anti_windup::none, derivative::on_measurement, true>>;
+    filtered pid(0.0, 0.0, 0.01);
+    pid.set_d_filter(40ms);
+
+    pid.update(0.0, 0.0);
+    double raw   = 0.01 * 1.0 / 0.01; // 未滤波的微分项
+    double alpha = 0.01 / (0.04 + 0.01);
+    double d     = pid.update(1.0, 0.01);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, raw * alpha, d);
+    d = pid.update(1.0, 0.02);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, raw * alpha * (1 - alpha), d);
+
+    // 白噪声量测：滤波后输出的均方值明显小于不滤波的
+    filtered noisy(0.0, 0.0, 0.01);
+    basic_pid_controller<double, pid_policy<anti_windup::none, derivative::on_measurement>> plain(0.0, 0.0, 0.01);
+    noisy.set_d_filter(0.04);
+    uint32_t seed = 1;
+    double sq_f = 0, sq_p = 0;
+    for (int k = 0; k < 2000; k++) {
+        seed     = seed * 1664525u + 1013904223u;
+        double n = ((seed >> 8) / double(1 << 24) - 0.5) * 0.01;
+        double f = noisy.update(n, k * 0.01);
+        double p = plain.update(n, k * 0.01);
+        sq_f += f * f;
+        sq_p += p * p;
+    }
+    TEST_ASSERT_TRUE(sq_f < sq_p / 4);
+
+    pid.reset();
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, pid.update(5.0, 1.0));
+
+    // q16 下 1 ms 的 dt 与 double 的结果一致
+    using fixed = fxp::q16_16;
+    basic_pid_controller<fixed, pid_policy<anti_windup::none, derivative::on_measurement, true>> q(fixed(0.0), fixed(0.0),
+                                                                                                   fixed(0.01));
+    filtered ref(0.0, 0.0, 0.01);
+    q.set_d_filter(fixed(0.04));
+    ref.set_d_filter(0.04);
+    q.update(fixed(0.0), time_us_t(0));
+    ref.update(0.0, 0.0);
+    for (int k = 1; k <= 50; k++) {
+        double dq = static_cast<double>(q.update(fixed(1.0), time_us_t(k * 1000)));
+        double dr = ref.update(1.0, k * 0.001);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-3, dr, dq);
+    }
+}
+
+// 设定值加权：P 作用于 b * 目标 - 量测，D 作用于 c * 目标 - 量测，积分仍用完整误差
+void test_setpoint_weighting(void) {
+    basic_pid_controller<double, pid_policy<anti_windup::none, derivative::on_error, false, true>> pid(2.0, 1.0, -0.1);
+    pid.set_weights(0.5, 0.0);
+
+    pid.update(0.0, 0.0);
+    pid.set_target(1.0);
+    // P = 2 * (0.5 - 0) = 1，I = 1 * 0.01，D 中目标的权重为 0，没有冲击
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1.0 + 0.01, pid.update(0.0, 0.01));
+    // 量测变化时 D = 0.1 * (-0.2 - 0) / 0.01 与作用于量测相同
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 2.0 * 0.3 + 1.0 * (0.01 + 0.008) - 2.0, pid.update(0.2, 0.02));
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_default_constructor);
+    RUN_TEST(test_parameterized_constructor);
+    RUN_TEST(test_set_get_target);
+    RUN_TEST(test_set_get_gains);
+    RUN_TEST(test_p_controller_only);
+    RUN_TEST(test_pi_controller);
+    RUN_TEST(test_pd_controller);
+    RUN_TEST(test_full_pid_controller);
+    RUN_TEST(test_reset);
+    RUN_TEST(test_zero_error);
+    RUN_TEST(test_negative_error);
+    RUN_TEST(test_integral_accumulation);
+    RUN_TEST(test_same_timestamp);
+    RUN_TEST(test_tick_arithmetic);
+    RUN_TEST(test_integer_timestamps);
+    RUN_TEST(test_integer_timestamps_wrap);
+    RUN_TEST(test_integer_timestamps_q16);
+    RUN_TEST(test_policy_footprint);
+    RUN_TEST(test_output_limits);
+    RUN_TEST(test_anti_windup_recovery);
+    RUN_TEST(test_conditional_integration);
+    RUN_TEST(test_back_calculation);
+    RUN_TEST(test_derivative_on_measurement);
+    RUN_TEST(test_derivative_filter);
+    RUN_TEST(test_setpoint_weighting);
+
+    UNITY_END();
+}
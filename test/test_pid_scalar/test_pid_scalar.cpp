@@ -0,0 +1,112 @@
+// test/test_pid_scalar/test_pid_scalar.cpp
+#include "fixed_point.hpp"
+#include "pid_controller.hpp"
+#include <math.h>
+#include <unity.h>
+
+using namespace ctrl;
+using fxp::q16_16;
+using fxp::q31;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// 定点数基本运算
+void test_q16_arithmetic(void) {
+    q16_16 a(1.5);
+    q16_16 b(-0.25);
+
+    TEST_ASSERT_EQUAL_DOUBLE(1.25, static_cast<double>(a + b));
+    TEST_ASSERT_EQUAL_DOUBLE(1.75, static_cast<double>(a - b));
+    TEST_ASSERT_EQUAL_DOUBLE(-0.375, static_cast<double>(a * b));
+    TEST_ASSERT_EQUAL_DOUBLE(-6.0, static_cast<double>(a / b));
+    TEST_ASSERT_EQUAL_DOUBLE(-6.0, static_cast<double>(-a / -b)); // 被除数为负
+    TEST_ASSERT_EQUAL_DOUBLE(-1.5, static_cast<double>(-a));
+    TEST_ASSERT_TRUE(b < a);
+    TEST_ASSERT_EQUAL_INT32(3 << 15, a.raw);
+}
+
+// 溢出时饱和而不是回绕
+void test_q16_saturation(void) {
+    q16_16 big(30000.0);
+
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (big + big).raw);
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, (-big - big).raw);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (big * big).raw);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (big / q16_16(0)).raw);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, q16_16(1e9).raw);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, q16_16(100000).raw);
+}
+
+void test_q31_arithmetic(void) {
+    q31 a(0.5);
+    q31 b(-0.25);
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -0.125, static_cast<double>(a * b));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.25, static_cast<double>(a + b));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -0.5, static_cast<double>(b / a));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, q31(1.0).raw); // 1.0 不可表示，饱和到最大值
+}
+
+// double 特化与原有 pid_controller 行为一致
+void test_double_alias_matches(void) {
+    pid_controller               a(1.0, 0.01, 0.5);
+    basic_pid_controller<double> b(1.0, 0.01, 0.5);
+    a.set_target(100.0);
+    b.set_target(100.0);
+
+    for (int k = 0; k < 10; k++) {
+        double y = 50.0 + k;
+        TEST_ASSERT_EQUAL_DOUBLE(a.update(y, dura_t{ k * 1000. }), b.update(y, k * 1000.));
+    }
+}
+
+/*
+ * 以 double 为参考，对 200 Hz 下 5 s 的正弦量测序列比较输出误差
+ * 误差界按 float 的 24 位尾数 / Q16.16 的 2^-16 分辨率估算并留有余量
+ */
+template <typename T>
+static auto max_error_vs_double(double kp, double ki, double kd) -> double {
+    basic_pid_controller<double> ref(kp, ki, kd);
+    basic_pid_controller<T>      dut{ T(kp), T(ki), T(kd) };
+    ref.set_target(1.0);
+    dut.set_target(T(1.0));
+
+    double max_err = 0;
+    for (int k = 0; k < 1000; k++) {
+        double t = k * 0.005;
+        double y = 0.8 + 0.5 * sin(2 * M_PI * 1.5 * t);
+
+        double out_ref = ref.update(y, t);
+        double out_dut = static_cast<double>(dut.update(T(y), T(t)));
+
+        max_err = fmax(max_err, fabs(out_ref - out_dut));
+    }
+    return max_err;
+}
+
+void test_float_error_bound(void) {
+    TEST_ASSERT_LESS_THAN_DOUBLE(1e-3, max_error_vs_double<float>(2.0, 0.5, 0.01));
+    TEST_ASSERT_LESS_THAN_DOUBLE(1e-3, max_error_vs_double<float>(0.5, 5.0, 0.0));
+}
+
+void test_q16_error_bound(void) {
+    TEST_ASSERT_LESS_THAN_DOUBLE(5e-3, max_error_vs_double<q16_16>(2.0, 0.5, 0.01));
+    TEST_ASSERT_LESS_THAN_DOUBLE(5e-3, max_error_vs_double<q16_16>(0.5, 5.0, 0.0));
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_q16_arithmetic);
+    RUN_TEST(test_q16_saturation);
+    RUN_TEST(test_q31_arithmetic);
+    RUN_TEST(test_double_alias_matches);
+    RUN_TEST(test_float_error_bound);
+    RUN_TEST(test_q16_error_bound);
+
+    UNITY_END();
+}
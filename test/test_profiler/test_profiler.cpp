@@ -0,0 +1,98 @@
+// test/test_profiler/test_profiler.cpp
+#define ENABLE_PROFILING
+#include "profiler.hpp"
+#include <unity.h>
+
+#include <string>
+
+using namespace prof;
+
+void setUp(void) {
+    PROF_RESET();
+}
+
+void tearDown(void) {
+}
+
+// 收集 dump 输出
+struct string_out {
+    std::string s;
+    auto print(const char* v) -> void { s += v; }
+    auto print(unsigned long v) -> void { s += std::to_string(v); }
+};
+
+void test_bucket_mapping(void) {
+    // 每个值都落在其桶的范围内，且桶序号单调
+    uint8_t prev = 0;
+    for (uint32_t v = 0; v < (1u << 21); v += 1 + v / 64) {
+        uint8_t idx = histogram::bucket_of(v);
+        TEST_ASSERT_TRUE(idx >= prev);
+        TEST_ASSERT_TRUE(v <= histogram::bucket_upper(idx));
+        if (idx > 0) TEST_ASSERT_TRUE(v > histogram::bucket_upper(idx - 1));
+        prev = idx;
+    }
+    TEST_ASSERT_EQUAL_UINT8(histogram::bucket_size - 1, histogram::bucket_of(UINT32_MAX));
+}
+
+void test_min_max_mean(void) {
+    histogram h;
+    for (uint32_t v = 100; v <= 200; v++) h.record(v);
+
+    TEST_ASSERT_EQUAL_UINT32(101, h.count());
+    TEST_ASSERT_EQUAL_UINT32(100, h.min());
+    TEST_ASSERT_EQUAL_UINT32(200, h.max());
+    TEST_ASSERT_EQUAL_UINT32(150, h.mean());
+}
+
+// p99 误差不超过一个桶宽 (25%)
+void test_percentile(void) {
+    histogram h;
+    for (int i = 0; i < 990; i++) h.record(1000);
+    for (int i = 0; i < 10; i++) h.record(50000);
+
+    uint32_t p99 = h.percentile(99);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1000, p99);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1250, p99);
+    TEST_ASSERT_EQUAL_UINT32(50000, h.percentile(100));
+}
+
+void test_scoped_probe(void) {
+    {
+        PROF_SCOPE(imu_update);
+        volatile uint32_t x = 0;
+        for (int i = 0; i < 10000; i++) x = x + i;
+    }
+    {
+        PROF_SCOPE(imu_update);
+    }
+
+    const histogram& h = instance().get(imu_update);
+    TEST_ASSERT_EQUAL_UINT32(2, h.count());
+    TEST_ASSERT_GREATER_THAN_UINT32(h.min(), h.max());
+    TEST_ASSERT_EQUAL_UINT32(0, instance().get(matrix_show).count());
+}
+
+void test_dump(void) {
+    profiler<2> p;
+    p.record(0, 10);
+    p.record(0, 10);
+    p.record(1, 3);
+
+    string_out out;
+    p.dump(out);
+
+    TEST_ASSERT_TRUE(out.s.find("imu.update 2 10 10 10 10\n  11:2\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.s.find("button.update 1 3 3 3 3\n  3:1\n") != std::string::npos);
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bucket_mapping);
+    RUN_TEST(test_min_max_mean);
+    RUN_TEST(test_percentile);
+    RUN_TEST(test_scoped_probe);
+    RUN_TEST(test_dump);
+
+    UNITY_END();
+}
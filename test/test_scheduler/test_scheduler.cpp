@@ -0,0 +1,170 @@
+// test/test_scheduler/test_scheduler.cpp
+#include "scheduler.hpp"
+#include <unity.h>
+
+#include <string.h>
+
+// 可注入的时钟，任务通过推进时间来模拟执行耗时
+struct fake_clock {
+    static uint32_t us;
+    static auto now() -> uint32_t { return us; }
+};
+uint32_t fake_clock::us = 0;
+
+static char     trace[64];
+static size_t   trace_len;
+static uint32_t slow_cost;
+
+static void balance() {
+    trace[trace_len++] = 'B';
+    fake_clock::us += 100;
+}
+static void line() {
+    trace[trace_len++] = 'L';
+    fake_clock::us += 300;
+}
+static void display() {
+    trace[trace_len++] = 'D';
+    fake_clock::us += slow_cost;
+}
+
+void setUp(void) {
+    fake_clock::us = 0;
+    trace_len      = 0;
+    slow_cost      = 200;
+    memset(trace, 0, sizeof(trace));
+}
+
+void tearDown(void) {
+}
+
+using test_scheduler = sched::scheduler<fake_clock, 3>;
+
+static auto make() -> test_scheduler {
+    // 故意打乱顺序，构造时按优先级排序
+    return test_scheduler({ {
+        { "display", display, 100000, 2 },
+        { "balance", balance, 5000, 0 },
+        { "line", line, 50000, 1 },
+    } });
+}
+
+// 按 1 ms 步进推进时钟，直到 end_us
+static void run_until(test_scheduler& s, uint32_t end_us) {
+    while (fake_clock::us < end_us) {
+        if (!s.dispatch()) fake_clock::us += 1000;
+    }
+}
+
+void test_priority_order(void) {
+    auto s = make();
+    s.start();
+
+    while (s.dispatch()) {}
+
+    TEST_ASSERT_EQUAL_STRING("BLD", trace);
+    TEST_ASSERT_EQUAL_STRING("balance", s.get_task(0).name);
+    TEST_ASSERT_EQUAL_STRING("display", s.get_task(2).name);
+}
+
+void test_periods(void) {
+    auto s = make();
+    s.start();
+    run_until(s, 1000000);
+
+    TEST_ASSERT_EQUAL_UINT32(200, s.get_stats(s.find(balance)).runs);
+    TEST_ASSERT_EQUAL_UINT32(20, s.get_stats(s.find(line)).runs);
+    TEST_ASSERT_EQUAL_UINT32(10, s.get_stats(s.find(display)).runs);
+    TEST_ASSERT_EQUAL_UINT32(0, s.get_stats(s.find(balance)).overruns);
+}
+
+// 低优先级任务再慢，也只会让高优先级任务延迟其本次执行时间
+void test_jitter_bounded_by_blocking(void) {
+    slow_cost = 3000;
+    auto s    = make();
+    s.start();
+    run_until(s, 1000000);
+
+    auto& b = s.get_stats(s.find(balance));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(3000 + 1000, b.max_jitter_us);
+    TEST_ASSERT_EQUAL_UINT32(0, b.overruns);
+    TEST_ASSERT_EQUAL_UINT32(200, b.runs);
+    TEST_ASSERT_EQUAL_UINT32(3000, s.get_stats(s.find(display)).wcet_us);
+}
+
+// 超时任务计入 overrun，并跳过错过的释放点
+void test_overrun_skips_releases(void) {
+    slow_cost = 250000;
+    auto s    = make();
+    s.start();
+    run_until(s, 1000000);
+
+    auto& d = s.get_stats(s.find(display));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, d.overruns);
+    TEST_ASSERT_EQUAL_UINT32(d.runs, d.overruns);
+    TEST_ASSERT_EQUAL_UINT32(250000, d.wcet_us);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(5, d.runs);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2 * d.runs, d.missed);
+}
+
+// 被低优先级任务阻塞而晚启动的任务只计入 missed，不算 overrun
+void test_late_start_not_overrun(void) {
+    slow_cost = 12000;
+    auto s    = make();
+    s.start();
+    run_until(s, 1000000);
+
+    auto& b = s.get_stats(s.find(balance));
+    TEST_ASSERT_EQUAL_UINT32(0, b.overruns);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, b.missed);
+    TEST_ASSERT_EQUAL_UINT32(0, s.get_stats(s.find(display)).overruns);
+}
+
+// micros() 32 位回绕后仍按周期运行
+void test_clock_wraparound(void) {
+    fake_clock::us = UINT32_MAX - 20000;
+    auto s         = make();
+    s.start();
+
+    for (int i = 0; i < 100; i++) {
+        if (!s.dispatch()) fake_clock::us += 1000;
+    }
+    uint32_t runs = s.get_stats(s.find(balance)).runs;
+
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(15, runs);
+    TEST_ASSERT_EQUAL_UINT32(0, s.get_stats(s.find(balance)).overruns);
+}
+
+void test_idle_time(void) {
+    auto s = make();
+    s.start();
+    TEST_ASSERT_EQUAL_UINT32(0, s.idle_time());
+
+    while (s.dispatch()) {}
+    TEST_ASSERT_EQUAL_UINT32(5000 - 600, s.idle_time());
+}
+
+void test_reset_stats(void) {
+    auto s = make();
+    s.start();
+    run_until(s, 100000);
+    s.reset_stats();
+
+    TEST_ASSERT_EQUAL_UINT32(0, s.get_stats(0).runs);
+    TEST_ASSERT_EQUAL_UINT32(0, s.get_stats(0).wcet_us);
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_priority_order);
+    RUN_TEST(test_periods);
+    RUN_TEST(test_jitter_bounded_by_blocking);
+    RUN_TEST(test_overrun_skips_releases);
+    RUN_TEST(test_late_start_not_overrun);
+    RUN_TEST(test_clock_wraparound);
+    RUN_TEST(test_idle_time);
+    RUN_TEST(test_reset_stats);
+
+    UNITY_END();
+}
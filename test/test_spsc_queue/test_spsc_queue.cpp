@@ -0,0 +1,224 @@
+// test/test_spsc_queue/test_spsc_queue.cpp
+#include "spsc_queue.hpp"
+#include <unity.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace spsc;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_fifo_order(void) {
+    queue<int, 4> q;
+    int v = 0;
+    TEST_ASSERT_TRUE(q.empty());
+    TEST_ASSERT_FALSE(q.pop(v));
+
+    // 多次绕回，满时拒绝写入且不覆盖
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(q.push(round * 10 + i));
+        TEST_ASSERT_FALSE(q.push(99));
+        TEST_ASSERT_NULL(q.reserve());
+        TEST_ASSERT_EQUAL(4, q.size());
+        for (int i = 0; i < 4; i++) {
+            TEST_ASSERT_TRUE(q.pop(v));
+            TEST_ASSERT_EQUAL(round * 10 + i, v);
+        }
+        TEST_ASSERT_FALSE(q.pop(v));
+    }
+}
+
+void test_reserve_commit(void) {
+    queue<int, 2> q;
+    int* slot = q.reserve();
+    TEST_ASSERT_NOT_NULL(slot);
+    *slot = 7;
+    // 提交前消费者看不到
+    TEST_ASSERT_NULL(q.front());
+    q.commit();
+    TEST_ASSERT_NOT_NULL(q.front());
+    TEST_ASSERT_EQUAL(7, *q.front());
+    q.pop();
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+// 元素的对齐高于缓存行时槽位按元素对齐
+void test_slot_alignment(void) {
+    struct alignas(128) wide {
+        double v;
+    };
+    static queue<wide, 4> q;
+    for (int i = 0; i < 4; i++) {
+        wide* slot = q.reserve();
+        TEST_ASSERT_NOT_NULL(slot);
+        TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(slot) % alignof(wide));
+        slot->v = i * 0.5;
+        q.commit();
+    }
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, q.front()->v);
+}
+
+void test_front_span(void) {
+    queue<int, 8> q;
+    for (int i = 0; i < 6; i++) q.push(i);
+    int v;
+    for (int i = 0; i < 5; i++) q.pop(v);
+    for (int i = 6; i < 12; i++) q.push(i); // 5..11，跨越缓冲区末尾
+
+    // 原地读取只到缓冲区末尾为止
+    span<int> s = q.front_span();
+    TEST_ASSERT_EQUAL(3, s.size);
+    TEST_ASSERT_EQUAL(5, s[0]);
+    TEST_ASSERT_EQUAL(7, s[2]);
+    q.pop(s.size);
+
+    s = q.front_span(2);
+    TEST_ASSERT_EQUAL(2, s.size);
+    TEST_ASSERT_EQUAL(8, s[0]);
+    q.pop(s.size);
+
+    int sum = 0;
+    for (int x : q.front_span()) sum += x;
+    TEST_ASSERT_EQUAL(10 + 11, sum);
+}
+
+void test_pop_span(void) {
+    queue<int, 8> q;
+    int out[8];
+    TEST_ASSERT_EQUAL(0, q.pop_span(out, 8));
+
+    for (int i = 0; i < 6; i++) q.push(i);
+    TEST_ASSERT_EQUAL(4, q.pop_span(out, 4));
+    for (int i = 6; i < 12; i++) q.push(i);
+
+    // 跨越末尾时一次取出两段
+    TEST_ASSERT_EQUAL(8, q.pop_span(out, 8));
+    for (int i = 0; i < 8; i++) TEST_ASSERT_EQUAL(4 + i, out[i]);
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+/*
+ * 两个线程各占一端，生产者写入递增序列，消费者检查顺序与完整性
+ * 每个元素的所有字都由序号导出，读到写了一半的槽时校验失败
+ */
+struct payload {
+    uint32_t seq;
+    uint32_t words[6];
+    uint32_t check;
+
+    auto fill(uint32_t s) -> void {
+        seq   = s;
+        check = s;
+        for (uint32_t i = 0; i < 6; i++) {
+            words[i] = s * 2654435761u + i;
+            check ^= words[i];
+        }
+    }
+
+    auto valid() const -> bool {
+        uint32_t c = seq;
+        for (uint32_t i = 0; i < 6; i++) {
+            if (words[i] != seq * 2654435761u + i) return false;
+            c ^= words[i];
+        }
+        return c == check;
+    }
+};
+
+static constexpr uint32_t stress_count = 1000000;
+
+// 一端等待另一端时先让出，仍等不到再睡眠，单核主机上 yield() 不一定切换到对方线程
+static auto backoff(uint32_t& misses) -> void {
+    if (++misses < 64) std::this_thread::yield();
+    else std::this_thread::sleep_for(std::chrono::microseconds(1));
+}
+
+template <typename Consume>
+static auto stress(Consume consume) -> uint32_t {
+    static queue<payload, 64> q;
+    std::thread producer([] {
+        uint32_t misses = 0;
+        for (uint32_t i = 0; i < stress_count;) {
+            payload* p = q.reserve();
+            if (!p) {
+                backoff(misses);
+                continue;
+            }
+            misses = 0;
+            p->fill(i++);
+            q.commit();
+        }
+    });
+
+    uint32_t errors = consume(q);
+    producer.join();
+    TEST_ASSERT_TRUE(q.empty());
+    return errors;
+}
+
+void test_stress_pop(void) {
+    uint32_t errors = stress([](queue<payload, 64>& q) {
+        uint32_t expect = 0, errors = 0, misses = 0;
+        payload p;
+        while (expect < stress_count) {
+            if (!q.pop(p)) {
+                backoff(misses);
+                continue;
+            }
+            misses = 0;
+            if (p.seq != expect++ || !p.valid()) errors++;
+        }
+        return errors;
+    });
+    TEST_ASSERT_EQUAL_UINT32(0, errors);
+}
+
+void test_stress_pop_span(void) {
+    uint32_t errors = stress([](queue<payload, 64>& q) {
+        uint32_t expect = 0, errors = 0, misses = 0;
+        payload batch[24];
+        while (expect < stress_count) {
+            size_t n = q.pop_span(batch, 24);
+            if (n == 0) backoff(misses);
+            else misses = 0;
+            for (size_t i = 0; i < n; i++)
+                if (batch[i].seq != expect++ || !batch[i].valid()) errors++;
+        }
+        return errors;
+    });
+    TEST_ASSERT_EQUAL_UINT32(0, errors);
+}
+
+void test_stress_front_span(void) {
+    uint32_t errors = stress([](queue<payload, 64>& q) {
+        uint32_t expect = 0, errors = 0, misses = 0;
+        while (expect < stress_count) {
+            span<payload> s = q.front_span();
+            if (s.empty()) backoff(misses);
+            else misses = 0;
+            for (const payload& p : s)
+                if (p.seq != expect++ || !p.valid()) errors++;
+            q.pop(s.size);
+        }
+        return errors;
+    });
+    TEST_ASSERT_EQUAL_UINT32(0, errors);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fifo_order);
+    RUN_TEST(test_reserve_commit);
+    RUN_TEST(test_slot_alignment);
+    RUN_TEST(test_front_span);
+    RUN_TEST(test_pop_span);
+    RUN_TEST(test_stress_pop);
+    RUN_TEST(test_stress_pop_span);
+    RUN_TEST(test_stress_front_span);
+    return UNITY_END();
+}
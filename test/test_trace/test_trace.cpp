@@ -0,0 +1,243 @@
+// test/test_trace/test_trace.cpp
+#include "app.hpp"
+#include "hal_host.hpp"
+#include "imu_filter.hpp"
+#include "scheduler.hpp"
+#include "trace.hpp"
+#include <math.h>
+#include <unity.h>
+
+#include <string>
+#include <vector>
+
+using namespace trace;
+
+void setUp(void) {
+    hal::host_clock::set(0);
+}
+
+void tearDown(void) {
+}
+
+static auto bytes(const std::string& s) -> std::vector<uint8_t> {
+    return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+void test_round_trip(void) {
+    writer<hal::host_serial> w;
+    w.sample_imu(0, 1.0f, 0, 0); // 未开始录制时不输出
+    TEST_ASSERT_EQUAL(0, w.sink().output().size());
+
+    w.begin(1000);
+    w.sample_imu(6000, 0.25f, -1.5f, 1.0f);
+    w.sample_buttons(6000, 0b010);
+    w.sample_buttons(7000, 0b010); // 未变化
+    w.sample_knob(8000, -42, true);
+    w.sample_knob(9000, -42, true); // 未变化
+    w.sample_reset(200000, 0.0f, 0.5f, 1.0f); // 间隔超过 65535 us，先插入 stamp
+    w.sample_imu(205000, 5.0f, 0.0001f, -5.0f);
+    const float v[state_values] = { 0.1f, -0.2f, 1e-7f, -3e5f, 0.5f, 0.25f, -0.125f, 1.0f, 0.0f, -0.0f };
+    w.sample_state(205000, v);
+    w.end();
+    w.sample_imu(210000, 0, 0, 0);
+
+    auto data = bytes(w.sink().output());
+    reader rd(data.data(), data.size());
+    record r;
+
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(start, r.type);
+    TEST_ASSERT_EQUAL_UINT8(version, r.version);
+    TEST_ASSERT_EQUAL_UINT32(0, r.t_us);
+
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(imu, r.type);
+    TEST_ASSERT_EQUAL_UINT32(5000, r.t_us);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, r.acc.x);
+    TEST_ASSERT_EQUAL_FLOAT(-1.5f, r.acc.y);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, r.acc.z);
+
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(buttons, r.type);
+    TEST_ASSERT_EQUAL_HEX8(0b010, r.buttons);
+
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(knob, r.type);
+    TEST_ASSERT_EQUAL_UINT32(7000, r.t_us);
+    TEST_ASSERT_EQUAL_INT16(-42, r.knob.value);
+    TEST_ASSERT_TRUE(r.knob.pressed);
+
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(stamp, r.type);
+    TEST_ASSERT_EQUAL_UINT32(199000, r.t_us);
+
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(reset, r.type);
+    TEST_ASSERT_EQUAL_UINT32(199000, r.t_us);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, r.acc.y);
+
+    // 超出 ±4 g 饱和，量化步长 1/8192 g
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL_UINT32(204000, r.t_us);
+    TEST_ASSERT_FLOAT_WITHIN(acc_lsb, 4.0f, r.acc.x);
+    TEST_ASSERT_FLOAT_WITHIN(acc_lsb / 2, 0.0001f, r.acc.y);
+    TEST_ASSERT_EQUAL_FLOAT(-4.0f, r.acc.z);
+
+    // 状态按 float 原样保存
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(state, r.type);
+    TEST_ASSERT_EQUAL_UINT32(204000, r.t_us);
+    TEST_ASSERT_EQUAL_MEMORY(v, r.state, sizeof(v));
+
+    TEST_ASSERT_FALSE(rd.next(r));
+    TEST_ASSERT_EQUAL_UINT32(0, rd.skipped());
+}
+
+void test_resync(void) {
+    writer<hal::host_serial> w;
+    w.begin(0);
+    w.sample_imu(5000, 0.5f, 0, 1.0f);
+    std::string first = w.sink().output();
+    w.sink().clear_output();
+    w.sample_imu(10000, 0.75f, 0, 1.0f);
+    w.sample_imu(15000, 1.0f, 0, 1.0f);
+    std::string rest = w.sink().output();
+
+    // 日志文本混在记录之间，第二条记录有一个字节损坏
+    std::string text = "[INFO ] [main.cpp:1] Press B\r\n";
+    std::string bad  = rest;
+    bad[5] ^= 0x10;
+    auto data = bytes(text + first + text + bad + "\xA5");
+
+    reader rd(data.data(), data.size());
+    record r;
+    std::vector<float> xs;
+    while (rd.next(r))
+        if (r.type == imu) xs.push_back(r.acc.x);
+
+    TEST_ASSERT_EQUAL(2, xs.size());
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, xs[0]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, xs[1]);
+    TEST_ASSERT_EQUAL_UINT32(2 * text.size() + rest.size() / 2 + 1, rd.skipped());
+}
+
+// ===================== 录制与回放 =====================
+
+using host_app = app::application<hal::host>;
+
+static host_app* g_app = nullptr;
+
+template <typename S>
+static auto run_for(S& s, uint32_t ms) -> void {
+    for (uint32_t i = 0; i < ms; i++) {
+        while (s.dispatch()) {
+        }
+        hal::host_clock::advance(1000);
+    }
+}
+
+// 取值不在 1/8192 g 的网格上，固件按录制的精度滤波，回放仍应与实时运行完全一致
+static void wobble(uint32_t t_us, float* xyz, void*) {
+    float t = t_us * 1e-6f;
+    xyz[0]  = 0.3f * sinf(t * 7.1f) + 0.01234f;
+    xyz[1]  = (t >= 0.6f && t < 0.9f ? 0.7531f : 0.0617f) + 0.02f * sinf(t * 31.0f);
+    xyz[2]  = 1.0f;
+}
+
+// 三个任务与固件相同的调度
+static auto make_scheduler() -> sched::scheduler<hal::host_clock, 3> {
+    return sched::scheduler<hal::host_clock, 3>({ {
+        { "imu", [] { g_app->imu_task(); }, app::imu_period_us, 0 },
+        { "input", [] { g_app->input_task(); }, app::input_period_us, 1 },
+        { "display", [] { g_app->display_task(); }, app::display_period_us, 2 },
+    } });
+}
+
+void test_record_replay(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'B', true },
+        { 200, 'B', false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+    a.imu().source(wobble);
+
+    a.trace_begin();
+    s.start();
+    run_for(s, 3000);
+    a.trace_end();
+
+    auto data = bytes(a.recorder().sink().output());
+    TEST_ASSERT_GREATER_THAN(0, data.size());
+
+    // 与固件相同的滤波代码
+    reader rd(data.data(), data.size());
+    app::imu_replay rp(app::default_imu_params, app::imu_dt);
+    replay(rd, rp);
+
+    TEST_ASSERT_EQUAL_UINT32(0, rd.skipped());
+    TEST_ASSERT_GREATER_THAN(500, rp.steps);
+    TEST_ASSERT_TRUE(a.kinematics().pos_x == rp.state.pos_x);
+    TEST_ASSERT_TRUE(a.kinematics().pos_y == rp.state.pos_y);
+    TEST_ASSERT_TRUE(a.kinematics().vel_y == rp.state.vel_y);
+
+    // 另一组参数得到不同的轨迹
+    app::imu_params p = app::default_imu_params;
+    p.offset          = dsp::one_pole::lowpass(literals::frq_t(0.16), app::imu_rate);
+    rd.rewind();
+    app::imu_replay other(p, app::imu_dt);
+    replay(rd, other);
+    TEST_ASSERT_EQUAL_UINT32(rp.steps, other.steps);
+    TEST_ASSERT_TRUE(other.state.pos_y != rp.state.pos_y);
+}
+
+// SHOW_IMU 中途开始录制：没有 reset 记录，回放从录制开始时的滤波器状态继续
+void test_record_mid_mode(void) {
+    static const hal::host_buttons::event buttons[] = {
+        { 100, 'B', true },
+        { 200, 'B', false },
+    };
+
+    host_app a;
+    g_app  = &a;
+    auto s = make_scheduler();
+    a.buttons().play(buttons);
+    a.imu().source(wobble);
+
+    s.start();
+    run_for(s, 1000);
+    TEST_ASSERT_TRUE(a.kinematics().pos_y != 0.0f);
+
+    a.trace_begin();
+    run_for(s, 2000);
+    a.trace_end();
+
+    auto data = bytes(a.recorder().sink().output());
+    reader rd(data.data(), data.size());
+    record r;
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(start, r.type);
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL(state, r.type);
+
+    rd.rewind();
+    app::imu_replay rp(app::default_imu_params, app::imu_dt);
+    replay(rd, rp);
+    TEST_ASSERT_EQUAL_UINT32(0, rd.skipped());
+    TEST_ASSERT_GREATER_THAN(300, rp.steps);
+    TEST_ASSERT_TRUE(a.kinematics().pos_x == rp.state.pos_x);
+    TEST_ASSERT_TRUE(a.kinematics().pos_y == rp.state.pos_y);
+    TEST_ASSERT_TRUE(a.kinematics().vel_y == rp.state.vel_y);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_resync);
+    RUN_TEST(test_record_replay);
+    RUN_TEST(test_record_mid_mode);
+    return UNITY_END();
+}
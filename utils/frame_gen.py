@@ -1,306 +1,210 @@
 #!/usr/bin/env python3
-# hex_6x8_generator.py
-# 生成 6x8 点阵的 16 进制数字
+# frame_gen.py
+# 12x8 点阵帧打包器，字体已改为在 include/led_font.hpp 中编译期生成
 
-def create_6x8_digits():
-    """
-    定义所有 16 进制数字的 6x8 点阵
-    每行用6位二进制表示
-    """
-    digits = {
-        0x0: [  # 0
-            0b011110,
-            0b100001,
-            0b100011,
-            0b100101,
-            0b101001,
-            0b110001,
-            0b100001,
-            0b011110
-        ],
-        0x1: [  # 1
-            0b001000,
-            0b011000,
-            0b001000,
-            0b001000,
-            0b001000,
-            0b001000,
-            0b001000,
-            0b011100
-        ],
-        0x2: [  # 2
-            0b011110,
-            0b100001,
-            0b000001,
-            0b000010,
-            0b000100,
-            0b001000,
-            0b010000,
-            0b111111
-        ],
-        0x3: [  # 3
-            0b011110,
-            0b100001,
-            0b000001,
-            0b000110,
-            0b000001,
-            0b000001,
-            0b100001,
-            0b011110
-        ],
-        0x4: [  # 4
-            0b000010,
-            0b000110,
-            0b001010,
-            0b010010,
-            0b100010,
-            0b111111,
-            0b000010,
-            0b000010
-        ],
-        0x5: [  # 5
-            0b111111,
-            0b100000,
-            0b100000,
-            0b111110,
-            0b000001,
-            0b000001,
-            0b100001,
-            0b011110
-        ],
-        0x6: [  # 6
-            0b001110,
-            0b010000,
-            0b100000,
-            0b111110,
-            0b100001,
-            0b100001,
-            0b100001,
-            0b011110
-        ],
-        0x7: [  # 7
-            0b111111,
-            0b000001,
-            0b000010,
-            0b000100,
-            0b001000,
-            0b010000,
-            0b010000,
-            0b010000
-        ],
-        0x8: [  # 8
-            0b011110,
-            0b100001,
-            0b100001,
-            0b011110,
-            0b100001,
-            0b100001,
-            0b100001,
-            0b011110
-        ],
-        0x9: [  # 9
-            0b011110,
-            0b100001,
-            0b100001,
-            0b100001,
-            0b011111,
-            0b000001,
-            0b000010,
-            0b011100
-        ],
-        0xA: [  # A
-            0b001100,
-            0b010010,
-            0b100001,
-            0b100001,
-            0b111111,
-            0b100001,
-            0b100001,
-            0b100001
-        ],
-        0xB: [  # B
-            0b111110,
-            0b100001,
-            0b100001,
-            0b111110,
-            0b100001,
-            0b100001,
-            0b100001,
-            0b111110
-        ],
-        0xC: [  # C
-            0b011110,
-            0b100001,
-            0b100000,
-            0b100000,
-            0b100000,
-            0b100000,
-            0b100001,
-            0b011110
-        ],
-        0xD: [  # D
-            0b111100,
-            0b100010,
-            0b100001,
-            0b100001,
-            0b100001,
-            0b100001,
-            0b100010,
-            0b111100
-        ],
-        0xE: [  # E
-            0b111111,
-            0b100000,
-            0b100000,
-            0b111110,
-            0b100000,
-            0b100000,
-            0b100000,
-            0b111111
-        ],
-        0xF: [  # F
-            0b111111,
-            0b100000,
-            0b100000,
-            0b111110,
-            0b100000,
-            0b100000,
-            0b100000,
-            0b100000
-        ]
-    }
-    return digits
+# ===================== 帧打包器 =====================
+# 格式与 include/led_pack.hpp 一致：
+#   blob  := count:u8 frame{count}
+#   frame := duration:u8 (10 ms) token... 覆盖 12 字节
+#   每帧与上一帧异或，token 为 00n 跳过 / 01n 重复字节 / 10n 字面字节
 
-def print_digit_preview(digit_data, label):
-    """
-    打印数字预览
-    """
-    print(f"\n{label}:")
-    for row in digit_data:
-        binary_str = f"{row:06b}"
-        visual = binary_str.replace('0', '·').replace('1', '█')
-        print(f"  {visual}  (0b{binary_str})")
+MATRIX_W = 12
+MATRIX_H = 8
+FRAME_BYTES = MATRIX_W * MATRIX_H // 8
+TICK_MS = 10
 
-def generate_arduino_array():
-    """
-    生成 Arduino 使用的 C++ 数组
-    """
-    digits = create_6x8_digits()
-    
-    code = "// 6x8 点阵字体 - 16进制数字 0-F\n"
-    code += "// 每个数字占 6 列宽，8 行高\n\n"
-    code += "const uint8_t font_6x8[16][8] = {\n"
-    
-    for i in range(16):
-        code += f"  // 0x{i:X}\n"
-        code += "  {"
-        rows = []
-        for row in digits[i]:
-            rows.append(f"0b{row:06b}")
-        code += ", ".join(rows)
-        code += "}"
-        if i < 15:
-            code += ","
-        code += "\n"
-    
-    code += "};\n"
-    return code
+ON_CHARS = "#█1Xx*"
+OFF_CHARS = ".·0 _-"
 
-def generate_hex_lookup():
+
+def parse_frames(text):
     """
-    生成十六进制值的查找代码
+    解析文本帧：每帧以 "@ 时长ms" 开头，后跟 8 行、每行 12 个字符
+    返回 [(rows, duration_ms)]，rows 为 8 个 12 位整数（最高位为左列）
     """
-    code = "\n// 使用示例：显示单个16进制数字\n"
-    code += "void displayHexDigit(uint8_t digit, int startCol) {\n"
-    code += "  // digit: 0-15 (0x0-0xF)\n"
-    code += "  // startCol: 起始列位置 (0-11)\n"
-    code += "  uint8_t frame[8][12] = {0};\n"
-    code += "  \n"
-    code += "  for(int row = 0; row < 8; row++) {\n"
-    code += "    uint8_t pattern = font_6x8[digit][row];\n"
-    code += "    for(int col = 0; col < 6; col++) {\n"
-    code += "      if(startCol + col < 12) {\n"
-    code += "        frame[row][startCol + col] = (pattern >> (5 - col)) & 0x01;\n"
-    code += "      }\n"
-    code += "    }\n"
-    code += "  }\n"
-    code += "  \n"
-    code += "  // 转换并显示\n"
-    code += "  uint32_t frameData[3];\n"
-    code += "  bitmapToFrame(frame, frameData);\n"
-    code += "  matrix.loadFrame(frameData);\n"
-    code += "}\n"
+    frames = []
+    duration = None
+    rows = []
+    for lineno, line in enumerate(text.splitlines(), 1):
+        line = line.rstrip("\n")
+        if not line.strip() and duration is None:
+            continue
+        if line.startswith(";"):
+            continue
+        if line.startswith("@"):
+            if duration is not None:
+                raise ValueError(f"line {lineno}: frame has {len(rows)} rows, expected {MATRIX_H}")
+            duration = int(line[1:].strip().removesuffix("ms"))
+            rows = []
+            continue
+        if duration is None:
+            raise ValueError(f"line {lineno}: pixels before '@ duration'")
+        pixels = line[:MATRIX_W].ljust(MATRIX_W, ".")
+        row = 0
+        for ch in pixels:
+            if ch in ON_CHARS:
+                row = (row << 1) | 1
+            elif ch in OFF_CHARS:
+                row <<= 1
+            else:
+                raise ValueError(f"line {lineno}: unknown pixel '{ch}'")
+        rows.append(row)
+        if len(rows) == MATRIX_H:
+            frames.append((rows, duration))
+            duration = None
+    if duration is not None:
+        raise ValueError("last frame is incomplete")
+    return frames
+
+
+def rows_to_bytes(rows):
+    """8 行 12 位 -> 96 位按像素顺序的 12 字节"""
+    bits = 0
+    for row in rows:
+        bits = (bits << MATRIX_W) | row
+    return list(bits.to_bytes(FRAME_BYTES, "big"))
+
+
+def bytes_to_words(data):
+    """12 字节 -> LED_Matrix 使用的三个 uint32_t"""
+    return [int.from_bytes(bytes(data[i:i + 4]), "big") for i in range(0, FRAME_BYTES, 4)]
+
+
+def pack_frame(prev, cur, duration_ms):
+    """与 led::pack_frame 相同的贪心编码"""
+    d = [a ^ b for a, b in zip(prev, cur)]
+
+    def run_at(k):
+        r = 1
+        while k + r < FRAME_BYTES and d[k + r] == d[k]:
+            r += 1
+        return r
+
+    out = [min(duration_ms // TICK_MS, 255)]
+    k = 0
+    while k < FRAME_BYTES:
+        r = run_at(k)
+        if d[k] == 0:
+            out.append(0x00 | (r - 1))
+            k += r
+        elif r >= 3:
+            out += [0x40 | (r - 1), d[k]]
+            k += r
+        else:
+            j = k
+            while j < FRAME_BYTES and d[j] != 0 and (j == k or run_at(j) < 3):
+                j += 1
+            out.append(0x80 | (j - k - 1))
+            out += d[k:j]
+            k = j
+    return out
+
+
+def pack(frames):
+    if len(frames) > 255:
+        raise ValueError("at most 255 frames per blob")
+    blob = [len(frames)]
+    prev = [0] * FRAME_BYTES
+    for rows, duration in frames:
+        cur = rows_to_bytes(rows)
+        blob += pack_frame(prev, cur, duration)
+        prev = cur
+    return blob
+
+
+def unpack(blob):
+    """解码为 [(12 字节, duration_ms)]，用于校验"""
+    frames = []
+    cur = [0] * FRAME_BYTES
+    p = 1
+    for _ in range(blob[0]):
+        duration = blob[p] * TICK_MS
+        p += 1
+        k = 0
+        while k < FRAME_BYTES:
+            t = blob[p]
+            p += 1
+            n = (t & 0x3F) + 1
+            if k + n > FRAME_BYTES:
+                raise ValueError(f"token at {p - 1} overruns the frame")
+            kind = t & 0xC0
+            if kind == 0x00:
+                k += n
+            elif kind == 0x40:
+                for i in range(n):
+                    cur[k + i] ^= blob[p]
+                p += 1
+                k += n
+            elif kind == 0x80:
+                for i in range(n):
+                    cur[k + i] ^= blob[p + i]
+                p += n
+                k += n
+            else:
+                raise ValueError(f"bad token 0x{t:02X}")
+        frames.append((list(cur), duration))
+    if p != len(blob):
+        raise ValueError("trailing bytes after the last frame")
+    return frames
+
+
+def check_round_trip(frames, blob):
+    decoded = unpack(blob)
+    for i, ((rows, duration), (data, dur)) in enumerate(zip(frames, decoded)):
+        if rows_to_bytes(rows) != data:
+            raise ValueError(f"frame {i} does not round-trip")
+        if min(duration // TICK_MS, 255) * TICK_MS != dur:
+            raise ValueError(f"frame {i} duration does not round-trip")
+
+
+def generate_blob_header(name, frames, blob, source):
+    code = f"// generated by utils/frame_gen.py pack {source}, do not edit\n"
+    code += f"// {len(frames)} frames, {len(blob)} bytes packed, {len(frames) * FRAME_BYTES} bytes unpacked\n"
+    code += "#pragma once\n\n#include <stdint.h>\n\nnamespace led::assets {\n\n"
+    code += f"inline constexpr uint8_t {name}[{len(blob)}] = {{\n"
+    for i in range(0, len(blob), 12):
+        code += "    " + ", ".join(f"0x{b:02X}" for b in blob[i:i + 12]) + ",\n"
+    code += "};\n\n} // namespace led::assets\n"
     return code
 
-def main():
-    print("=" * 60)
-    print("6x8 点阵字体生成器 - 16进制数字 0-F")
-    print("=" * 60)
-    
-    digits = create_6x8_digits()
-    
-    # 打印所有数字的预览
-    print("\n【字体预览】\n")
-    for i in range(16):
-        print_digit_preview(digits[i], f"0x{i:X}")
-    
-    # 生成 Arduino 代码
-    arduino_code = generate_arduino_array()
-    arduino_code += generate_hex_lookup()
-    
-    print("\n" + "=" * 60)
-    print("【Arduino 代码】")
-    print("=" * 60)
-    print(arduino_code)
-    
-    # 保存到文件
-    with open("font_6x8.h", "w", encoding="utf-8") as f:
-        f.write(arduino_code)
-    
-    print("\n✓ 代码已保存到 font_6x8.h")
-    
-    # 生成完整示例
-    generate_complete_example()
 
-def generate_complete_example():
-    """
-    生成完整的Arduino示例程序
-    """
-    example = """
-// 完整示例：显示两个16进制数字
-void displayTwoHexDigits(uint8_t value) {
-  uint8_t highNibble = (value >> 4) & 0x0F;  // 高4位
-  uint8_t lowNibble = value & 0x0F;           // 低4位
-  
-  uint8_t frame[8][12] = {0};
-  
-  // 第一个数字 (列 0-5)
-  for(int row = 0; row < 8; row++) {
-    uint8_t pattern = font_6x8[highNibble][row];
-    for(int col = 0; col < 6; col++) {
-      frame[row][col] = (pattern >> (5 - col)) & 0x01;
-    }
-  }
-  
-  // 第二个数字 (列 6-11)
-  for(int row = 0; row < 8; row++) {
-    uint8_t pattern = font_6x8[lowNibble][row];
-    for(int col = 0; col < 6; col++) {
-      frame[row][col + 6] = (pattern >> (5 - col)) & 0x01;
-    }
-  }
-  
-  // 转换并显示
-  uint32_t frameData[3];
-  bitmapToFrame(frame, frameData);
-  matrix.loadFrame(frameData);
-}
-"""
-    
-    with open("example_usage.txt", "w", encoding="utf-8") as f:
-        f.write(example)
-    
-    print("✓ 使用示例已保存到 example_usage.txt")
+def pack_main(argv):
+    import argparse
+
+    parser = argparse.ArgumentParser(prog="frame_gen.py pack", description="打包 12x8 文本帧为 led_pack 格式")
+    parser.add_argument("inputs", nargs="+", help="文本帧文件，每个文件生成一个数组，数组名取文件名")
+    parser.add_argument("-o", "--output", required=True, help="输出头文件")
+    args = parser.parse_args(argv)
+
+    import os
+
+    code = None
+    for path in args.inputs:
+        with open(path, encoding="utf-8") as f:
+            frames = parse_frames(f.read())
+        blob = pack(frames)
+        check_round_trip(frames, blob)
+
+        name = os.path.splitext(os.path.basename(path))[0]
+        part = generate_blob_header(name, frames, blob, os.path.basename(path))
+        if code is None:
+            code = part
+        else:
+            # 多个输入合并到同一个命名空间
+            body = part.split("namespace led::assets {\n\n", 1)[1]
+            code = code.rsplit("} // namespace led::assets\n", 1)[0] + body
+        print(f"{name}: {len(frames)} frames -> {len(blob)} bytes")
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(code)
+    print(f"✓ 已保存到 {args.output}")
+
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    import sys
+
+    if len(sys.argv) > 1 and sys.argv[1] == "pack":
+        pack_main(sys.argv[2:])
+    else:
+        print("usage: frame_gen.py pack <frames.txt>... -o <header>")
+        sys.exit(1)
\ No newline at end of file
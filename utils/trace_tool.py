@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# trace_tool.py
+# 传感器录制数据的采集与解码，格式与 include/trace.hpp 一致：
+#   record := sync:u8 type:u8 dt:u16 payload sum:u8，小端
+#   sync 0xA5，sum 为 type、dt 与 payload 的 8 位和
+#
+#   capture  通过串口发送 't' 开始录制，Ctrl-C 停止，原始字节写入文件
+#   csv      把录制文件解码为 CSV，可直接画图或导入其它工具
+
+import struct
+import sys
+
+SYNC = 0xA5
+ACC_LSB = 1.0 / 8192
+HEADER = 4
+
+# 类型 -> (名称, 负载格式)
+TYPES = {
+    ord("s"): ("start", "<B"),
+    ord("t"): ("stamp", "<I"),
+    ord("i"): ("imu", "<hhh"),
+    ord("r"): ("reset", "<hhh"),
+    ord("m"): ("state", "<10f"),
+    ord("b"): ("buttons", "<B"),
+    ord("k"): ("knob", "<hB"),
+}
+
+
+def decode(data):
+    """
+    逐条解码，无法组成合法记录的字节（日志文本、丢失的字节）逐个跳过
+    返回 ([(t_us, name, values)], skipped)
+    """
+    records = []
+    skipped = 0
+    now = 0
+    pos = 0
+    while pos + HEADER < len(data):
+        kind = TYPES.get(data[pos + 1])
+        size = struct.calcsize(kind[1]) if kind else 0
+        end = pos + HEADER + size
+        if data[pos] != SYNC or not kind or end >= len(data) or sum(data[pos + 1:end]) & 0xFF != data[end]:
+            pos += 1
+            skipped += 1
+            continue
+
+        name, fmt = kind
+        dt = struct.unpack_from("<H", data, pos + 2)[0]
+        values = struct.unpack_from(fmt, data, pos + HEADER)
+        pos = end + 1
+
+        if name == "start":
+            now = 0
+        elif name == "stamp":
+            now = values[0]
+        else:
+            now += dt
+        if name in ("imu", "reset"):
+            values = tuple(v * ACC_LSB for v in values)
+        records.append((now, name, values))
+    return records, skipped + len(data) - pos
+
+
+def csv_main(argv):
+    import argparse
+
+    parser = argparse.ArgumentParser(prog="trace_tool.py csv", description="解码录制文件为 CSV")
+    parser.add_argument("input", help="capture 生成的二进制文件")
+    parser.add_argument("-o", "--output", help="输出文件，默认标准输出")
+    args = parser.parse_args(argv)
+
+    with open(args.input, "rb") as f:
+        records, skipped = decode(f.read())
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    width = max((len(values) for _, _, values in records), default=3)
+    out.write(",".join(["t_us", "type"] + [f"v{i}" for i in range(width)]) + "\n")
+    for t, name, values in records:
+        cols = [f"{v:.6f}" if isinstance(v, float) else str(v) for v in values]
+        out.write(",".join([str(t), name] + cols + [""] * (width - len(cols))) + "\n")
+    if out is not sys.stdout:
+        out.close()
+    print(f"{len(records)} records, {skipped} bytes skipped", file=sys.stderr)
+
+
+def capture_main(argv):
+    import argparse
+
+    import serial  # pyserial
+
+    parser = argparse.ArgumentParser(prog="trace_tool.py capture", description="通过串口录制传感器数据")
+    parser.add_argument("port", help="串口，例如 /dev/ttyACM0 或 COM3")
+    parser.add_argument("output", help="输出的二进制文件")
+    parser.add_argument("-b", "--baud", type=int, default=115200)
+    args = parser.parse_args(argv)
+
+    total = 0
+    with serial.Serial(args.port, args.baud, timeout=0.1) as port, open(args.output, "wb") as f:
+        port.reset_input_buffer()
+        port.write(b"t")
+        print("recording, Ctrl-C to stop", file=sys.stderr)
+        try:
+            while True:
+                chunk = port.read(4096)
+                if chunk:
+                    f.write(chunk)
+                    total += len(chunk)
+        except KeyboardInterrupt:
+            port.write(b"t")
+            f.write(port.read(4096))
+
+    with open(args.output, "rb") as f:
+        records, skipped = decode(f.read())
+    print(f"{total} bytes, {len(records)} records, {skipped} bytes skipped", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    commands = {"capture": capture_main, "csv": csv_main}
+    if len(sys.argv) < 2 or sys.argv[1] not in commands:
+        print(f"usage: {sys.argv[0]} {{{','.join(commands)}}} ...", file=sys.stderr)
+        sys.exit(2)
+    commands[sys.argv[1]](sys.argv[2:])